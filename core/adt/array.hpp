@@ -17,6 +17,10 @@ namespace fc::adt {
   struct Array {
     using Key = uint64_t;
     using Visitor = std::function<outcome::result<void>(Key, const Value &)>;
+    using DiffVisitor =
+        std::function<outcome::result<void>(Key,
+                                            const boost::optional<Value> &,
+                                            const boost::optional<Value> &)>;
 
     static inline storage::amt::OptBitWidth bits() {
       if (_bits == kArrayDefaultBits) {
@@ -56,6 +60,19 @@ namespace fc::adt {
       return amt.remove(key);
     }
 
+    /// Replace content with values keyed by position, writing each node once
+    outcome::result<void> build(gsl::span<const Value> values) {
+      std::vector<std::pair<Key, storage::amt::Value>> items;
+      items.reserve(values.size());
+      for (Key key{0}; key < static_cast<Key>(values.size()); ++key) {
+        OUTCOME_TRY(bytes, Ipld::encode(values[key]));
+        items.emplace_back(key, std::move(bytes));
+      }
+      OUTCOME_TRY(root, Amt::build(amt.ipld, items, bits()));
+      amt = Amt{amt.ipld, root, bits()};
+      return outcome::success();
+    }
+
     outcome::result<void> append(const Value &value) {
       OUTCOME_TRY(count, amt.count());
       return set(count, value);
@@ -73,6 +90,28 @@ namespace fc::adt {
       });
     }
 
+    /// Visit entries added, removed or changed between arrays
+    static outcome::result<void> diff(const Array &before,
+                                      const Array &after,
+                                      const DiffVisitor &visitor) {
+      return Amt::diff(
+          before.amt,
+          after.amt,
+          [&](auto key, auto &value_before, auto &value_after)
+              -> outcome::result<void> {
+            boost::optional<Value> value_before2, value_after2;
+            if (value_before) {
+              OUTCOME_TRYA(value_before2,
+                           before.amt.ipld->decode<Value>(*value_before));
+            }
+            if (value_after) {
+              OUTCOME_TRYA(value_after2,
+                           after.amt.ipld->decode<Value>(*value_after));
+            }
+            return visitor(key, value_before2, value_after2);
+          });
+    }
+
     outcome::result<std::vector<Value>> values() const {
       std::vector<Value> values;
       OUTCOME_TRY(visit([&](auto, auto &value) {
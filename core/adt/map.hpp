@@ -5,10 +5,11 @@
 
 #pragma once
 
-#include "storage/hamt/hamt.hpp"
+#include "storage/hamt/hamt_index.hpp"
 
 namespace fc::adt {
   using storage::hamt::Hamt;
+  using storage::hamt::HamtIndex;
 
   struct StringKeyer {
     using Key = std::string;
@@ -31,6 +32,10 @@ namespace fc::adt {
     using Key = typename Keyer::Key;
     using Visitor =
         std::function<outcome::result<void>(const Key &, const Value &)>;
+    using DiffVisitor =
+        std::function<outcome::result<void>(const Key &,
+                                            const boost::optional<Value> &,
+                                            const boost::optional<Value> &)>;
 
     Map(IpldPtr ipld = nullptr) : hamt{ipld, bit_width, v3} {}
 
@@ -65,8 +70,42 @@ namespace fc::adt {
       });
     }
 
-    outcome::result<std::vector<Key>> keys() const {
+    /// Visit entries added, removed or changed between maps
+    static outcome::result<void> diff(const Map &before,
+                                      const Map &after,
+                                      const DiffVisitor &visitor) {
+      return Hamt::diff(
+          before.hamt,
+          after.hamt,
+          [&](auto &key, auto &value_before, auto &value_after)
+              -> outcome::result<void> {
+            OUTCOME_TRY(key2, Keyer::decode(key));
+            boost::optional<Value> value_before2, value_after2;
+            if (value_before) {
+              OUTCOME_TRYA(value_before2,
+                           before.hamt.ipld->decode<Value>(*value_before));
+            }
+            if (value_after) {
+              OUTCOME_TRYA(value_after2,
+                           after.hamt.ipld->decode<Value>(*value_after));
+            }
+            return visitor(key2, value_before2, value_after2);
+          });
+    }
+
+    /// Keys, using cached subtree keys if index is given
+    outcome::result<std::vector<Key>> keys(
+        const std::shared_ptr<HamtIndex> &index = nullptr) const {
       std::vector<Key> keys;
+      if (index) {
+        OUTCOME_TRY(raw_keys, index->keys(hamt));
+        keys.reserve(raw_keys.size());
+        for (auto &key : raw_keys) {
+          OUTCOME_TRY(key2, Keyer::decode(key));
+          keys.push_back(std::move(key2));
+        }
+        return keys;
+      }
       OUTCOME_TRY(hamt.visit([&](auto &key, auto &) -> outcome::result<void> {
         OUTCOME_TRY(key2, Keyer::decode(key));
         keys.push_back(std::move(key2));
@@ -75,7 +114,12 @@ namespace fc::adt {
       return keys;
     }
 
-    outcome::result<size_t> size() const {
+    /// Entry count, using cached subtree counts if index is given
+    outcome::result<size_t> size(
+        const std::shared_ptr<HamtIndex> &index = nullptr) const {
+      if (index) {
+        return index->count(hamt);
+      }
       size_t size{};
       OUTCOME_TRY(hamt.visit([&](auto &key, auto &) -> outcome::result<void> {
         ++size;
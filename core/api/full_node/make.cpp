@@ -16,6 +16,7 @@
 #include "drand/beaconizer.hpp"
 #include "markets/retrieval/protocols/retrieval_protocol.hpp"
 #include "node/pubsub_gate.hpp"
+#include "primitives/address/address_codec.hpp"
 #include "primitives/tipset/chain.hpp"
 #include "proofs/impl/proof_engine_impl.hpp"
 #include "storage/hamt/hamt.hpp"
@@ -114,10 +115,21 @@ namespace fc::api {
     TipsetCPtr tipset;
     StateTreeImpl state_tree;
     boost::optional<InterpreterResult> interpreted;
+    CID state_root;
+    std::shared_ptr<StateCache> state_cache;
+
+    outcome::result<Address> lookupId(const Address &address) {
+      OUTCOME_TRY(id, state_cache->lookupId(state_root, state_tree, address));
+      return Address::makeFromId(id);
+    }
+
+    outcome::result<Actor> actor(const Address &address) {
+      return state_cache->actor(state_root, state_tree, address);
+    }
 
     auto marketState() -> outcome::result<MarketActorStatePtr> {
       const StateProvider provider(state_tree.getStore());
-      OUTCOME_TRY(actor, state_tree.get(kStorageMarketAddress));
+      OUTCOME_TRY(actor, this->actor(kStorageMarketAddress));
       OUTCOME_TRY(state, provider.getMarketActorState(actor));
       return std::move(state);
     }
@@ -125,21 +137,21 @@ namespace fc::api {
     auto minerState(const Address &address)
         -> outcome::result<MinerActorStatePtr> {
       const StateProvider provider(state_tree.getStore());
-      OUTCOME_TRY(actor, state_tree.get(address));
+      OUTCOME_TRY(actor, this->actor(address));
       OUTCOME_TRY(state, provider.getMinerActorState(actor));
       return std::move(state);
     }
 
     auto powerState() -> outcome::result<PowerActorStatePtr> {
       const StateProvider provider(state_tree.getStore());
-      OUTCOME_TRY(actor, state_tree.get(kStoragePowerAddress));
+      OUTCOME_TRY(actor, this->actor(kStoragePowerAddress));
       OUTCOME_TRY(state, provider.getPowerActorState(actor));
       return std::move(state);
     }
 
     auto initState() -> outcome::result<InitActorStatePtr> {
       const StateProvider provider(state_tree.getStore());
-      OUTCOME_TRY(actor, state_tree.get(kInitAddress));
+      OUTCOME_TRY(actor, this->actor(kInitAddress));
       OUTCOME_TRY(state, provider.getInitActorState(actor));
       return std::move(state);
     }
@@ -147,13 +159,13 @@ namespace fc::api {
     auto verifiedRegistryState()
         -> outcome::result<VerifiedRegistryActorStatePtr> {
       const StateProvider provider(state_tree.getStore());
-      OUTCOME_TRY(actor, state_tree.get(kVerifiedRegistryAddress));
+      OUTCOME_TRY(actor, this->actor(kVerifiedRegistryAddress));
       return provider.getVerifiedRegistryActorState(actor);
     }
 
     outcome::result<Address> accountKey(const Address &id) {
       const StateProvider provider(state_tree.getStore());
-      OUTCOME_TRY(actor, state_tree.get(id));
+      OUTCOME_TRY(actor, this->actor(id));
       OUTCOME_TRY(state, provider.getAccountActorState(actor));
       return state->address;
     }
@@ -213,7 +225,9 @@ namespace fc::api {
       std::shared_ptr<KeyStore> key_store,
       std::shared_ptr<Discovery> market_discovery,
       const std::shared_ptr<RetrievalClient> &retrieval_market_client,
-      const std::shared_ptr<OneKey> &wallet_default_address) {
+      const std::shared_ptr<OneKey> &wallet_default_address,
+      std::shared_ptr<StateCache> state_cache,
+      std::shared_ptr<HamtIndex> hamt_index) {
     auto ts_load{env_context.ts_load};
     auto ipld{env_context.ipld};
     auto interpreter_cache{env_context.interpreter_cache};
@@ -226,11 +240,16 @@ namespace fc::api {
       } else {
         OUTCOME_TRYA(tipset, ts_load->load(tipset_key));
       }
-      TipsetContext context{tipset, {ipld, tipset->getParentStateRoot()}, {}};
+      TipsetContext context{tipset,
+                            {ipld, tipset->getParentStateRoot()},
+                            {},
+                            tipset->getParentStateRoot(),
+                            state_cache};
       if (interpret) {
         OUTCOME_TRY(result, interpreter_cache->get(tipset->key));
         context.state_tree = {ipld, result.state_root};
         context.interpreted = result;
+        context.state_root = result.state_root;
       }
       return context;
     };
@@ -708,7 +727,7 @@ namespace fc::api {
     api->StateGetActor = {
         [=](auto &address, auto &tipset_key) -> outcome::result<Actor> {
           OUTCOME_TRY(context, tipsetContext(tipset_key, true));
-          return context.state_tree.get(address);
+          return context.actor(address);
         }};
     api->StateReadState = {
         [=](auto &actor, auto &tipset_key) -> outcome::result<ActorState> {
@@ -736,7 +755,7 @@ namespace fc::api {
         [=](auto &tipset_key) -> outcome::result<std::vector<Address>> {
           OUTCOME_TRY(context, tipsetContext(tipset_key));
           OUTCOME_TRY(power_state, context.powerState());
-          return power_state->getClaimsKeys();
+          return power_state->getClaimsKeys(hamt_index);
         }};
     api->StateListActors = {
         [=](auto &tipset_key) -> outcome::result<std::vector<Address>> {
@@ -744,13 +763,30 @@ namespace fc::api {
           OUTCOME_TRY(root, context.state_tree.flush());
           adt::Map<Actor, adt::AddressKeyer> actors{root, ipld};
 
-          return actors.keys();
+          return actors.keys(hamt_index);
+        }};
+    api->StateChangedActors = {
+        [=](auto &old_root, auto &new_root) -> outcome::result<ActorMap> {
+          StateTreeImpl tree_before{ipld, old_root};
+          StateTreeImpl tree_after{ipld, new_root};
+          ActorMap actors;
+          OUTCOME_TRY(adt::Map<Actor, adt::AddressKeyer>::diff(
+              tree_before.actors(),
+              tree_after.actors(),
+              [&](auto &address, auto &, auto &actor) {
+                if (actor) {
+                  actors.emplace(primitives::address::encodeToString(address),
+                                 *actor);
+                }
+                return outcome::success();
+              }));
+          return actors;
         }};
     api->StateMarketBalance = {
         [=](auto &address, auto &tipset_key) -> outcome::result<MarketBalance> {
           OUTCOME_TRY(context, tipsetContext(tipset_key));
           OUTCOME_TRY(state, context.marketState());
-          OUTCOME_TRY(id_address, context.state_tree.lookupId(address));
+          OUTCOME_TRY(id_address, context.lookupId(address));
           OUTCOME_TRY(escrow, state->escrow_table.tryGet(id_address));
           OUTCOME_TRY(locked, state->locked_table.tryGet(id_address));
           if (!escrow) {
@@ -777,7 +813,7 @@ namespace fc::api {
     api->StateLookupID = {
         [=](auto &address, auto &tipset_key) -> outcome::result<Address> {
           OUTCOME_TRY(context, tipsetContext(tipset_key));
-          return context.state_tree.lookupId(address);
+          return context.lookupId(address);
         }};
     api->StateMarketStorageDeal = {
         [=](auto deal_id, auto &tipset_key) -> outcome::result<StorageDeal> {
@@ -919,7 +955,7 @@ namespace fc::api {
                                          const TipsetKey &tipset_key)
         -> outcome::result<boost::optional<StoragePower>> {
       OUTCOME_TRY(context, tipsetContext(tipset_key, true));
-      OUTCOME_TRY(id, context.state_tree.lookupId(address));
+      OUTCOME_TRY(id, context.lookupId(address));
       OUTCOME_TRY(state, context.verifiedRegistryState());
       return state->getVerifiedClientDataCap(id);
     };
@@ -937,12 +973,8 @@ namespace fc::api {
       // TODO(turuslan): chain store must validate blocks before adding
       MsgMeta meta;
       ipld->load(meta);
-      for (auto &cid : block.bls_messages) {
-        OUTCOME_TRY(meta.bls_messages.append(cid));
-      }
-      for (auto &cid : block.secp_messages) {
-        OUTCOME_TRY(meta.secp_messages.append(cid));
-      }
+      OUTCOME_TRY(meta.bls_messages.build(block.bls_messages));
+      OUTCOME_TRY(meta.secp_messages.build(block.secp_messages));
       OUTCOME_TRY(messages, ipld->setCbor(meta));
       if (block.header.messages != messages) {
         return ERROR_TEXT("SyncSubmitBlock: messages cid doesn't match");
@@ -956,7 +988,7 @@ namespace fc::api {
     }};
     api->WalletBalance = {[=](auto &address) -> outcome::result<TokenAmount> {
       OUTCOME_TRY(context, tipsetContext({}));
-      OUTCOME_TRY(actor, context.state_tree.get(address));
+      OUTCOME_TRY(actor, context.actor(address));
       return actor.balance;
     }};
     api->WalletDefaultAddress = {[=]() -> outcome::result<Address> {
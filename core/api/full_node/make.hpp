@@ -6,12 +6,14 @@
 #pragma once
 
 #include "api/full_node/node_api.hpp"
+#include "api/full_node/state_cache.hpp"
 #include "blockchain/weight_calculator.hpp"
 #include "fwd.hpp"
 #include "markets/discovery/discovery.hpp"
 #include "markets/retrieval/client/retrieval_client.hpp"
 #include "storage/chain/chain_store.hpp"
 #include "storage/chain/msg_waiter.hpp"
+#include "storage/hamt/hamt_index.hpp"
 #include "storage/keystore/keystore.hpp"
 #include "storage/leveldb/prefix.hpp"
 #include "storage/mpool/mpool.hpp"
@@ -27,6 +29,7 @@ namespace fc::api {
   using storage::OneKey;
   using storage::blockchain::ChainStore;
   using storage::blockchain::MsgWaiter;
+  using storage::hamt::HamtIndex;
   using storage::keystore::KeyStore;
   using storage::mpool::MessagePool;
   using sync::PubSubGate;
@@ -50,5 +53,7 @@ namespace fc::api {
       std::shared_ptr<KeyStore> key_store,
       std::shared_ptr<Discovery> market_discovery,
       const std::shared_ptr<RetrievalClient> &retrieval_market_client,
-      const std::shared_ptr<OneKey> &wallet_default_address);
+      const std::shared_ptr<OneKey> &wallet_default_address,
+      std::shared_ptr<StateCache> state_cache,
+      std::shared_ptr<HamtIndex> hamt_index);
 }  // namespace fc::api
@@ -85,6 +85,7 @@ namespace fc::api {
   };
 
   using MarketDealMap = std::map<std::string, StorageDeal>;
+  using ActorMap = std::map<std::string, Actor>;
 
   struct FileRef {
     std::string path;
@@ -478,6 +479,11 @@ namespace fc::api {
     API_METHOD(StateGetReceipt, MessageReceipt, const CID &, const TipsetKey &)
     API_METHOD(StateListMiners, std::vector<Address>, const TipsetKey &)
     API_METHOD(StateListActors, std::vector<Address>, const TipsetKey &)
+    /**
+     * Returns actors added or changed between two state roots, keyed by
+     * address string. Unchanged subtrees of state are not loaded.
+     */
+    API_METHOD(StateChangedActors, ActorMap, const CID &, const CID &)
     API_METHOD(StateMarketBalance,
                MarketBalance,
                const Address &,
@@ -618,6 +624,7 @@ namespace fc::api {
     f(a.PaychVoucherCreate);
     f(a.StateAccountKey);
     f(a.StateCall);
+    f(a.StateChangedActors);
     f(a.StateGetActor);
     f(a.StateGetReceipt);
     f(a.StateListActors);
@@ -0,0 +1,98 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/full_node/state_cache.hpp"
+
+#include <boost/container_hash/hash.hpp>
+
+#include "primitives/address/address_codec.hpp"
+
+namespace fc::api {
+  using common::Buffer;
+  using primitives::address::encode;
+
+  namespace {
+    /// Nodes of list and map
+    constexpr size_t kEntryOverhead{64};
+
+    size_t cidBytes(const CID &cid) {
+      return cid.content_address.getHash().size();
+    }
+
+    size_t idBytes(const CID &root) {
+      return kEntryOverhead + sizeof(std::pair<CID, Address>) + sizeof(ActorId)
+             + cidBytes(root);
+    }
+
+    size_t actorBytes(const CID &root, const Actor &actor) {
+      return kEntryOverhead + sizeof(StateCache::Key) + sizeof(Actor)
+             + cidBytes(root) + cidBytes(actor.code) + cidBytes(actor.head);
+    }
+  }  // namespace
+
+  StateCache::Shard::Shard(size_t bytes) {
+    ids.max_bytes = bytes / 2;
+    actors.max_bytes = bytes - ids.max_bytes;
+  }
+
+  StateCache::StateCache(size_t bytes, size_t shards) {
+    assert(shards != 0);
+    for (size_t i{}; i < shards; ++i) {
+      shards_.push_back(std::make_unique<Shard>(bytes / shards));
+    }
+  }
+
+  outcome::result<ActorId> StateCache::lookupId(const CID &root,
+                                                const StateTreeImpl &tree,
+                                                const Address &address) {
+    if (address.isId()) {
+      return address.getId();
+    }
+    auto key{std::make_pair(root, address)};
+    auto &shard{this->shard(root, std::hash<Buffer>{}(encode(address)))};
+    std::unique_lock lock{shard.mutex};
+    if (auto id{shard.ids.get(key)}) {
+      return *id;
+    }
+    lock.unlock();
+    OUTCOME_TRY(id, tree.lookupId(address));
+    lock.lock();
+    shard.ids.insert(key, id.getId(), idBytes(root));
+    return id.getId();
+  }
+
+  outcome::result<Actor> StateCache::actor(const CID &root,
+                                           const StateTreeImpl &tree,
+                                           const Address &address) {
+    OUTCOME_TRY(id, lookupId(root, tree, address));
+    const Key key{root, id};
+    auto &shard{this->shard(root, id)};
+    std::unique_lock lock{shard.mutex};
+    if (auto actor{shard.actors.get(key)}) {
+      ++actor_hits;
+      return *actor;
+    }
+    lock.unlock();
+    ++actor_misses;
+    OUTCOME_TRY(actor, tree.get(Address::makeFromId(id)));
+    lock.lock();
+    shard.actors.insert(key, actor, actorBytes(root, actor));
+    return actor;
+  }
+
+  StateCache::Shard &StateCache::shard(const CID &root, size_t hash) {
+    boost::hash_combine(hash, std::hash<CID>{}(root));
+    return *shards_[hash % shards_.size()];
+  }
+
+  size_t StateCache::bytes() const {
+    size_t bytes{};
+    for (auto &shard : shards_) {
+      std::lock_guard lock{shard->mutex};
+      bytes += shard->ids.bytes + shard->actors.bytes;
+    }
+    return bytes;
+  }
+}  // namespace fc::api
@@ -0,0 +1,99 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <boost/optional.hpp>
+#include <list>
+#include <map>
+#include <mutex>
+
+#include "vm/state/impl/state_tree_impl.hpp"
+
+namespace fc::api {
+  using primitives::address::Address;
+  using vm::actor::Actor;
+  using vm::state::StateTreeImpl;
+
+  constexpr size_t kStateCacheBytes{64 << 20};
+
+  /**
+   * Cache of id lookups and actors for api state queries.
+   * Keyed by state root, so entries never become stale.
+   * Decoded actor states are not cached, they lazily load and keep nodes,
+   * so they are neither safe to share between calls nor small.
+   * Split into shards by key hash to reduce lock contention, each shard is
+   * limited by estimated bytes of its entries.
+   */
+  class StateCache {
+   public:
+    using Key = std::pair<CID, ActorId>;
+
+    explicit StateCache(size_t bytes, size_t shards = 16);
+
+    /// Resolve id address, using cache
+    outcome::result<ActorId> lookupId(const CID &root,
+                                      const StateTreeImpl &tree,
+                                      const Address &address);
+
+    /// Get actor, using cache
+    outcome::result<Actor> actor(const CID &root,
+                                 const StateTreeImpl &tree,
+                                 const Address &address);
+
+    /// Estimated bytes of cached entries
+    size_t bytes() const;
+
+    std::atomic_uint64_t actor_hits{}, actor_misses{};
+
+   private:
+    /// Least recently used entries are evicted when bytes exceed limit
+    template <typename K, typename V>
+    struct Lru {
+      using Entry = std::tuple<K, V, size_t>;
+
+      boost::optional<V> get(const K &key) {
+        auto it{map.find(key)};
+        if (it == map.end()) {
+          return boost::none;
+        }
+        list.splice(list.begin(), list, it->second);
+        return std::get<1>(*it->second);
+      }
+
+      void insert(const K &key, V value, size_t entry_bytes) {
+        if (map.count(key)) {
+          return;
+        }
+        list.emplace_front(key, std::move(value), entry_bytes);
+        map.emplace(key, list.begin());
+        bytes += entry_bytes;
+        while (bytes > max_bytes && !list.empty()) {
+          auto &[evicted, _, evicted_bytes]{list.back()};
+          bytes -= evicted_bytes;
+          map.erase(evicted);
+          list.pop_back();
+        }
+      }
+
+      std::list<Entry> list;
+      std::map<K, typename std::list<Entry>::iterator> map;
+      size_t bytes{}, max_bytes{};
+    };
+
+    struct Shard {
+      explicit Shard(size_t bytes);
+
+      mutable std::mutex mutex;
+      Lru<std::pair<CID, Address>, ActorId> ids;
+      Lru<Key, Actor> actors;
+    };
+
+    Shard &shard(const CID &root, size_t hash);
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+  };
+}  // namespace fc::api
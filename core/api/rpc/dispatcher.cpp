@@ -0,0 +1,79 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/rpc/dispatcher.hpp"
+
+#include <boost/asio/post.hpp>
+
+namespace fc::api::rpc {
+  Dispatcher::Dispatcher(size_t threads) : pool_{threads} {}
+
+  void Dispatcher::limit(const std::string &method, size_t limit) {
+    auto &limited{methods_[method]};
+    if (!limited) {
+      limited = std::make_shared<Limited>();
+    }
+    limited->limit = std::max<size_t>(1, limit);
+  }
+
+  void Dispatcher::wrap(Rpc &rpc) {
+    for (auto &[name, limited] : methods_) {
+      auto it{rpc.ms.find(name)};
+      if (it == rpc.ms.end() || !it->second) {
+        continue;
+      }
+      it->second = [this, limited{limited}, method{std::move(it->second)}](
+                       const Value &jparams,
+                       Respond respond,
+                       MakeChan make_chan,
+                       Send send) {
+        // request is destroyed after return, keep own copy of params
+        auto params{std::make_shared<Document>()};
+        params->CopyFrom(jparams, params->GetAllocator());
+        enqueue(limited,
+                {std::move(params),
+                 method,
+                 std::move(respond),
+                 std::move(make_chan),
+                 std::move(send)});
+      };
+    }
+  }
+
+  void Dispatcher::enqueue(const std::shared_ptr<Limited> &limited,
+                           Call &&call) {
+    ++limited->stats.calls;
+    std::unique_lock lock{limited->mutex};
+    if (limited->stats.running >= limited->limit) {
+      limited->queue.push_back(std::move(call));
+      ++limited->stats.queued;
+      return;
+    }
+    ++limited->stats.running;
+    lock.unlock();
+    boost::asio::post(pool_, [this, limited, call{std::move(call)}]() mutable {
+      run(limited, std::move(call));
+    });
+  }
+
+  void Dispatcher::run(const std::shared_ptr<Limited> &limited, Call &&call) {
+    call.method(*call.params,
+                std::move(call.respond),
+                std::move(call.make_chan),
+                std::move(call.send));
+    std::unique_lock lock{limited->mutex};
+    if (limited->queue.empty()) {
+      --limited->stats.running;
+      return;
+    }
+    auto next{std::move(limited->queue.front())};
+    limited->queue.pop_front();
+    --limited->stats.queued;
+    lock.unlock();
+    boost::asio::post(pool_, [this, limited, next{std::move(next)}]() mutable {
+      run(limited, std::move(next));
+    });
+  }
+}  // namespace fc::api::rpc
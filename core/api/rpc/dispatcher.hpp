@@ -0,0 +1,69 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <boost/asio/thread_pool.hpp>
+#include <deque>
+#include <mutex>
+
+#include "api/rpc/rpc.hpp"
+
+namespace fc::api::rpc {
+  /**
+   * Runs configured RPC methods on worker pool instead of io thread.
+   * Each configured method runs at most `limit` calls at once, other calls
+   * wait in its queue. Methods not configured run inline on io thread, so
+   * cheap calls like ChainHead are never queued behind heavy state scans.
+   * Configured methods must be safe to run concurrently with io thread.
+   */
+  class Dispatcher {
+   public:
+    struct Stats {
+      std::atomic_size_t queued{}, running{};
+      std::atomic_uint64_t calls{};
+    };
+
+    explicit Dispatcher(size_t threads);
+
+    /** Runs `method` on pool, at most `limit` calls concurrently */
+    void limit(const std::string &method, size_t limit);
+
+    /** Replaces configured methods of `rpc` with dispatching wrappers */
+    void wrap(Rpc &rpc);
+
+    /** Calls `f(name, stats)` for each configured method */
+    template <typename F>
+    void stats(const F &f) const {
+      for (auto &[name, limited] : methods_) {
+        f(name, limited->stats);
+      }
+    }
+
+   private:
+    struct Call {
+      std::shared_ptr<Document> params;
+      Method method;
+      Respond respond;
+      MakeChan make_chan;
+      Send send;
+    };
+
+    struct Limited {
+      size_t limit;
+      Stats stats;
+      std::mutex mutex;
+      std::deque<Call> queue;
+    };
+
+    void enqueue(const std::shared_ptr<Limited> &limited, Call &&call);
+    void run(const std::shared_ptr<Limited> &limited, Call &&call);
+
+    std::map<std::string, std::shared_ptr<Limited>> methods_;
+    /** Declared last, so workers are joined before methods are destroyed */
+    boost::asio::thread_pool pool_;
+  };
+}  // namespace fc::api::rpc
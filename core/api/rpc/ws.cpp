@@ -5,10 +5,12 @@
 
 #include "api/rpc/ws.hpp"
 
+#include <atomic>
 #include <queue>
 
 #include <boost/asio/deadline_timer.hpp>
 #include <boost/asio/dispatch.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/websocket.hpp>
 
@@ -30,6 +32,9 @@ namespace fc::api {
 
   const auto kChanCloseDelay{boost::posix_time::milliseconds(100)};
 
+  /** Size of websocket frame for responses, large ones are fragmented */
+  constexpr size_t kWriteChunk{64 << 10};
+
   struct SocketSession : std::enable_shared_from_this<SocketSession> {
     SocketSession(tcp::socket &&socket, const Rpc &api_rpc)
         : socket{std::move(socket)},
@@ -72,9 +77,14 @@ namespace fc::api {
             {});
       }
       auto &req = maybe_req.value();
+      // methods may respond and send from other threads, writes are posted
+      // to session executor in call order
       auto respond = [id{req.id}, self{shared_from_this()}](auto res) {
         if (id) {
-          self->_write(Response{*id, std::move(res)}, {});
+          net::post(self->socket.get_executor(),
+                    [self, res{Response{*id, std::move(res)}}]() mutable {
+                      self->_write(std::move(res), {});
+                    });
         }
       };
       auto it = rpc.ms.find(req.method);
@@ -84,40 +94,91 @@ namespace fc::api {
       it->second(
           req.params,
           std::move(respond),
-          [&]() { return next_channel++; },
+          [self{shared_from_this()}]() { return self->next_channel++; },
           [self{shared_from_this()}](auto method, auto params, auto cb) {
-            Request req{self->next_request++, method, std::move(params)};
-            if (method == "xrpc.ch.close") {
-              self->timer.expires_from_now(kChanCloseDelay);
-              self->timer.async_wait(
-                  [self, req{std::move(req)}, cb{std::move(cb)}](auto) {
-                    self->_write(req, std::move(cb));
-                  });
-              return;
-            }
-            self->_write(req, std::move(cb));
+            net::post(self->socket.get_executor(),
+                      [self,
+                       req{Request{self->next_request++,
+                                   std::move(method),
+                                   std::move(params)}},
+                       cb{std::move(cb)}]() mutable {
+                        self->send(std::move(req), std::move(cb));
+                      });
           });
     }
 
-    template <typename T>
-    void _write(const T &v, OkCb cb) {
-      pending_writes.emplace(*codec::json::format(encode(v)), std::move(cb));
+    void send(Request &&req, OkCb cb) {
+      if (req.method == kRpcChClose) {
+        timer.expires_from_now(kChanCloseDelay);
+        timer.async_wait([self{shared_from_this()},
+                          req{std::move(req)},
+                          cb{std::move(cb)}](auto) mutable {
+          self->_write(std::move(req), std::move(cb));
+        });
+        return;
+      }
+      _write(std::move(req), std::move(cb));
+    }
+
+    /** Moves request params into encoded request without deep copy */
+    void _write(Request &&req, OkCb cb) {
+      auto params{std::move(req.params)};
+      req.params.SetNull();
+      _write(encode(req), std::move(params), "params", std::move(cb));
+    }
+
+    /** Moves response result into encoded response without deep copy */
+    void _write(Response &&res, OkCb cb) {
+      if (auto result{boost::get<Document>(&res.result)}) {
+        auto payload{std::move(*result)};
+        result->SetNull();
+        return _write(
+            encode(res), std::move(payload), "result", std::move(cb));
+      }
+      _write(encode(res), Document{}, nullptr, std::move(cb));
+    }
+
+    /** Queues document, `payload` is swapped into `doc[key]` if `key` */
+    void _write(Document &&doc, Document &&payload, const char *key, OkCb cb) {
+      auto &write{pending_writes.emplace()};
+      write.doc = std::move(doc);
+      write.payload = std::move(payload);
+      if (key) {
+        write.doc[key].Swap(write.payload);
+      }
+      write.cb = std::move(cb);
       _flush();
     }
 
+    /**
+     * Writes next chunk of front document as websocket frame.
+     * Chunk is formatted only after previous frame was written, so memory
+     * for formatted text is bounded by chunk size.
+     */
     void _flush() {
       if (!writing && !pending_writes.empty()) {
-        auto &[buffer, cb] = pending_writes.front();
+        auto &write{pending_writes.front()};
+        if (!write.formatter) {
+          write.formatter.emplace(&write.doc);
+        }
+        auto done{*write.formatter->next(chunk, kWriteChunk)};
         writing = true;
-        socket.async_write(
-            net::buffer(buffer.data(), buffer.size()),
-            [self{shared_from_this()}, cb{std::move(cb)}](auto e, auto) {
+        socket.async_write_some(
+            done,
+            net::buffer(chunk.data(), chunk.size()),
+            [self{shared_from_this()}, done](auto e, auto) {
               self->writing = false;
               auto ok = !e;
+              OkCb cb;
+              if (!ok || done) {
+                cb = std::move(self->pending_writes.front().cb);
+              }
               if (!ok) {
                 self->pending_writes = {};
               } else {
-                self->pending_writes.pop();
+                if (done) {
+                  self->pending_writes.pop();
+                }
                 self->_flush();
               }
               if (cb) {
@@ -127,9 +188,18 @@ namespace fc::api {
       }
     }
 
-    std::queue<std::pair<Buffer, OkCb>> pending_writes;
+    struct Write {
+      /** Owns value swapped into `doc`, must outlive `doc` */
+      Document payload;
+      Document doc;
+      boost::optional<codec::json::ChunkFormatter> formatter;
+      OkCb cb;
+    };
+
+    std::queue<Write> pending_writes;
+    Buffer chunk;
     bool writing{false};
-    uint64_t next_channel{}, next_request{};
+    std::atomic_uint64_t next_channel{}, next_request{};
     websocket::stream<tcp::socket> socket;
     net::deadline_timer timer;
     beast::flat_buffer buffer;
@@ -219,6 +289,10 @@ namespace fc::api {
                      std::get_if<http::response<http::empty_body>>(
                          &(w_response.response))) {
         doWrite(*e_response);
+      } else if (auto r_response =
+                     std::get_if<http::response<FileRangeBody>>(
+                         &(w_response.response))) {
+        doWrite(*r_response);
       }
     }
 
@@ -5,7 +5,9 @@
 
 #pragma once
 
+#include <array>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core/file.hpp>
 #include <boost/beast/http.hpp>
 #include <map>
 #include <variant>
@@ -21,9 +23,71 @@ namespace fc::api {
   using tcp = boost::asio::ip::tcp;
   using rpc::Rpc;
 
+  /**
+   * Body of byte range of file.
+   * Unlike `http::file_body` serves only part of file, for `Range` requests.
+   */
+  struct FileRangeBody {
+    struct value_type {
+      uint64_t size() const {
+        return length;
+      }
+
+      boost::beast::file file;
+      uint64_t offset{};
+      uint64_t length{};
+    };
+
+    static uint64_t size(const value_type &body) {
+      return body.length;
+    }
+
+    class writer {
+     public:
+      using const_buffers_type = boost::asio::const_buffer;
+
+      template <bool isRequest, class Fields>
+      writer(http::header<isRequest, Fields> &, value_type &body)
+          : body_{body} {}
+
+      void init(boost::beast::error_code &ec) {
+        body_.file.seek(body_.offset, ec);
+        remain_ = body_.length;
+      }
+
+      boost::optional<std::pair<const_buffers_type, bool>> get(
+          boost::beast::error_code &ec) {
+        if (remain_ == 0) {
+          ec = {};
+          return boost::none;
+        }
+        auto n{body_.file.read(
+            buffer_.data(),
+            static_cast<size_t>(std::min<uint64_t>(buffer_.size(), remain_)),
+            ec)};
+        if (ec) {
+          return boost::none;
+        }
+        if (n == 0) {
+          ec = http::error::short_read;
+          return boost::none;
+        }
+        remain_ -= n;
+        return std::make_pair(const_buffers_type{buffer_.data(), n},
+                              remain_ != 0);
+      }
+
+     private:
+      value_type &body_;
+      uint64_t remain_{};
+      std::array<char, 64 << 10> buffer_{};
+    };
+  };
+
   using ResponseType = std::variant<http::response<http::file_body>,
                                     http::response<http::string_body>,
-                                    http::response<http::empty_body>>;
+                                    http::response<http::empty_body>,
+                                    http::response<FileRangeBody>>;
 
   // Wrapper for any type of response
   // This is necessary in order not to lose the response before recording
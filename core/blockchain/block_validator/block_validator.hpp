@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <gsl/span>
+
 #include "blockchain/block_validator/block_validator_scenarios.hpp"
 #include "common/outcome.hpp"
 #include "primitives/block/block.hpp"
@@ -17,6 +19,7 @@ namespace fc::blockchain::block_validator {
   class BlockValidator {
    public:
     using BlockHeader = primitives::block::BlockHeader;
+    using BlockWithCids = primitives::block::BlockWithCids;
 
     virtual ~BlockValidator() = default;
 
@@ -28,6 +31,14 @@ namespace fc::blockchain::block_validator {
      */
     virtual outcome::result<void> validateBlock(
         const BlockHeader &header, scenarios::Scenario scenario) const = 0;
+
+    /**
+     * @brief Validate aggregated signatures of BLS messages in one batch
+     * @param blocks - blocks with cids of their BLS messages, e.g. of tipset
+     * @return validation result
+     */
+    virtual outcome::result<void> validateBlsAggregates(
+        gsl::span<const BlockWithCids> blocks) const = 0;
   };
 
 }  // namespace fc::blockchain::block_validator
@@ -5,14 +5,20 @@
 
 #include "blockchain/block_validator/impl/block_validator_impl.hpp"
 
+#include <deque>
+
 #include "blockchain/block_validator/impl/consensus_rules.hpp"
 #include "blockchain/block_validator/impl/syntax_rules.hpp"
 #include "codec/cbor/cbor_codec.hpp"
 #include "primitives/cid/cid_of_cbor.hpp"
 #include "storage/amt/amt.hpp"
+#include "vm/runtime/env.hpp"
+#include "vm/state/impl/state_tree_impl.hpp"
 
 namespace fc::blockchain::block_validator {
+  using primitives::address::BLSPublicKeyHash;
   using primitives::address::Protocol;
+  using primitives::block::MsgMeta;
   using storage::amt::Amt;
   using SignedMessage = vm::message::SignedMessage;
   using UnsignedMessage = vm::message::UnsignedMessage;
@@ -46,6 +52,58 @@ namespace fc::blockchain::block_validator {
     return outcome::success();
   }
 
+  outcome::result<void> BlockValidatorImpl::validateBlsAggregates(
+      gsl::span<const BlockWithCids> blocks) const {
+    std::vector<crypto::bls::Aggregate> aggregates;
+    // signed cid bytes, referenced by aggregates
+    std::deque<std::vector<uint8_t>> signed_bytes;
+    for (const auto &block : blocks) {
+      if (block.bls_messages.empty()) {
+        continue;
+      }
+      if (!block.header.bls_aggregate
+          || !block.header.bls_aggregate->isBls()) {
+        return ValidatorError::kInvalidBlsAggregate;
+      }
+      auto &aggregate{aggregates.emplace_back()};
+      aggregate.signature =
+          boost::get<BlsCryptoSignature>(*block.header.bls_aggregate);
+      // senders with id addresses are resolved at parent state
+      std::shared_ptr<vm::state::StateTreeImpl> state_tree;
+      for (const auto &cid : block.bls_messages) {
+        OUTCOME_TRY(message, datastore_->getCbor<UnsignedMessage>(cid));
+        auto key{message.from};
+        if (!key.isBls()) {
+          if (!state_tree) {
+            state_tree = std::make_shared<vm::state::StateTreeImpl>(
+                datastore_, block.header.parent_state_root);
+          }
+          OUTCOME_TRYA(key,
+                       vm::runtime::resolveKey(
+                           *state_tree, datastore_, message.from, false));
+          if (!key.isBls()) {
+            return ValidatorError::kInvalidBlsAggregate;
+          }
+        }
+        const auto &public_key{boost::get<BLSPublicKeyHash>(key.data)};
+        auto &bls_public_key{aggregate.keys.emplace_back()};
+        std::copy_n(
+            public_key.begin(), bls_public_key.size(), bls_public_key.begin());
+        OUTCOME_TRY(bytes, cid.toBytes());
+        aggregate.messages.emplace_back(
+            signed_bytes.emplace_back(std::move(bytes)));
+      }
+    }
+    if (aggregates.empty()) {
+      return outcome::success();
+    }
+    OUTCOME_TRY(valid, bls_provider_->verifyAggregateSignatures(aggregates));
+    if (!valid) {
+      return ValidatorError::kInvalidBlsAggregate;
+    }
+    return outcome::success();
+  }
+
   outcome::result<void> BlockValidatorImpl::syntax(
       const BlockHeader &block) const {
     OUTCOME_TRY(SyntaxRules::parentsCount(block));
@@ -133,6 +191,34 @@ namespace fc::blockchain::block_validator {
 
   outcome::result<void> BlockValidatorImpl::messageSign(
       const BlockHeader &block) const {
+    // bls aggregate is checked by validateBlsAggregates with whole tipset
+    OUTCOME_TRY(meta, datastore_->getCbor<MsgMeta>(block.messages));
+    if (verifier_) {
+      // signatures of messages received from gossip are cached by verifier
+      std::vector<SignatureVerifier::Item> items;
+      boost::optional<vm::state::StateTreeImpl> state_tree;
+      OUTCOME_TRY(meta.secp_messages.visit(
+          [&](auto, auto &cid) -> outcome::result<void> {
+            OUTCOME_TRY(message, datastore_->getCbor<SignedMessage>(cid));
+            auto key{message.message.from};
+            if (!key.isKeyType()) {
+              if (!state_tree) {
+                state_tree.emplace(datastore_, block.parent_state_root);
+              }
+              OUTCOME_TRYA(key,
+                           vm::runtime::resolveKey(
+                               *state_tree, datastore_, key, false));
+            }
+            items.push_back(
+                {message.message.getCid(), message.signature, key});
+            return outcome::success();
+          }));
+      for (auto valid : verifier_->verify(items)) {
+        if (!valid) {
+          return ValidatorError::kInvalidMessageSignature;
+        }
+      }
+    }
     return outcome::success();
   }
 
@@ -190,6 +276,10 @@ OUTCOME_CPP_DEFINE_CATEGORY(fc::blockchain::block_validator,
       return "Block validation: invalid miner public key";
     case ValidatorError::kInvalidParentState:
       return "Block validation: invalid parent state";
+    case ValidatorError::kInvalidBlsAggregate:
+      return "Block validation: invalid BLS aggregate signature";
+    case ValidatorError::kInvalidMessageSignature:
+      return "Block validation: invalid message signature";
   }
   return "Block validation: unknown error";
 }
@@ -18,6 +18,7 @@
 #include "crypto/bls/bls_provider.hpp"
 #include "power/power_table.hpp"
 #include "storage/ipfs/datastore.hpp"
+#include "vm/message/signature_verifier.hpp"
 #include "vm/interpreter/interpreter.hpp"
 
 namespace fc::blockchain::block_validator {
@@ -35,6 +36,7 @@ namespace fc::blockchain::block_validator {
     using InterpreterCache = vm::interpreter::InterpreterCache;
     using Tipset = primitives::tipset::Tipset;
     using TipsetCPtr = primitives::tipset::TipsetCPtr;
+    using SignatureVerifier = vm::message::SignatureVerifier;
 
    public:
     using StageExecutor = outcome::result<void> (BlockValidatorImpl::*)(
@@ -47,7 +49,8 @@ namespace fc::blockchain::block_validator {
                        std::shared_ptr<PowerTable> power_table,
                        std::shared_ptr<BlsProvider> bls_crypto_provider,
                        std::shared_ptr<SecpProvider> secp_crypto_provider,
-                       std::shared_ptr<InterpreterCache> interpreter_cache)
+                       std::shared_ptr<InterpreterCache> interpreter_cache,
+                       std::shared_ptr<SignatureVerifier> verifier = nullptr)
         : datastore_{std::move(ipfs_store)},
           clock_{std::move(utc_clock)},
           epoch_clock_{std::move(epoch_clock)},
@@ -55,11 +58,15 @@ namespace fc::blockchain::block_validator {
           power_table_{std::move(power_table)},
           bls_provider_{std::move(bls_crypto_provider)},
           secp_provider_{std::move(secp_crypto_provider)},
-          interpreter_cache_{std::move(interpreter_cache)} {}
+          interpreter_cache_{std::move(interpreter_cache)},
+          verifier_{std::move(verifier)} {}
 
     outcome::result<void> validateBlock(
         const BlockHeader &header, scenarios::Scenario scenario) const override;
 
+    outcome::result<void> validateBlsAggregates(
+        gsl::span<const BlockWithCids> blocks) const override;
+
    private:
     const static std::map<scenarios::Stage, StageExecutor> stage_executors_;
 
@@ -71,6 +78,7 @@ namespace fc::blockchain::block_validator {
     std::shared_ptr<BlsProvider> bls_provider_;
     std::shared_ptr<SecpProvider> secp_provider_;
     std::shared_ptr<InterpreterCache> interpreter_cache_;
+    std::shared_ptr<SignatureVerifier> verifier_;
 
     /**
      * BlockHeader CID -> Parent tipset
@@ -115,7 +123,8 @@ namespace fc::blockchain::block_validator {
     outcome::result<void> chainAncestry(const BlockHeader &header) const;
 
     /**
-     * @brief Check block messages signatures
+     * @brief Check block secp messages signatures, BLS aggregate is checked
+     * by validateBlsAggregates for whole tipset
      * @param header - block to check
      * @return Check result
      */
@@ -143,6 +152,8 @@ namespace fc::blockchain::block_validator {
     kInvalidBlockSignature,
     kInvalidMinerPublicKey,
     kInvalidParentState,
+    kInvalidBlsAggregate,
+    kInvalidMessageSignature,
   };
 
 }  // namespace fc::blockchain::block_validator
@@ -33,9 +33,14 @@ namespace fc::blockchain::weight {
 
   outcome::result<BigInt> WeightCalculatorImpl::calculateWeight(
       const Tipset &tipset) {
-    StateProvider provider(ipld_);
+    return calculateWeight(ipld_, tipset);
+  }
+
+  outcome::result<BigInt> WeightCalculatorImpl::calculateWeight(
+      const IpldPtr &ipld, const Tipset &tipset) {
+    StateProvider provider(ipld);
     OUTCOME_TRY(actor,
-                StateTreeImpl{ipld_, tipset.getParentStateRoot()}.get(
+                StateTreeImpl{ipld, tipset.getParentStateRoot()}.get(
                     kStoragePowerAddress));
     OUTCOME_TRY(state, provider.getPowerActorState(actor));
     const StoragePower network_power = state->total_qa_power;
@@ -20,6 +20,9 @@ namespace fc::blockchain::weight {
 
     outcome::result<BigInt> calculateWeight(const Tipset &tipset) override;
 
+    outcome::result<BigInt> calculateWeight(const IpldPtr &ipld,
+                                            const Tipset &tipset) override;
+
    private:
     std::shared_ptr<Ipld> ipld_;
   };
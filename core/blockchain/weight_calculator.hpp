@@ -7,6 +7,7 @@
 
 #include "primitives/big_int.hpp"
 #include "primitives/tipset/tipset.hpp"
+#include "storage/ipfs/datastore.hpp"
 
 namespace fc::blockchain::weight {
   /**
@@ -21,5 +22,12 @@ namespace fc::blockchain::weight {
     virtual ~WeightCalculator() = default;
 
     virtual outcome::result<BigInt> calculateWeight(const Tipset &tipset) = 0;
+
+    /**
+     * Calculates weight reading parent state from `ipld`, which may have
+     * state not flushed to node store yet
+     */
+    virtual outcome::result<BigInt> calculateWeight(const IpldPtr &ipld,
+                                                    const Tipset &tipset) = 0;
   };
 }  // namespace fc::blockchain::weight
@@ -0,0 +1,118 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "codec/cbor/cbor_codec.hpp"
+#include "common/bench.hpp"
+#include "primitives/block/block.hpp"
+
+namespace fc::codec::cbor {
+  using common::bench;
+  using primitives::block::BlockHeader;
+  using vm::message::SignedMessage;
+
+  BlockHeader header(uint64_t i) {
+    CID cid{common::getCidOf(encode(i).value()).value()};
+    BlockHeader header;
+    header.miner = primitives::address::Address::makeFromId(1000 + i);
+    header.ticket = primitives::block::Ticket{Buffer(96, 1)};
+    header.election_proof = {1, Buffer(96, 2)};
+    header.beacon_entries = {{i, Buffer(96, 3)}};
+    header.win_post_proof = {
+        {primitives::sector::RegisteredPoStProof::
+             kStackedDRG32GiBWinningPoSt,
+         std::vector<uint8_t>(192, 4)}};
+    header.parents = {cid, cid, cid};
+    header.parent_weight = 1000000 + i;
+    header.height = i;
+    header.parent_state_root = cid;
+    header.parent_message_receipts = cid;
+    header.messages = cid;
+    header.bls_aggregate = crypto::signature::BlsSignature{};
+    header.timestamp = i;
+    header.block_sig = crypto::signature::BlsSignature{};
+    header.parent_base_fee = 100;
+    return header;
+  }
+
+  SignedMessage message(uint64_t i) {
+    SignedMessage message;
+    message.message.to = primitives::address::Address::makeFromId(1000 + i);
+    message.message.from = primitives::address::Address::makeFromId(2000 + i);
+    message.message.nonce = i;
+    message.message.value = 1000 + i;
+    message.message.gas_limit = 1000000;
+    message.message.gas_fee_cap = 100;
+    message.message.gas_premium = 10;
+    message.message.method = 5;
+    message.message.params = Buffer(256, 5);
+    message.signature = crypto::signature::BlsSignature{};
+    return message;
+  }
+
+  /** Decodes each item with copying stream, borrowed and shared input */
+  template <typename T>
+  void benchDecode(const std::string &name, const std::vector<Buffer> &items) {
+    std::vector<std::shared_ptr<const Buffer>> shared;
+    for (const auto &item : items) {
+      shared.push_back(std::make_shared<const Buffer>(item));
+    }
+    bench(name + " copy", items.size(), [&] {
+      for (const auto &item : items) {
+        T value{};
+        CborDecodeStream s{item};
+        s >> value;
+      }
+    });
+    bench(name + " borrow", items.size(), [&] {
+      for (const auto &item : items) {
+        decode<T>(item).value();
+      }
+    });
+    bench(name + " shared", items.size(), [&] {
+      for (const auto &item : shared) {
+        decode<T>(item).value();
+      }
+    });
+  }
+}  // namespace fc::codec::cbor
+
+/**
+ * Measures encoding and decoding of block headers and signed messages, and
+ * decoding of byte strings.
+ */
+int main(int argc, char **argv) {
+  using namespace fc::codec::cbor;
+  size_t count{argc > 1 ? std::stoull(argv[1]) : 10000};
+
+  std::vector<BlockHeader> header_values;
+  std::vector<SignedMessage> message_values;
+  for (size_t i{0}; i < count; ++i) {
+    header_values.push_back(header(i));
+    message_values.push_back(message(i));
+  }
+  std::vector<Buffer> headers, messages;
+  bench("BlockHeader encode", count, [&] {
+    for (const auto &value : header_values) {
+      headers.push_back(encode(value).value());
+    }
+  });
+  bench("SignedMessage encode", count, [&] {
+    for (const auto &value : message_values) {
+      messages.push_back(encode(value).value());
+    }
+  });
+  benchDecode<BlockHeader>("BlockHeader", headers);
+  benchDecode<SignedMessage>("SignedMessage", messages);
+
+  // leaf-like list of byte strings, views point into single buffer
+  auto list{std::make_shared<const Buffer>(
+      encode(std::vector<Buffer>(count, Buffer(256, 6))).value())};
+  bench("Buffer list", count, [&] {
+    decode<std::vector<Buffer>>(list).value();
+  });
+  bench("BytesView list", count, [&] {
+    decode<std::vector<BytesView>>(list).value();
+  });
+}
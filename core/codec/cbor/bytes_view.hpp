@@ -0,0 +1,75 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+
+#include "common/buffer.hpp"
+
+namespace fc::codec::cbor {
+  using common::Buffer;
+
+  /**
+   * Bytes decoded without copy.
+   * Points into source buffer of decoder and keeps it alive, so value stays
+   * valid after decoder is destroyed.
+   */
+  struct BytesView {
+    BytesView() = default;
+    BytesView(std::shared_ptr<const Buffer> source, BytesIn bytes)
+        : source{std::move(source)}, bytes{bytes} {}
+    /** Copies bytes into own source */
+    explicit BytesView(BytesIn bytes)
+        : BytesView{std::make_shared<const Buffer>(bytes), {}} {
+      this->bytes = *source;
+    }
+
+    size_t size() const {
+      return bytes.size();
+    }
+
+    bool empty() const {
+      return bytes.empty();
+    }
+
+    const uint8_t *data() const {
+      return bytes.data();
+    }
+
+    auto begin() const {
+      return bytes.begin();
+    }
+
+    auto end() const {
+      return bytes.end();
+    }
+
+    operator BytesIn() const {
+      return bytes;
+    }
+
+    Buffer copy() const {
+      return Buffer{bytes};
+    }
+
+    bool operator==(const BytesView &other) const {
+      return std::equal(
+          bytes.begin(), bytes.end(), other.bytes.begin(), other.bytes.end());
+    }
+
+    bool operator!=(const BytesView &other) const {
+      return !(*this == other);
+    }
+
+    std::shared_ptr<const Buffer> source;
+    BytesIn bytes;
+  };
+
+  CBOR_ENCODE(BytesView, view) {
+    return s << view.bytes;
+  }
+}  // namespace fc::codec::cbor
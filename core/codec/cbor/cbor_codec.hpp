@@ -24,7 +24,7 @@ namespace fc::codec::cbor {
     try {
       CborEncodeStream encoder;
       encoder << arg;
-      return Buffer{encoder.data()};
+      return Buffer{std::move(encoder).data()};
     } catch (std::system_error &e) {
       return outcome::failure(e.code());
     }
@@ -41,7 +41,27 @@ namespace fc::codec::cbor {
   outcome::result<T> decode(gsl::span<const uint8_t> input) {
     try {
       T data{};
-      CborDecodeStream decoder(input);
+      // input outlives decoder, no need to copy it
+      auto decoder{CborDecodeStream::borrow(input)};
+      decoder >> data;
+      return data;
+    } catch (std::system_error &e) {
+      return outcome::failure(e.code());
+    }
+  }
+
+  /**
+   * @brief CBOR decoding from shared buffer, `BytesView` fields of value
+   * point into input instead of copying
+   * @tparam T - type of the value to decode
+   * @param input - data to decode
+   * @return operation result
+   */
+  template <typename T>
+  outcome::result<T> decode(std::shared_ptr<const Buffer> input) {
+    try {
+      T data{};
+      CborDecodeStream decoder{std::move(input)};
       decoder >> data;
       return data;
     } catch (std::system_error &e) {
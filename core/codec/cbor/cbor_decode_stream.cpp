@@ -7,11 +7,24 @@
 
 namespace fc::codec::cbor {
   CborDecodeStream::CborDecodeStream(gsl::span<const uint8_t> data)
-      : data_(std::make_shared<std::vector<uint8_t>>(data.begin(), data.end())),
-        parser_(std::make_shared<CborParser>()) {
+      : CborDecodeStream{std::make_shared<const Buffer>(data)} {}
+
+  CborDecodeStream::CborDecodeStream(std::shared_ptr<const Buffer> data)
+      : data_{std::move(data)} {
+    init(*data_);
+  }
+
+  CborDecodeStream CborDecodeStream::borrow(gsl::span<const uint8_t> data) {
+    CborDecodeStream stream;
+    stream.init(data);
+    return stream;
+  }
+
+  void CborDecodeStream::init(gsl::span<const uint8_t> data) {
+    parser_ = std::make_shared<CborParser>();
     if (CborNoError
         != cbor_parser_init(
-            data_->data(), data_->size(), 0, parser_.get(), &value_)) {
+            data.data(), data.size(), 0, parser_.get(), &value_)) {
       if (!data.empty()) {
         outcome::raise(CborDecodeError::kInvalidCbor);
       }
@@ -40,6 +53,23 @@ namespace fc::codec::cbor {
     return *this >> gsl::make_span(bytes);
   }
 
+  CborDecodeStream &CborDecodeStream::operator>>(BytesView &bytes) {
+    auto size{bytesLength()};
+    if (data_ && cbor_value_is_length_known(&value_)) {
+      // definite length bytes are stored inline after header
+      auto ptr{value_.ptr};
+      auto info{*ptr & 0x1f};
+      auto header{info < 24 ? 1 : 1 + (1 << (info - 24))};
+      bytes = {data_, gsl::make_span(ptr + header, size)};
+      next();
+      return *this;
+    }
+    auto copy{std::make_shared<Buffer>()};
+    *this >> copy->toVector();
+    bytes = {copy, *copy};
+    return *this;
+  }
+
   CborDecodeStream &CborDecodeStream::operator>>(std::string &str) {
     if (!cbor_value_is_text_string(&value_)) {
       outcome::raise(CborDecodeError::kWrongType);
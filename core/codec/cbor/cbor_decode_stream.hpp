@@ -13,6 +13,7 @@
 #include <boost/optional.hpp>
 #include <gsl/span>
 
+#include "codec/cbor/bytes_view.hpp"
 #include "codec/cbor/cbor_errors.hpp"
 #include "codec/cbor/streams_annotation.hpp"
 #include "primitives/cid/cid.hpp"
@@ -23,7 +24,15 @@ namespace fc::codec::cbor {
    public:
     static constexpr auto is_cbor_decoder_stream = true;
 
+    /** Decodes copy of data */
     explicit CborDecodeStream(gsl::span<const uint8_t> data);
+    /** Decodes shared data without copy, `BytesView` point into it */
+    explicit CborDecodeStream(std::shared_ptr<const Buffer> data);
+    /**
+     * Decodes data without copy.
+     * Data must outlive stream and substreams, `BytesView` are copied.
+     */
+    static CborDecodeStream borrow(gsl::span<const uint8_t> data);
 
     /** Decodes integer or bool */
     template <
@@ -80,7 +89,7 @@ namespace fc::codec::cbor {
       } else {
         T value{kDefaultT<T>()};
         *this >> value;
-        optional = value;
+        optional = std::move(value);
       }
       return *this;
     }
@@ -93,9 +102,7 @@ namespace fc::codec::cbor {
       values.clear();
       values.reserve(n);
       for (auto i = 0u; i < n; ++i) {
-        T value{kDefaultT<T>()};
-        l >> value;
-        values.push_back(value);
+        l >> values.emplace_back(kDefaultT<T>());
       }
       return *this;
     }
@@ -113,6 +120,8 @@ namespace fc::codec::cbor {
     CborDecodeStream &operator>>(gsl::span<uint8_t> bytes);
     /** Decodes bytes */
     CborDecodeStream &operator>>(std::vector<uint8_t> &bytes);
+    /** Decodes bytes pointing into shared data if possible */
+    CborDecodeStream &operator>>(BytesView &bytes);
     /** Decodes string */
     CborDecodeStream &operator>>(std::string &str);
     /** Decodes CID */
@@ -156,9 +165,12 @@ namespace fc::codec::cbor {
     }
 
    private:
+    CborDecodeStream() = default;
+    void init(gsl::span<const uint8_t> data);
     CborDecodeStream container() const;
 
-    std::shared_ptr<std::vector<uint8_t>> data_;
+    /** Owned or shared data, null if borrowed */
+    std::shared_ptr<const Buffer> data_;
     std::shared_ptr<CborParser> parser_;
     CborValue value_{};
   };
@@ -5,6 +5,9 @@
 
 #include "codec/cbor/cbor_encode_stream.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 #include "codec/cbor/cbor_errors.hpp"
 
 namespace fc::codec::cbor {
@@ -16,29 +19,15 @@ namespace fc::codec::cbor {
   CborEncodeStream &CborEncodeStream::operator<<(
       gsl::span<const uint8_t> bytes) {
     addCount(1);
-
-    std::vector<uint8_t> encoded(9 + bytes.size());
-    CborEncoder encoder;
-    cbor_encoder_init(&encoder, encoded.data(), encoded.size(), 0);
-    cbor_encode_byte_string(&encoder, bytes.data(), bytes.size());
-    data_.insert(data_.end(),
-                 encoded.begin(),
-                 encoded.begin()
-                     + cbor_encoder_get_buffer_size(&encoder, encoded.data()));
+    writeHead(data_, kBytes, bytes.size());
+    data_.insert(data_.end(), bytes.begin(), bytes.end());
     return *this;
   }
 
   CborEncodeStream &CborEncodeStream::operator<<(const std::string &str) {
     addCount(1);
-
-    std::vector<uint8_t> encoded(9 + str.size());
-    CborEncoder encoder;
-    cbor_encoder_init(&encoder, encoded.data(), encoded.size(), 0);
-    cbor_encode_text_string(&encoder, str.data(), str.size());
-    data_.insert(data_.end(),
-                 encoded.begin(),
-                 encoded.begin()
-                     + cbor_encoder_get_buffer_size(&encoder, encoded.data()));
+    writeHead(data_, kText, str.size());
+    data_.insert(data_.end(), str.begin(), str.end());
     return *this;
   }
 
@@ -47,65 +36,50 @@ namespace fc::codec::cbor {
     if (maybe_cid_bytes.has_error()) {
       outcome::raise(CborEncodeError::kInvalidCID);
     }
-    auto cid_bytes = maybe_cid_bytes.value();
-    cid_bytes.insert(cid_bytes.begin(), 0);
-
-    std::array<uint8_t, 9> encoded{0};
-    CborEncoder encoder;
-    cbor_encoder_init(&encoder, encoded.data(), encoded.size(), 0);
-    cbor_encode_tag(&encoder, kExtraCid);
-    data_.insert(data_.end(),
-                 encoded.begin(),
-                 encoded.begin()
-                     + cbor_encoder_get_buffer_size(&encoder, encoded.data()));
-    *this << cid_bytes;
+    const auto &cid_bytes = maybe_cid_bytes.value();
+    addCount(1);
+    writeHead(data_, kTag, kExtraCid);
+    // multibase identity prefix
+    writeHead(data_, kBytes, 1 + cid_bytes.size());
+    data_.push_back(0);
+    data_.insert(data_.end(), cid_bytes.begin(), cid_bytes.end());
     return *this;
   }
 
   CborEncodeStream &CborEncodeStream::operator<<(
       const CborEncodeStream &other) {
     addCount(other.is_list_ ? 1 : other.count_);
-    auto other_data = other.data();
-    data_.insert(data_.end(), other_data.begin(), other_data.end());
+    writeStream(data_, other);
     return *this;
   }
 
-  struct LessCborKey {
-    bool operator()(const std::vector<uint8_t> &lhs,
-                    const std::vector<uint8_t> &rhs) const {
-      ssize_t diff = lhs.size() - rhs.size();
-      if (diff != 0) {
-        return diff < 0;
-      }
-      return std::memcmp(lhs.data(), rhs.data(), lhs.size()) < 0;
-    }
-  };
-
   CborEncodeStream &CborEncodeStream::operator<<(
       const std::map<std::string, CborEncodeStream> &map) {
     addCount(1);
-
-    std::array<uint8_t, 9> prefix{0};
-    CborEncoder encoder;
-    CborEncoder container;
-    cbor_encoder_init(&encoder, prefix.data(), prefix.size(), 0);
-    cbor_encoder_create_map(&encoder, &container, map.size());
-    data_.insert(data_.end(),
-                 prefix.begin(),
-                 prefix.begin()
-                     + cbor_encoder_get_buffer_size(&container, prefix.data()));
-
-    std::map<std::vector<uint8_t>, std::vector<uint8_t>, LessCborKey> sorted;
-    for (const auto &pair : map) {
-      if (pair.second.count_ != 1) {
+    writeHead(data_, kMap, map.size());
+
+    // canonical order, shorter encoded keys first, then bytewise
+    std::vector<std::map<std::string, CborEncodeStream>::const_iterator>
+        sorted;
+    sorted.reserve(map.size());
+    for (auto it{map.begin()}; it != map.end(); ++it) {
+      if (it->second.count_ != 1) {
         outcome::raise(CborEncodeError::kExpectedMapValueSingle);
       }
-      sorted.insert(std::make_pair((CborEncodeStream() << pair.first).data(),
-                                   pair.second.data()));
+      sorted.push_back(it);
     }
-    for (const auto &pair : sorted) {
-      data_.insert(data_.end(), pair.first.begin(), pair.first.end());
-      data_.insert(data_.end(), pair.second.begin(), pair.second.end());
+    std::sort(sorted.begin(), sorted.end(), [](auto &lhs, auto &rhs) {
+      auto &l{lhs->first};
+      auto &r{rhs->first};
+      if (l.size() != r.size()) {
+        return l.size() < r.size();
+      }
+      return std::memcmp(l.data(), r.data(), l.size()) < 0;
+    });
+    for (auto &it : sorted) {
+      writeHead(data_, kText, it->first.size());
+      data_.insert(data_.end(), it->first.begin(), it->first.end());
+      writeStream(data_, it->second);
     }
 
     return *this;
@@ -113,33 +87,46 @@ namespace fc::codec::cbor {
 
   CborEncodeStream &CborEncodeStream::operator<<(std::nullptr_t) {
     addCount(1);
-
-    std::array<uint8_t, 1> prefix{0};
-    CborEncoder encoder;
-    cbor_encoder_init(&encoder, prefix.data(), prefix.size(), 0);
-    cbor_encode_null(&encoder);
-    data_.insert(
-        data_.end(),
-        prefix.begin(),
-        prefix.begin() + cbor_encoder_get_buffer_size(&encoder, prefix.data()));
+    writeHead(data_, kSimple, kExtraNull);
     return *this;
   }
 
-  std::vector<uint8_t> CborEncodeStream::data() const {
+  std::vector<uint8_t> CborEncodeStream::data() const & {
+    std::vector<uint8_t> result;
+    result.reserve(9 + data_.size());
+    writeStream(result, *this);
+    return result;
+  }
+
+  std::vector<uint8_t> CborEncodeStream::data() && {
     if (!is_list_) {
-      return data_;
+      return std::move(data_);
     }
-    std::array<uint8_t, 9> prefix{0};
-    CborEncoder encoder;
-    CborEncoder container;
-    cbor_encoder_init(&encoder, prefix.data(), prefix.size(), 0);
-    cbor_encoder_create_array(&encoder, &container, count_);
-    std::vector<uint8_t> result(
-        prefix.begin(),
-        prefix.begin()
-            + cbor_encoder_get_buffer_size(&container, prefix.data()));
-    result.insert(result.end(), data_.begin(), data_.end());
-    return result;
+    return data();
+  }
+
+  void CborEncodeStream::reserve(size_t size) {
+    data_.reserve(size);
+  }
+
+  CborEncodeStream::Tuple CborEncodeStream::beginTuple(size_t count) {
+    Tuple tuple{data_.size(), count, count_};
+    writeHead(data_, kList, count);
+    count_ = 0;
+    return tuple;
+  }
+
+  void CborEncodeStream::endTuple(const Tuple &tuple) {
+    if (count_ != tuple.count) {
+      std::vector<uint8_t> expected, actual;
+      writeHead(expected, kList, tuple.count);
+      writeHead(actual, kList, count_);
+      auto head{data_.begin() + tuple.head};
+      head = data_.erase(head, head + expected.size());
+      data_.insert(head, actual.begin(), actual.end());
+    }
+    count_ = tuple.outer_count;
+    addCount(1);
   }
 
   CborEncodeStream CborEncodeStream::list() {
@@ -160,6 +147,42 @@ namespace fc::codec::cbor {
     return s;
   }
 
+  void CborEncodeStream::writeHead(std::vector<uint8_t> &out,
+                                   uint8_t major,
+                                   uint64_t value) {
+    uint8_t type = major << 5;
+    if (value < kExtraUint8) {
+      out.push_back(type | value);
+      return;
+    }
+    size_t bytes{};
+    if (value <= UINT8_MAX) {
+      out.push_back(type | kExtraUint8);
+      bytes = 1;
+    } else if (value <= UINT16_MAX) {
+      out.push_back(type | kExtraUint16);
+      bytes = 2;
+    } else if (value <= UINT32_MAX) {
+      out.push_back(type | kExtraUint32);
+      bytes = 4;
+    } else {
+      out.push_back(type | kExtraUint64);
+      bytes = 8;
+    }
+    // big-endian
+    for (auto i{bytes}; i != 0; --i) {
+      out.push_back(static_cast<uint8_t>(value >> (8 * (i - 1))));
+    }
+  }
+
+  void CborEncodeStream::writeStream(std::vector<uint8_t> &out,
+                                     const CborEncodeStream &other) {
+    if (other.is_list_) {
+      writeHead(out, kList, other.count_);
+    }
+    out.insert(out.end(), other.data_.begin(), other.data_.end());
+  }
+
   void CborEncodeStream::addCount(size_t count) {
     count_ += count;
   }
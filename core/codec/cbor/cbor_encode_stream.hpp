@@ -23,6 +23,13 @@ namespace fc::codec::cbor {
    public:
     static constexpr auto is_cbor_encoder_stream = true;
 
+    /** List encoded in place, see `beginTuple` */
+    struct Tuple {
+      size_t head;
+      size_t count;
+      size_t outer_count;
+    };
+
     /** Encodes integer or bool */
     template <
         typename T,
@@ -32,20 +39,19 @@ namespace fc::codec::cbor {
         return *this << common::to_int(num);
       }
       addCount(1);
-      std::array<uint8_t, 9> buffer{0};
-      CborEncoder encoder;
-      cbor_encoder_init(&encoder, buffer.data(), buffer.size(), 0);
       if constexpr (std::is_same_v<T, bool>) {
-        cbor_encode_boolean(&encoder, num);
+        writeHead(data_, kSimple, num ? kExtraTrue : kExtraFalse);
       } else if constexpr (std::is_unsigned_v<T>) {
-        cbor_encode_uint(&encoder, static_cast<uint64_t>(num));
+        writeHead(data_, kUint, static_cast<uint64_t>(num));
       } else {
-        cbor_encode_int(&encoder, static_cast<int64_t>(num));
+        auto num64{static_cast<int64_t>(num)};
+        if (num64 < 0) {
+          // -1 - n, as unsigned
+          writeHead(data_, kNint, ~static_cast<uint64_t>(num64));
+        } else {
+          writeHead(data_, kUint, static_cast<uint64_t>(num64));
+        }
       }
-      data_.insert(data_.end(),
-                   buffer.begin(),
-                   buffer.begin()
-                       + cbor_encoder_get_buffer_size(&encoder, buffer.data()));
       return *this;
     }
 
@@ -108,7 +114,19 @@ namespace fc::codec::cbor {
     /** Encodes null */
     CborEncodeStream &operator<<(std::nullptr_t);
     /** Returns CBOR bytes of encoded elements */
-    std::vector<uint8_t> data() const;
+    std::vector<uint8_t> data() const &;
+    /** Returns CBOR bytes of encoded elements, without copy if possible */
+    std::vector<uint8_t> data() &&;
+    /** Reserves space for encoded elements */
+    void reserve(size_t size);
+    /**
+     * Begins list of `count` elements encoded in place, elements are written
+     * directly after list head instead of into substream
+     */
+    Tuple beginTuple(size_t count);
+    /** Ends list, rewrites list head if elements count differs from expected
+     */
+    void endTuple(const Tuple &tuple);
     /** Creates list container encode substream */
     static CborEncodeStream list();
     /** Creates map container encode substream map */
@@ -117,6 +135,23 @@ namespace fc::codec::cbor {
     static CborEncodeStream wrap(gsl::span<const uint8_t> data, size_t count);
 
    private:
+    /// Major types
+    static constexpr uint8_t kUint{0};
+    static constexpr uint8_t kNint{1};
+    static constexpr uint8_t kBytes{2};
+    static constexpr uint8_t kText{3};
+    static constexpr uint8_t kList{4};
+    static constexpr uint8_t kMap{5};
+    static constexpr uint8_t kTag{6};
+    static constexpr uint8_t kSimple{7};
+
+    /** Writes shortest head of major type with argument */
+    static void writeHead(std::vector<uint8_t> &out,
+                          uint8_t major,
+                          uint64_t value);
+    /** Writes list head if needed and elements of other stream */
+    static void writeStream(std::vector<uint8_t> &out,
+                            const CborEncodeStream &other);
     void addCount(size_t count);
 
     bool is_list_{false};
@@ -90,13 +90,17 @@ namespace fc::codec::cbor::light_reader {
       if (!read(token, node).listCount()) {
         return false;
       }
-      for (auto links{*token.listCount()}; links; --links) {
+      auto links{*token.listCount()};
+      for (auto i{links}; i; --i) {
         const Hash256 *cid;
         if (!cbor::readCborBlake(cid, node)) {
           return false;
         }
         cids.push_back(*cid);
       }
+      if (links != 0) {
+        ipld->prefetch(gsl::make_span(cids).last(links));
+      }
       if (!read(token, node).listCount()) {
         return false;
       }
@@ -48,6 +48,11 @@ namespace fc::codec::cbor::light_reader {
           return true;
         }
         if (node.empty()) {
+          if (prefetched < cids.size()) {
+            // children of parsed nodes, root is read right away
+            ipld->prefetch(gsl::make_span(cids).subspan(prefetched));
+            prefetched = cids.size();
+          }
           if (ipld->get(cids[next_cid++], _node)) {
             node = _node;
             if (read(token, node).listCount() != 2) {
@@ -105,6 +110,8 @@ namespace fc::codec::cbor::light_reader {
     LightIpldPtr ipld;
     std::vector<Hash256> cids;
     size_t next_cid{};
+    /** CIDs before this are already prefetched */
+    size_t prefetched{1};
     Buffer _node;
     BytesIn node;
     size_t _bucket{};
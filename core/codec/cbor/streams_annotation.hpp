@@ -117,9 +117,40 @@
                 _CBOR_TUPLE_1)  \
   (op, __VA_ARGS__)
 
-#define CBOR_ENCODE_TUPLE(T, ...)                        \
-  CBOR_ENCODE(T, t) {                                    \
-    return s << (s.list() _CBOR_TUPLE(<<, __VA_ARGS__)); \
+#define _CBOR_TUPLE_COUNT(...) \
+  _CBOR_TUPLE_V(__VA_ARGS__,   \
+                21,            \
+                20,            \
+                19,            \
+                18,            \
+                17,            \
+                16,            \
+                15,            \
+                14,            \
+                13,            \
+                12,            \
+                11,            \
+                10,            \
+                9,             \
+                8,             \
+                7,             \
+                6,             \
+                5,             \
+                4,             \
+                3,             \
+                2,             \
+                1)
+
+/**
+ * Encodes fields in place of stream, list head for known field count is
+ * written before fields, without intermediate list substream.
+ */
+#define CBOR_ENCODE_TUPLE(T, ...)                             \
+  CBOR_ENCODE(T, t) {                                         \
+    auto tuple{s.beginTuple(_CBOR_TUPLE_COUNT(__VA_ARGS__))}; \
+    s _CBOR_TUPLE(<<, __VA_ARGS__);                           \
+    s.endTuple(tuple);                                        \
+    return s;                                                 \
   }
 
 #define CBOR_TUPLE(T, ...)                 \
@@ -44,6 +44,69 @@ namespace fc::codec::json {
     return format(&doc);
   }
 
+  ChunkFormatter::ChunkFormatter(JIn j) : pending_{j} {}
+
+  Outcome<bool> ChunkFormatter::next(Buffer &chunk, size_t limit) {
+    chunk.clear();
+    StringBuffer buffer;
+    rapidjson::Writer<StringBuffer> writer;
+    auto scalar{[&](JIn j) {
+      buffer.Clear();
+      writer.Reset(buffer);
+      if (!j->Accept(writer)) {
+        return false;
+      }
+      chunk.put(std::string_view{buffer.GetString(), buffer.GetSize()});
+      return true;
+    }};
+    while (chunk.size() < limit) {
+      if (pending_) {
+        auto j{pending_};
+        pending_ = nullptr;
+        if (j->IsArray()) {
+          chunk.put("[");
+          levels_.push_back({j, 0});
+        } else if (j->IsObject()) {
+          chunk.put("{");
+          levels_.push_back({j, 0});
+        } else if (!scalar(j)) {
+          return {};
+        }
+        continue;
+      }
+      if (levels_.empty()) {
+        break;
+      }
+      auto &level{levels_.back()};
+      if (level.j->IsArray()) {
+        if (level.i < level.j->Size()) {
+          if (level.i != 0) {
+            chunk.put(",");
+          }
+          pending_ = &(*level.j)[level.i++];
+          continue;
+        }
+        chunk.put("]");
+      } else {
+        if (level.i < level.j->MemberCount()) {
+          if (level.i != 0) {
+            chunk.put(",");
+          }
+          auto member{level.j->MemberBegin() + level.i++};
+          if (!scalar(&member->name)) {
+            return {};
+          }
+          chunk.put(":");
+          pending_ = &member->value;
+          continue;
+        }
+        chunk.put("}");
+      }
+      levels_.pop_back();
+    }
+    return !pending_ && levels_.empty();
+  }
+
   Outcome<JIn> jGet(JIn j, std::string_view key) {
     if (j->IsObject()) {
       auto it{j->FindMember(key.data())};
@@ -25,6 +25,33 @@ namespace fc::codec::json {
   Outcome<Buffer> format(JIn j);
   Outcome<Buffer> format(Document &&doc);
 
+  /**
+   * Formats JSON value chunk by chunk.
+   * Next chunk is formatted only when requested, so formatted text of large
+   * value is not held in memory at once.
+   */
+  class ChunkFormatter {
+   public:
+    /** Value must outlive formatter */
+    explicit ChunkFormatter(JIn j);
+
+    /**
+     * Formats next chunk of at least `limit` bytes, unless value ends.
+     * Chunk may exceed `limit` by one scalar value.
+     * @return true if value was formatted completely
+     */
+    Outcome<bool> next(Buffer &chunk, size_t limit);
+
+   private:
+    struct Level {
+      JIn j;
+      rapidjson::SizeType i;
+    };
+
+    JIn pending_;
+    std::vector<Level> levels_;
+  };
+
   Outcome<JIn> jGet(JIn j, std::string_view key);
 
   Outcome<std::string_view> jStr(JIn j);
@@ -0,0 +1,64 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <spdlog/fmt/fmt.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+namespace fc::common {
+  /** Prints time elapsed since construction when destroyed */
+  struct BenchTimer {
+    BenchTimer(std::string name, uint64_t count, bool bytes)
+        : name{std::move(name)}, count{count}, bytes{bytes} {}
+
+    ~BenchTimer() {
+      auto ns{std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now() - begin)
+                  .count()};
+      if (bytes) {
+        fmt::print("{}: {} ms, {:.3f} GB/s\n",
+                   name,
+                   ns / 1000000,
+                   double(count) / std::max<int64_t>(1, ns));
+      } else {
+        fmt::print("{}: {} ms, {} ns/op\n",
+                   name,
+                   ns / 1000000,
+                   ns / std::max<uint64_t>(1, count));
+      }
+    }
+
+    std::string name;
+    uint64_t count;
+    bool bytes;
+    std::chrono::steady_clock::time_point begin{
+        std::chrono::steady_clock::now()};
+  };
+
+  /**
+   * Runs `f` once, prints elapsed time per operation.
+   * @param count - operations done by `f`
+   * @return result of `f`
+   */
+  template <typename F>
+  auto bench(const std::string &name, uint64_t count, const F &f) {
+    BenchTimer timer{name, count, false};
+    return f();
+  }
+
+  /**
+   * Runs `f` once, prints throughput.
+   * @param bytes - bytes processed by `f`
+   * @return result of `f`
+   */
+  template <typename F>
+  auto benchBytes(const std::string &name, uint64_t bytes, const F &f) {
+    BenchTimer timer{name, bytes, true};
+    return f();
+  }
+}  // namespace fc::common
@@ -241,9 +241,7 @@ namespace fc::common {
    * @return reference to stream
    */
   CBOR_DECODE(Buffer, buffer) {
-    std::vector<uint8_t> data;
-    s >> data;
-    buffer.put(data);
+    s >> buffer.toVector();
     return s;
   }
 
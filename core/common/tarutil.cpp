@@ -6,6 +6,7 @@
 #include "common/tarutil.hpp"
 
 #include <fcntl.h>
+#include <functional>
 #include <libarchive/archive.h>
 #include <libarchive/archive_entry.h>
 #include <boost/filesystem.hpp>
@@ -135,8 +136,10 @@ namespace fc::common {
     return outcome::success();
   }
 
-  outcome::result<void> extractTar(const boost::filesystem::path &tar_path,
-                                   const boost::filesystem::path &output_path) {
+  /** Extracts archive opened for reading by `open` */
+  outcome::result<void> extractTarOpened(
+      const std::function<int(struct archive *)> &open,
+      const boost::filesystem::path &output_path) {
     if (!fs::exists(output_path)) {
       boost::system::error_code ec;
       if (!fs::create_directories(output_path, ec)) {
@@ -162,9 +165,7 @@ namespace fc::common {
     auto ext = ffi::wrap(archive_write_disk_new(), archive_write_free);
     archive_write_disk_set_options(ext.get(), flags);
     archive_write_disk_set_standard_lookup(ext.get());
-    if (archive_read_open_filename(
-            archive.get(), tar_path.c_str(), kTarBlockSize)
-        != ARCHIVE_OK) {
+    if (open(archive.get()) != ARCHIVE_OK) {
       logger->error("Extract tar: {}", archive_error_string(archive.get()));
       return TarErrors::kCannotUntarArchive;
     }
@@ -216,6 +217,25 @@ namespace fc::common {
     return outcome::success();
   }
 
+  outcome::result<void> extractTar(const boost::filesystem::path &tar_path,
+                                   const boost::filesystem::path &output_path) {
+    return extractTarOpened(
+        [&](struct archive *archive) {
+          return archive_read_open_filename(
+              archive, tar_path.c_str(), kTarBlockSize);
+        },
+        output_path);
+  }
+
+  outcome::result<void> extractTar(int fd,
+                                   const boost::filesystem::path &output_path) {
+    return extractTarOpened(
+        [&](struct archive *archive) {
+          return archive_read_open_fd(archive, fd, kTarBlockSize);
+        },
+        output_path);
+  }
+
 }  // namespace fc::common
 
 OUTCOME_CPP_DEFINE_CATEGORY(fc::common, TarErrors, e) {
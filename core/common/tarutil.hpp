@@ -19,6 +19,14 @@ namespace fc::common {
   outcome::result<void> extractTar(const boost::filesystem::path &tar_path,
                                    const boost::filesystem::path &output_path);
 
+  /**
+   * Extracts tar while reading it from file descriptor, e.g. pipe or socket,
+   * so archive is not stored before extraction.
+   * Descriptor is not closed.
+   */
+  outcome::result<void> extractTar(int fd,
+                                   const boost::filesystem::path &output_path);
+
   enum class TarErrors {
     kCannotCreateDir = 1,
     kCannotUntarArchive,
@@ -58,5 +58,21 @@ namespace fc::crypto::bls {
      */
     virtual outcome::result<Signature> aggregateSignatures(
         gsl::span<const Signature> signatures) const = 0;
+
+    /**
+     * @brief Verify aggregated BLS signature of distinct messages
+     * @param aggregate - messages, their public keys and aggregated signature
+     * @return signature status or error code
+     */
+    virtual outcome::result<bool> verifyAggregateSignature(
+        const Aggregate &aggregate) const = 0;
+
+    /**
+     * @brief Verify several aggregated BLS signatures in one batch
+     * @param aggregates - aggregates to verify, e.g. of tipset blocks
+     * @return true if all signatures are valid, or error code
+     */
+    virtual outcome::result<bool> verifyAggregateSignatures(
+        gsl::span<const Aggregate> aggregates) const = 0;
   };
 }  // namespace fc::crypto::bls
@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <gsl/span>
+#include <vector>
+
 #include "common/blob.hpp"
 #include "common/outcome.hpp"
 
@@ -25,6 +28,13 @@ namespace fc::crypto::bls {
     PublicKey public_key;
   };
 
+  /// Messages signed by corresponding keys, and sum of their signatures
+  struct Aggregate {
+    std::vector<gsl::span<const uint8_t>> messages;
+    std::vector<PublicKey> keys;
+    Signature signature;
+  };
+
   enum class Errors {
     kInternalError = 1,
     kKeyPairGenerationFailed,
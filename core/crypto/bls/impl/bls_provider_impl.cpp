@@ -5,6 +5,9 @@
 
 #include "crypto/bls/impl/bls_provider_impl.hpp"
 
+#include <atomic>
+#include <boost/asio/post.hpp>
+#include <condition_variable>
 #include <filecoin-ffi/filcrypto.h>
 
 #include "common/ffi.hpp"
@@ -13,6 +16,13 @@
 namespace fc::crypto::bls {
   namespace ffi = common::ffi;
 
+  BlsProviderImpl::BlsProviderImpl(size_t threads)
+      : threads_{std::max<size_t>(1, threads)} {
+    if (threads_ > 1) {
+      pool_ = std::make_unique<boost::asio::thread_pool>(threads_ - 1);
+    }
+  }
+
   outcome::result<KeyPair> BlsProviderImpl::generateKeyPair() const {
     auto response{ffi::wrap(fil_private_key_generate(),
                             fil_destroy_private_key_generate_response)};
@@ -86,6 +96,87 @@ namespace fc::crypto::bls {
     }
     return ffi::array(response->signature.inner);
   }
+
+  outcome::result<bool> BlsProviderImpl::verifyAggregateSignature(
+      const Aggregate &aggregate) const {
+    return verifyAggregateSignatures(gsl::make_span(&aggregate, 1));
+  }
+
+  outcome::result<bool> BlsProviderImpl::verifyAggregateSignatures(
+      gsl::span<const Aggregate> aggregates) const {
+    // messages of all aggregates are hashed together to load all threads
+    std::vector<size_t> offsets;
+    std::vector<gsl::span<const uint8_t>> messages;
+    for (const auto &aggregate : aggregates) {
+      if (aggregate.messages.size() != aggregate.keys.size()) {
+        return false;
+      }
+      offsets.push_back(messages.size());
+      messages.insert(messages.end(),
+                      aggregate.messages.begin(),
+                      aggregate.messages.end());
+    }
+    std::vector<Digest> digests(messages.size());
+    std::atomic_bool hashed{true};
+    parallel(messages.size(), [&](size_t i) {
+      if (auto digest{generateHash(messages[i])}) {
+        digests[i] = digest.value();
+      } else {
+        hashed = false;
+      }
+    });
+    if (!hashed) {
+      return Errors::kInternalError;
+    }
+    std::atomic_bool valid{true};
+    parallel(aggregates.size(), [&](size_t i) {
+      const auto &aggregate{aggregates[i]};
+      if (aggregate.messages.empty()) {
+        return;
+      }
+      auto digests_i{common::span::cast<const uint8_t>(
+          gsl::make_span(digests).subspan(offsets[i],
+                                          aggregate.messages.size()))};
+      auto keys_i{common::span::cast<const uint8_t>(
+          gsl::make_span(aggregate.keys))};
+      if (fil_verify(aggregate.signature.data(),
+                     digests_i.data(),
+                     digests_i.size(),
+                     keys_i.data(),
+                     keys_i.size())
+          <= 0) {
+        valid = false;
+      }
+    });
+    return valid;
+  }
+
+  void BlsProviderImpl::parallel(
+      size_t count, const std::function<void(size_t)> &f) const {
+    std::atomic_size_t next{0};
+    auto work{[&] {
+      for (size_t i{}; (i = next++) < count;) {
+        f(i);
+      }
+    }};
+    // calling thread works too, so calls don't wait for busy pool
+    std::mutex mutex;
+    std::condition_variable cv;
+    auto jobs{pool_ && count > 1 ? std::min(threads_, count) - 1 : 0};
+    size_t running{jobs};
+    for (size_t t{0}; t < jobs; ++t) {
+      boost::asio::post(*pool_, [&] {
+        work();
+        std::lock_guard lock{mutex};
+        if (--running == 0) {
+          cv.notify_one();
+        }
+      });
+    }
+    work();
+    std::unique_lock lock{mutex};
+    cv.wait(lock, [&] { return running == 0; });
+  }
 }  // namespace fc::crypto::bls
 
 OUTCOME_CPP_DEFINE_CATEGORY(fc::crypto::bls, Errors, e) {
@@ -5,11 +5,17 @@
 
 #pragma once
 
+#include <boost/asio/thread_pool.hpp>
+#include <functional>
+
 #include "crypto/bls/bls_provider.hpp"
 
 namespace fc::crypto::bls {
   class BlsProviderImpl : public BlsProvider {
    public:
+    /// @param threads - threads to hash messages and verify aggregates with
+    explicit BlsProviderImpl(size_t threads = 1);
+
     outcome::result<KeyPair> generateKeyPair() const override;
 
     outcome::result<PublicKey> derivePublicKey(
@@ -25,6 +31,12 @@ namespace fc::crypto::bls {
     outcome::result<Signature> aggregateSignatures(
         gsl::span<const Signature> signatures) const override;
 
+    outcome::result<bool> verifyAggregateSignature(
+        const Aggregate &aggregate) const override;
+
+    outcome::result<bool> verifyAggregateSignatures(
+        gsl::span<const Aggregate> aggregates) const override;
+
    private:
     /**
      * @brief Generate BLS message digest
@@ -33,5 +45,12 @@ namespace fc::crypto::bls {
      */
     static outcome::result<Digest> generateHash(
         gsl::span<const uint8_t> message);
+
+    /// Runs `f(i)` for each `i < count` on calling thread and pool threads
+    void parallel(size_t count, const std::function<void(size_t)> &f) const;
+
+    size_t threads_;
+    /// Threads besides calling one, none if single thread
+    std::unique_ptr<boost::asio::thread_pool> pool_;
   };
 }  // namespace fc::crypto::bls
@@ -14,6 +14,7 @@
 namespace boost {
   namespace asio {
     class io_context;
+    class thread_pool;
   }  // namespace asio
 }  // namespace boost
 
@@ -160,6 +161,7 @@ namespace fc {
       class Interpreter;
       struct InterpreterCache;
       class InterpreterImpl;
+      class InterpreterPipeline;
     }  // namespace interpreter
 
     namespace message {
@@ -29,20 +29,15 @@ namespace fc::markets::pieceio {
       return PieceIOError::kFileNotExist;
     }
 
-    auto copy_path = temp_dir_ / fs::unique_path();
-
-    fs::copy_file(path, copy_path);
-
-    auto _ = gsl::finally([&copy_path]() { fs::remove_all(copy_path); });
-
-    auto padded_size{proofs::padPiece(copy_path)};
+    // commitment is computed over zero padded tail, file is not modified
+    auto padded_size{primitives::piece::paddedSize(fs::file_size(path))};
 
     static auto proofs{std::make_shared<proofs::ProofEngineImpl>()};
 
-    OUTCOME_TRY(
-        commitment,
-        proofs->generatePieceCID(
-            registered_proof, PieceData(copy_path.string()), padded_size));
+    OUTCOME_TRY(commitment,
+                proofs->generatePieceCID(registered_proof,
+                                         PieceData(path.string(), O_RDONLY),
+                                         padded_size));
 
     return {commitment, padded_size};
   }
@@ -7,10 +7,10 @@
 
 #include <boost/filesystem.hpp>
 
+#include "common/error_text.hpp"
 #include "common/libp2p/peer/peer_info_helper.hpp"
 #include "markets/common.hpp"
 #include "markets/storage/types.hpp"
-#include "storage/car/car.hpp"
 #include "storage/piece/impl/piece_storage_error.hpp"
 
 namespace fc::markets::retrieval::provider {
@@ -19,12 +19,14 @@ namespace fc::markets::retrieval::provider {
   using storage::kStorageMarketImportDir;
   namespace fs = boost::filesystem;
 
+  /// Subdirectory of import dir with cached unsealed piece cars
+  const std::string kUnsealedDir{"unsealed"};
+
   RetrievalProviderImpl::RetrievalProviderImpl(
       std::shared_ptr<Host> host,
       std::shared_ptr<DataTransfer> datatransfer,
       std::shared_ptr<api::FullNodeApi> api,
       std::shared_ptr<PieceStorage> piece_storage,
-      std::shared_ptr<Ipld> ipld,
       std::shared_ptr<OneKey> config_key,
       std::shared_ptr<Manager> sealer,
       std::shared_ptr<Miner> miner)
@@ -32,7 +34,6 @@ namespace fc::markets::retrieval::provider {
         datatransfer_{std::move(datatransfer)},
         api_{std::move(api)},
         piece_storage_{std::move(piece_storage)},
-        ipld_{std::move(ipld)},
         config_key_{std::move(config_key)},
         config_{
             kDefaultPricePerByte,
@@ -95,7 +96,7 @@ namespace fc::markets::retrieval::provider {
       return reject(DealStatus::kDealStatusFailed, "Payload not found");
     }
 
-    auto deal{std::make_shared<DealState>(ipld_, pdtid, pgsid, proposal)};
+    auto deal{std::make_shared<DealState>(pdtid, pgsid, proposal)};
     auto &unseal{deal->state.owed};
 
     datatransfer_->acceptPull(
@@ -149,10 +150,10 @@ namespace fc::markets::retrieval::provider {
       return;
     }
 
-    if (!deal->unsealed) {
+    if (!deal->traverser) {
       return doUnseal(deal);
     }
-    if (!deal->traverser.isCompleted()) {
+    if (!deal->traverser->isCompleted()) {
       return doBlocks(deal);
     }
     doComplete(deal);
@@ -167,31 +168,15 @@ namespace fc::markets::retrieval::provider {
     if (!_piece) {
       return doFail(deal, _piece.error().message());
     }
-    if (!fs::exists(kStorageMarketImportDir)) {
-      fs::create_directories(kStorageMarketImportDir);
-    }
-    const auto car_path = kStorageMarketImportDir / fs::unique_path();
-    auto _ = gsl::finally([&car_path]() {
-      if (fs::exists(car_path)) {
-        fs::remove_all(car_path);
-      }
-    });
-    for (auto &info : _piece.value().deals) {
-      if (auto _error{unsealSector(info.sector_id,
-                                   info.offset.unpadded(),
-                                   info.length.unpadded(),
-                                   car_path.string())}) {
-        assert(info.length.unpadded() == fs::file_size(car_path));
-        auto _load{::fc::storage::car::loadCar(*ipld_, car_path.string())};
-        if (!_load) {
-          return doFail(deal, _load.error().message());
-        }
-        deal->unsealed = true;
-        doBlocks(deal);
-        return;
-      }
+    auto _ipld{unsealedPiece(_piece.value())};
+    if (!_ipld) {
+      return doFail(deal, _ipld.error().message());
     }
-    doFail(deal, "unsealing all failed");
+    deal->ipld = _ipld.value();
+    deal->traverser.emplace(*deal->ipld,
+                            deal->proposal.payload_cid,
+                            deal->proposal.params.selector);
+    doBlocks(deal);
   }
 
   void RetrievalProviderImpl::doBlocks(std::shared_ptr<DealState> deal) {
@@ -199,12 +184,12 @@ namespace fc::markets::retrieval::provider {
       return;
     }
     while (true) {
-      auto _cid{deal->traverser.advance()};
+      auto _cid{deal->traverser->advance()};
       if (!_cid) {
         return doFail(deal, _cid.error().message());
       }
       auto &cid{_cid.value()};
-      auto _data{ipld_->get(cid)};
+      auto _data{deal->ipld->get(cid)};
       if (!_data) {
         return doFail(deal, _data.error().message());
       }
@@ -215,7 +200,7 @@ namespace fc::markets::retrieval::provider {
                                        {},
                                        {{std::move(cid), std::move(data)}}});
 
-      if (deal->traverser.isCompleted()) {
+      if (deal->traverser->isCompleted()) {
         return doComplete(deal);
       }
 
@@ -266,8 +251,8 @@ namespace fc::markets::retrieval::provider {
              deal->pdtid.id,
              CborRaw{codec::cbor::encode(
                          DealResponse::Named{{
-                             deal->unsealed
-                                 ? deal->traverser.isCompleted()
+                             deal->traverser
+                                 ? deal->traverser->isCompleted()
                                        ? DealStatus::
                                            kDealStatusFundsNeededLastPayment
                                        : DealStatus::kDealStatusFundsNeeded
@@ -299,6 +284,9 @@ namespace fc::markets::retrieval::provider {
   }
 
   void RetrievalProviderImpl::start() {
+    // cache index is not persisted, drop cars of previous run
+    boost::system::error_code ec;
+    fs::remove_all(kStorageMarketImportDir / kUnsealedDir, ec);
     host_->setProtocolHandler(
         kQueryProtocolId, [_self{weak_from_this()}](auto stream) {
           auto self{_self.lock()};
@@ -411,4 +399,53 @@ namespace fc::markets::retrieval::provider {
         comm_d);
   }
 
+  outcome::result<std::shared_ptr<CarIpld>>
+  RetrievalProviderImpl::unsealedPiece(const PieceInfo &piece) {
+    for (auto it{unsealed_.begin()}; it != unsealed_.end(); ++it) {
+      if (it->first == piece.piece_cid) {
+        unsealed_.splice(unsealed_.begin(), unsealed_, it);
+        return it->second;
+      }
+    }
+    const auto dir{kStorageMarketImportDir / kUnsealedDir};
+    if (!fs::exists(dir)) {
+      fs::create_directories(dir);
+    }
+    OUTCOME_TRY(name, piece.piece_cid.toString());
+    const auto car_path{dir / (name + ".car")};
+    const auto tmp_path{dir / (name + ".tmp")};
+    boost::system::error_code ec;
+    for (auto &info : piece.deals) {
+      fs::remove(tmp_path, ec);
+      if (!unsealSector(info.sector_id,
+                        info.offset.unpadded(),
+                        info.length.unpadded(),
+                        tmp_path.string())) {
+        continue;
+      }
+      assert(info.length.unpadded() == fs::file_size(tmp_path));
+      fs::rename(tmp_path, car_path, ec);
+      if (ec) {
+        auto error{ec};
+        fs::remove(tmp_path, ec);
+        return error;
+      }
+      auto _ipld{CarIpld::open(car_path.string())};
+      if (!_ipld) {
+        fs::remove(car_path, ec);
+        return _ipld.error();
+      }
+      auto &ipld{_ipld.value()};
+      unsealed_.emplace_front(piece.piece_cid, ipld);
+      if (unsealed_.size() > kUnsealedCacheSize) {
+        // deals still serving evicted piece keep its mapping
+        OUTCOME_TRY(evicted, unsealed_.back().first.toString());
+        fs::remove(dir / (evicted + ".car"), ec);
+        unsealed_.pop_back();
+      }
+      return ipld;
+    }
+    fs::remove(tmp_path, ec);
+    return ERROR_TEXT("unsealing all failed");
+  }
 }  // namespace fc::markets::retrieval::provider
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <list>
+
 #include "api/full_node/node_api.hpp"
 #include "common/io_thread.hpp"
 #include "common/libp2p/cbor_stream.hpp"
@@ -14,6 +16,7 @@
 #include "markets/retrieval/protocols/retrieval_protocol.hpp"
 #include "markets/retrieval/provider/retrieval_provider.hpp"
 #include "miner/miner.hpp"
+#include "storage/car/car_ipld.hpp"
 #include "storage/ipld/traverser.hpp"
 #include "storage/leveldb/prefix.hpp"
 #include "storage/piece/piece_storage.hpp"
@@ -26,6 +29,7 @@ namespace fc::markets::retrieval::provider {
   using ::fc::miner::Miner;
   using ::fc::sector_storage::Manager;
   using ::fc::storage::OneKey;
+  using ::fc::storage::car::CarIpld;
   using ::fc::storage::ipld::traverser::Traverser;
   using ::fc::storage::piece::PieceInfo;
   using ::fc::storage::piece::PieceStorage;
@@ -36,23 +40,25 @@ namespace fc::markets::retrieval::provider {
   using primitives::piece::UnpaddedPieceSize;
   using GsResStatus = ::fc::storage::ipfs::graphsync::ResponseStatusCode;
 
+  /// Unsealed piece cars kept for repeated retrievals
+  constexpr size_t kUnsealedCacheSize{4};
+
   struct DealState {
-    DealState(std::shared_ptr<Ipld> ipld,
-              const PeerDtId &pdtid,
+    DealState(const PeerDtId &pdtid,
               const PeerGsId &pgsid,
               const DealProposal &proposal)
         : proposal{proposal},
           state{proposal.params},
           pdtid{pdtid},
-          pgsid{pgsid},
-          traverser{*ipld, proposal.payload_cid, proposal.params.selector} {}
+          pgsid{pgsid} {}
 
     DealProposal proposal;
     State state;
     PeerDtId pdtid;
     PeerGsId pgsid;
-    bool unsealed{false};
-    Traverser traverser;
+    /** Unsealed piece, set with traverser when unsealed */
+    IpldPtr ipld;
+    boost::optional<Traverser> traverser;
   };
 
   class RetrievalProviderImpl
@@ -63,7 +69,6 @@ namespace fc::markets::retrieval::provider {
                           std::shared_ptr<DataTransfer> datatransfer,
                           std::shared_ptr<api::FullNodeApi> api,
                           std::shared_ptr<PieceStorage> piece_storage,
-                          IpldPtr ipld,
                           std::shared_ptr<OneKey> config_key,
                           std::shared_ptr<Manager> sealer,
                           std::shared_ptr<Miner> miner);
@@ -81,6 +86,15 @@ namespace fc::markets::retrieval::provider {
     bool hasOwed(std::shared_ptr<DealState> deal);
     void doFail(std::shared_ptr<DealState> deal, std::string error);
 
+    /**
+     * Returns read-only ipld of unsealed piece car.
+     * Piece is unsealed once, its car file and block index are cached for
+     * following retrievals.
+     * @param piece - piece and deals containing it
+     */
+    outcome::result<std::shared_ptr<CarIpld>> unsealedPiece(
+        const PieceInfo &piece);
+
     void start() override;
 
     void setPricePerByte(TokenAmount amount) override;
@@ -126,12 +140,13 @@ namespace fc::markets::retrieval::provider {
     std::shared_ptr<DataTransfer> datatransfer_;
     std::shared_ptr<api::FullNodeApi> api_;
     std::shared_ptr<PieceStorage> piece_storage_;
-    std::shared_ptr<Ipld> ipld_;
     std::shared_ptr<OneKey> config_key_;
     RetrievalAsk config_;
     std::shared_ptr<Manager> sealer_;
     std::shared_ptr<Miner> miner_;
     common::Logger logger_ = common::createLogger("RetrievalProvider");
     IoThread io_;
+    /** Most recently used unsealed pieces first, accessed on `io_` */
+    std::list<std::pair<CID, std::shared_ptr<CarIpld>>> unsealed_;
   };
 }  // namespace fc::markets::retrieval::provider
@@ -7,6 +7,7 @@
 
 #include <libp2p/protocol/common/asio/asio_scheduler.hpp>
 #include "common/libp2p/peer/peer_info_helper.hpp"
+#include "common/span.hpp"
 #include "markets/storage/provider/storage_provider_error.hpp"
 #include "markets/storage/provider/stored_ask.hpp"
 #include "markets/storage/storage_datatransfer_voucher.hpp"
@@ -110,17 +111,33 @@ namespace fc::markets::storage::provider {
           if (auto _voucher2{
                   codec::cbor::decode<StorageDataTransferVoucher>(_voucher)}) {
             if (auto deal{getDealPtr(_voucher2.value().proposal_cid)}) {
-              return datatransfer_->acceptPush(
-                  pdtid, root, [this, deal](auto ok) {
+              // transfer may end before acceptPush returns
+              auto ended{std::make_shared<bool>(false)};
+              datatransfer_->acceptPush(
+                  pdtid, root, [this, deal, ended](auto ok) {
+                    *ended = true;
+                    if (!ok) {
+                      takeStagingCar(deal->proposal_cid);
+                    }
                     FSM_SEND(
                         deal,
                         ok ? ProviderEvent::ProviderEventDataTransferCompleted
                            : ProviderEvent::ProviderEventFailed);
                   });
+              if (!*ended) {
+                stageCar(deal);
+              }
+              return;
             }
           }
           datatransfer_->rejectPush(pdtid);
         });
+    blocks_connection_ = datatransfer_->gs->subscribe(
+        [weak{weak_from_this()}](auto &, auto &block) {
+          if (auto self{weak.lock()}) {
+            self->writeStagingCars(block);
+          }
+        });
 
     return outcome::success();
   }
@@ -175,16 +192,29 @@ namespace fc::markets::storage::provider {
       boost::filesystem::copy_file(
           path, car_path, boost::filesystem::copy_option::overwrite_if_exists);
 
+    return verifyDealData(deal, car_path, nullptr);
+  }
+
+  outcome::result<void> StorageProviderImpl::verifyDealData(
+      const std::shared_ptr<MinerDeal> &deal,
+      const boost::filesystem::path &car_path,
+      proofs::CommP *commp) {
     auto unpadded{proofs::padPiece(car_path)};
     if (unpadded.padded() != deal->client_deal_proposal.proposal.piece_size) {
       return StorageMarketProviderError::kPieceCIDDoesNotMatch;
     }
-    OUTCOME_TRY(registered_proof, api_->GetProofType(miner_actor_address_, {}));
-    OUTCOME_TRY(piece_commitment,
-                piece_io_->generatePieceCommitment(registered_proof, car_path));
+    CID piece_cid;
+    if (commp) {
+      OUTCOME_TRYA(piece_cid, commp->finish(unpadded));
+    } else {
+      OUTCOME_TRY(registered_proof,
+                  api_->GetProofType(miner_actor_address_, {}));
+      OUTCOME_TRY(piece_commitment,
+                  piece_io_->generatePieceCommitment(registered_proof, car_path));
+      piece_cid = piece_commitment.first;
+    }
 
-    if (piece_commitment.first
-        != deal->client_deal_proposal.proposal.piece_cid) {
+    if (piece_cid != deal->client_deal_proposal.proposal.piece_cid) {
       return StorageMarketProviderError::kPieceCIDDoesNotMatch;
     }
     deal->piece_path = car_path.string();
@@ -193,6 +223,66 @@ namespace fc::markets::storage::provider {
     return outcome::success();
   }
 
+  void StorageProviderImpl::stageCar(const std::shared_ptr<MinerDeal> &deal) {
+    auto cid_str{deal->ref.root.toString()};
+    if (!cid_str) {
+      return;
+    }
+    auto staging{std::make_shared<StagingCar>()};
+    staging->file.open((kStorageMarketImportDir / cid_str.value()).string(),
+                       std::ios::binary);
+    if (!staging->file.good()) {
+      return;
+    }
+    staging->writer.emplace(
+        *ipld_, deal->ref.root, [car{staging.get()}](BytesIn bytes) {
+          car->file.write(common::span::bytestr(bytes.data()), bytes.size());
+          car->commp.update(bytes);
+        });
+    std::lock_guard lock{staging_mutex_};
+    staging_[deal->proposal_cid] = std::move(staging);
+  }
+
+  std::shared_ptr<StorageProviderImpl::StagingCar>
+  StorageProviderImpl::takeStagingCar(const CID &proposal_cid) {
+    std::lock_guard lock{staging_mutex_};
+    auto it{staging_.find(proposal_cid)};
+    if (it == staging_.end()) {
+      return nullptr;
+    }
+    auto staging{std::move(it->second)};
+    staging_.erase(it);
+    return staging;
+  }
+
+  void StorageProviderImpl::writeStagingCars(
+      const fc::storage::ipfs::graphsync::Data &block) {
+    std::lock_guard lock{staging_mutex_};
+    if (staging_.empty()) {
+      return;
+    }
+    // don't depend on order of graphsync subscribers putting blocks to ipld
+    auto has{ipld_->contains(block.cid)};
+    if (!has || (!has.value() && !ipld_->set(block.cid, block.content))) {
+      logger_->warn("can't put received block to ipld");
+      return;
+    }
+    for (auto &[_, staging] : staging_) {
+      if (staging->completed || staging->failed) {
+        continue;
+      }
+      auto completed{staging->writer->write()};
+      if (!completed) {
+        logger_->warn("staging car write failed, will be written after "
+                      "transfer: {}",
+                      completed.error().message());
+        staging->failed = true;
+        continue;
+      }
+      staging->completed = completed.value();
+    }
+  }
+
   outcome::result<Signature> StorageProviderImpl::sign(const Buffer &input) {
     OUTCOME_TRY(chain_head, api_->ChainHead());
     OUTCOME_TRY(worker_info,
@@ -603,14 +693,28 @@ namespace fc::markets::storage::provider {
     auto cid_str{deal->ref.root.toString()};
     FSM_HALT_ON_ERROR(cid_str, "CIDtoString", deal);
     auto car_path = kStorageMarketImportDir / cid_str.value();
+    // blocks received after last notification are written here
+    auto staging{takeStagingCar(deal->proposal_cid)};
+    if (staging && !staging->failed) {
+      auto completed{staging->writer->write()};
+      staging->file.close();
+      if (!completed || !completed.value() || !staging->file) {
+        staging.reset();
+      }
+    } else {
+      staging.reset();
+    }
+    if (!staging) {
+      FSM_HALT_ON_ERROR(
+          fc::storage::car::makeSelectiveCar(
+              *ipld_, {{deal->ref.root, Selector{}}}, car_path.string()),
+          "makeSelectiveCar",
+          deal);
+    }
     FSM_HALT_ON_ERROR(
-        fc::storage::car::makeSelectiveCar(
-            *ipld_, {{deal->ref.root, Selector{}}}, car_path.string()),
-        "makeSelectiveCar",
+        verifyDealData(deal, car_path, staging ? &staging->commp : nullptr),
+        "importDataForDeal",
         deal);
-    FSM_HALT_ON_ERROR(importDataForDeal(deal->proposal_cid, car_path),
-                      "importDataForDeal",
-                      deal);
   }
 
   void StorageProviderImpl::onProviderEventVerifiedData(
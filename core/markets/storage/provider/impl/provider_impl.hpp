@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+#include <boost/signals2/connection.hpp>
+#include <fstream>
 #include <libp2p/host/host.hpp>
 #include <mutex>
 
@@ -18,7 +21,9 @@
 #include "markets/storage/provider/provider.hpp"
 #include "markets/storage/provider/provider_events.hpp"
 #include "markets/storage/provider/stored_ask.hpp"
+#include "proofs/commp.hpp"
 #include "sectorblocks/blocks.hpp"
+#include "storage/car/car.hpp"
 #include "storage/filestore/filestore.hpp"
 #include "storage/keystore/keystore.hpp"
 #include "storage/piece/piece_storage.hpp"
@@ -79,12 +84,57 @@ namespace fc::markets::storage::provider {
     outcome::result<Signature> sign(const Buffer &input);
 
    private:
+    /**
+     * Car of pushed deal data, written and hashed into piece commitment
+     * while blocks are received
+     */
+    struct StagingCar {
+      std::ofstream file;
+      proofs::CommP commp;
+      boost::optional<fc::storage::car::SelectiveCarWriter> writer;
+      /** All blocks were written */
+      bool completed{false};
+      /** Write failed, car is made from ipld after transfer */
+      bool failed{false};
+    };
+
     /**
      * Handle incoming deal proposal stream
      * @param stream
      */
     auto handleDealStream(const std::shared_ptr<CborStream> &stream) -> void;
 
+    /**
+     * Checks size and piece commitment of deal data
+     * @param deal - storage deal
+     * @param car_path - padded in place
+     * @param commp - hashed while received, or null to hash file
+     */
+    outcome::result<void> verifyDealData(
+        const std::shared_ptr<MinerDeal> &deal,
+        const boost::filesystem::path &car_path,
+        proofs::CommP *commp);
+
+    /**
+     * Starts writing car of pushed deal data
+     * @param deal - storage deal
+     */
+    void stageCar(const std::shared_ptr<MinerDeal> &deal);
+
+    /**
+     * Stops writing car of deal data
+     * @param proposal_cid - deal proposal cid
+     * @return staging car or null if deal data is not staged
+     */
+    std::shared_ptr<StagingCar> takeStagingCar(const CID &proposal_cid);
+
+    /**
+     * Puts received block to ipld and writes staging cars up to first
+     * missing block
+     * @param block - received block
+     */
+    void writeStagingCars(const fc::storage::ipfs::graphsync::Data &block);
+
     /**
      * Verify client signature for deal proposal
      * @param deal to verify
@@ -344,6 +394,11 @@ namespace fc::markets::storage::provider {
     std::mutex connections_mutex_;
     std::map<CID, std::shared_ptr<CborStream>> connections_;
 
+    // staging cars by proposal cid
+    std::mutex staging_mutex_;
+    std::map<CID, std::shared_ptr<StagingCar>> staging_;
+    boost::signals2::scoped_connection blocks_connection_;
+
     /** State machine */
     std::shared_ptr<ProviderFSM> fsm_;
 
@@ -30,12 +30,14 @@
 #include "markets/storage/chain_events/impl/chain_events_impl.hpp"
 #include "markets/storage/provider/impl/provider_impl.hpp"
 #include "miner/impl/miner_impl.hpp"
+#include "miner/main/metrics.hpp"
 #include "miner/mining.hpp"
 #include "miner/windowpost.hpp"
 #include "primitives/address/config.hpp"
 #include "proofs/proof_param_provider.hpp"
 #include "sector_storage/fetch_handler.hpp"
 #include "sector_storage/impl/manager_impl.hpp"
+#include "sector_storage/impl/provable_checker.hpp"
 #include "sector_storage/impl/scheduler_impl.hpp"
 #include "sector_storage/stores/impl/index_impl.hpp"
 #include "sector_storage/stores/impl/local_store.hpp"
@@ -74,6 +76,8 @@ namespace fc {
     /** Path to presealed sectors */
     boost::optional<boost::filesystem::path> preseal_path;
 
+    sector_storage::ProvableCheckerConfig provable;
+
     auto join(const std::string &path) const {
       return (repo_path / path).string();
     }
@@ -85,6 +89,7 @@ namespace fc {
     struct {
       boost::filesystem::path node_repo;
       std::string sector_size;
+      size_t post_check_timeout;
     } raw;
 
     po::options_description desc("Fuhon miner options");
@@ -99,6 +104,20 @@ namespace fc {
     option("pre-sealed-sectors",
            po::value(&config.preseal_path),
            "Path to presealed sectors");
+    option("post-check-parallel",
+           po::value(&config.provable.per_path)
+               ->default_value(config.provable.per_path),
+           "Sectors checked at once on each storage path before window PoSt");
+    option("post-check-timeout",
+           po::value(&raw.post_check_timeout)
+               ->default_value(std::chrono::duration_cast<std::chrono::seconds>(
+                                   config.provable.timeout)
+                                   .count()),
+           "Seconds after which sector check is failed");
+    option("post-check-read",
+           po::value(&config.provable.read_challenge)
+               ->default_value(config.provable.read_challenge),
+           "Read random node of sealed sectors before window PoSt");
     desc.add(configProfile());
     primitives::address::configCurrentNetwork(option);
 
@@ -112,6 +131,8 @@ namespace fc {
       po::notify(vm);
     }
 
+    config.provable.timeout = std::chrono::seconds{raw.post_check_timeout};
+
     OUTCOME_TRYA(config.node_api,
                  api::rpc::loadInfo(raw.node_repo, "FULLNODE_API_INFO"));
     if (!raw.sector_size.empty()) {
@@ -330,9 +351,14 @@ namespace fc {
 
     auto wscheduler{
         std::make_shared<sector_storage::SchedulerImpl>(minfo.seal_proof_type)};
+    auto provable{std::make_shared<sector_storage::ProvableChecker>(
+        sector_index, local_store, config.provable)};
     OUTCOME_TRY(manager,
                 sector_storage::ManagerImpl::newManager(
-                    remote_store, wscheduler, {true, true, true, true}));
+                    remote_store,
+                    wscheduler,
+                    {true, true, true, true},
+                    provable));
 
     // TODO(ortyomka): make param
     mining::Config default_config{
@@ -360,7 +386,7 @@ namespace fc {
     mining->start();
 
     auto window{mining::WindowPoStScheduler::create(
-        napi, manager, manager, *config.actor)};
+        napi, manager, provable, *config.actor)};
 
     auto graphsync{std::make_shared<storage::ipfs::graphsync::GraphsyncImpl>(
         host, scheduler)};
@@ -405,7 +431,6 @@ namespace fc {
             datatransfer,
             napi,
             piece_storage,
-            markets_ipld,
             one_key("retrieval_provider_ask", leveldb),
             manager,
             miner)};
@@ -427,6 +452,11 @@ namespace fc {
     auto mroutes{std::make_shared<api::Routes>()};
 
     mroutes->insert({"/remote", sector_storage::serveHttp(local_store)});
+    mroutes->insert({"/metrics", [metrics{miner::Metrics{provable}}](auto &) {
+                       api::http::response<api::http::string_body> res;
+                       res.body() = metrics.prometheus();
+                       return api::WrapperResponse{std::move(res)};
+                     }});
 
     api::serve(mrpc, mroutes, *io, "127.0.0.1", config.api_port);
     api::rpc::saveInfo(config.repo_path, config.api_port, "stub");
@@ -0,0 +1,45 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <sstream>
+
+#include "sector_storage/impl/provable_checker.hpp"
+
+namespace fc::miner {
+  using sector_storage::ProvableChecker;
+
+  struct Metrics {
+    std::string prometheus() const {
+      std::stringstream ss;
+      auto metric{[&](auto &&name, auto &&value) {
+        ss << name << ' ' << value << std::endl;
+      }};
+
+      provable->stats([&](auto &storage, auto &stats) {
+        auto label{"{storage=\"" + storage + "\""};
+        uint64_t cumulative{0};
+        for (size_t i{0}; i < stats.buckets.size(); ++i) {
+          cumulative += stats.buckets[i].load();
+          auto le{i < ProvableChecker::Stats::kBucketsMs.size()
+                      ? std::to_string(ProvableChecker::Stats::kBucketsMs[i])
+                      : "+Inf"};
+          metric("sector_check_ms_bucket" + label + ",le=\"" + le + "\"}",
+                 cumulative);
+        }
+        metric("sector_check_ms_sum" + label + "}",
+               stats.sum_us.load() / 1000);
+        metric("sector_check_ms_count" + label + "}", stats.count.load());
+        metric("sector_check_faulty" + label + "}", stats.faulty.load());
+        metric("sector_check_timeouts" + label + "}", stats.timeouts.load());
+      });
+
+      return ss.str();
+    }
+
+    std::shared_ptr<ProvableChecker> provable;
+  };
+}  // namespace fc::miner
@@ -73,21 +73,27 @@ namespace fc::mining {
               api->StateMinerPartitions(miner, declare_index, apply->key)}) {
         auto declare{[&](auto faults) {
           DeclareFaults::Params params;
-          uint64_t _part{0};
+          std::vector<RleBitset> checked;
+          RleBitset all;
           for (auto &part : _parts.value()) {
-            if (auto _sectors{checkSectors(faults
-                                               ? part.live - part.faulty
-                                               : part.faulty - part.recovering,
-                                           !faults)}) {
-              auto &sectors{_sectors.value()};
-              if (!sectors.empty()) {
-                params.faults.push_back(
-                    {declare_index, _part, std::move(sectors)});
-              }
-            } else {
-              return;
+            checked.push_back(faults ? part.live - part.faulty
+                                     : part.faulty - part.recovering);
+            all += checked.back();
+          }
+          // one check of all partitions, so storage paths are checked in
+          // parallel
+          auto _bad{checkSectors(all, false)};
+          if (!_bad) {
+            return;
+          }
+          auto &bad{_bad.value()};
+          for (uint64_t _part{0}; _part < checked.size(); ++_part) {
+            auto &sectors{checked[_part]};
+            auto declared{faults ? sectors - (sectors - bad) : sectors - bad};
+            if (!declared.empty()) {
+              params.faults.push_back(
+                  {declare_index, _part, std::move(declared)});
             }
-            ++_part;
           }
           if (!params.faults.empty()) {
             std::ignore = pushMessage(
@@ -114,10 +120,14 @@ namespace fc::mining {
             params.deadline = deadline.index;
             std::vector<SectorInfo> sectors;
             RleBitset post_skip;
+            RleBitset all;
+            for (auto &part : parts) {
+              all += part.live - part.faulty + part.recovering;
+            }
+            OUTCOME_TRY(bad, checkSectors(all, false));
             for (auto &part : parts) {
               auto to_prove{part.live - part.faulty + part.recovering};
-              OUTCOME_TRY(good, checkSectors(to_prove, true));
-              good = good - post_skip;
+              auto good{to_prove - bad - post_skip};
               auto skip{to_prove - good};
               OUTCOME_TRY(_sectors,
                           api->StateMinerSectors(miner, good, apply->key));
@@ -40,7 +40,8 @@ namespace fc::sync {
 
     head_constructor_.start(events_);
 
-    events_->signalCurrentHead({.tipset = head_, .weight = heaviest_weight_});
+    events_->signalCurrentHead(
+        {.tipset = heaviestTipset(), .weight = heaviest_weight_});
 
     return outcome::success();
   }
@@ -52,16 +53,16 @@ namespace fc::sync {
   }
 
   TipsetCPtr ChainStoreImpl::heaviestTipset() const {
-    assert(head_);
-    return head_;
+    auto head{std::atomic_load(&head_)};
+    assert(head);
+    return head;
   }
 
   storage::blockchain::ChainStore::connection_t
   ChainStoreImpl::subscribeHeadChanges(
       const std::function<HeadChangeSignature> &subscriber) {
-    assert(head_);
     subscriber(primitives::tipset::HeadChange{
-        primitives::tipset::HeadChangeType::CURRENT, head_});
+        primitives::tipset::HeadChangeType::CURRENT, heaviestTipset()});
     return head_change_signal_.connect(subscriber);
   }
 
@@ -90,9 +91,10 @@ namespace fc::sync {
     for (auto it{std::next(apply.begin())}; it != apply.end(); ++it) {
       notify(it);
     }
-    head_ = ts_load_->lazyLoad(std::prev(apply.end())->second).value();
+    auto head{ts_load_->lazyLoad(std::prev(apply.end())->second).value()};
+    std::atomic_store(&head_, head);
     heaviest_weight_ = weight;
-    events_->signalCurrentHead({.tipset = head_, .weight = heaviest_weight_});
+    events_->signalCurrentHead({.tipset = head, .weight = heaviest_weight_});
   }
 
 }  // namespace fc::sync
@@ -45,6 +45,10 @@ namespace fc::sync {
 
     std::shared_ptr<events::Events> events_;
 
+    /**
+     * Replaced on io thread, read by api methods on other threads.
+     * Accessed with std::atomic_load/std::atomic_store.
+     */
     TipsetCPtr head_;
     BigInt heaviest_weight_;
 
@@ -61,6 +61,7 @@
 #include "vm/actor/builtin/states/state_provider.hpp"
 #include "vm/actor/impl/invoker_impl.hpp"
 #include "vm/interpreter/impl/interpreter_impl.hpp"
+#include "vm/interpreter/impl/interpreter_pipeline.hpp"
 #include "vm/runtime/impl/tipset_randomness.hpp"
 #include "vm/state/impl/state_tree_impl.hpp"
 
@@ -164,7 +165,7 @@ namespace fc::node {
       }
       // TODO(turuslan): max memory
       o.ipld_cids = *storage::cids_index::loadOrCreateWithProgress(
-          *config.snapshot, false, boost::none, o.ipld, log());
+          *config.snapshot, false, boost::none, o.ipld, log(), true);
       o.ipld = o.ipld_cids;
       if (snapshot_cids.empty()) {
         snapshot_cids = roots;
@@ -226,7 +227,7 @@ namespace fc::node {
     // TODO(turuslan): max memory
     // estimated, 1gb
     o.ipld_cids_write = *storage::cids_index::loadOrCreateWithProgress(
-        car_path, true, 1 << 30, o.ipld, log());
+        car_path, true, 1 << 30, o.ipld, log(), true);
     // estimated
     o.ipld_cids_write->flush_on = 200000;
     o.ipld = o.ipld_cids_write;
@@ -323,6 +324,15 @@ namespace fc::node {
     auto snapshot_cids{loadSnapshot(config, o)};
 
     writableIpld(config, o);
+    if (config.prefetch_threads != 0) {
+      auto prefetch_pool{std::make_shared<boost::asio::thread_pool>(
+          config.prefetch_threads)};
+      for (auto &cids : {o.ipld_cids, o.ipld_cids_write}) {
+        if (cids) {
+          cids->prefetch_pool = prefetch_pool;
+        }
+      }
+    }
 
     o.ts_load_ipld = std::make_shared<primitives::tipset::TsLoadIpld>(o.ipld);
     o.ts_load = std::make_shared<primitives::tipset::TsLoadCache>(
@@ -338,6 +348,11 @@ namespace fc::node {
     o.env_context.randomness = std::make_shared<vm::runtime::TipsetRandomness>(
         o.ts_load, o.env_context.ts_branches_mutex);
     o.env_context.ts_load = o.ts_load;
+    if (config.speculative_threads != 0) {
+      o.env_context.speculative_pool =
+          std::make_shared<boost::asio::thread_pool>(
+              config.speculative_threads);
+    }
     o.env_context.interpreter_cache =
         std::make_shared<vm::interpreter::InterpreterCache>(
             std::make_shared<storage::MapPrefix>("vm/", o.kv_store));
@@ -420,7 +435,35 @@ namespace fc::node {
           return ByteArray(h.data(), h.data() + h.size());
         });
 
-    o.pubsub_gate = std::make_shared<sync::PubSubGate>(o.gossip);
+    auto power_table = std::make_shared<power::PowerTableImpl>();
+
+    auto bls_provider = std::make_shared<crypto::bls::BlsProviderImpl>(
+        std::thread::hardware_concurrency());
+
+    auto secp_provider =
+        std::make_shared<crypto::secp256k1::Secp256k1ProviderImpl>();
+
+    o.signature_verifier = std::make_shared<vm::message::SignatureVerifier>(
+        std::thread::hardware_concurrency(),
+        storage::mpool::kSignatureCacheSize);
+
+    auto block_validator =
+        std::make_shared<blockchain::block_validator::BlockValidatorImpl>(
+            o.ipld,
+            o.utc_clock,
+            o.chain_epoch_clock,
+            weight_calculator,
+            power_table,
+            bls_provider,
+            secp_provider,
+            o.env_context.interpreter_cache,
+            o.signature_verifier);
+
+    o.pubsub_gate = std::make_shared<sync::PubSubGate>(o.gossip,
+                                                       o.io_context,
+                                                       o.ipld,
+                                                       block_validator,
+                                                       o.signature_verifier);
 
     auto id_manager =
         injector.create<std::shared_ptr<libp2p::peer::IdentityManager>>();
@@ -446,48 +489,37 @@ namespace fc::node {
 
     log()->debug("Creating chain store...");
 
-    auto power_table = std::make_shared<power::PowerTableImpl>();
-
-    auto bls_provider = std::make_shared<crypto::bls::BlsProviderImpl>();
-
-    auto secp_provider =
-        std::make_shared<crypto::secp256k1::Secp256k1ProviderImpl>();
-
-    auto block_validator =
-        std::make_shared<blockchain::block_validator::BlockValidatorImpl>(
-            o.ipld,
-            o.utc_clock,
-            o.chain_epoch_clock,
-            weight_calculator,
-            power_table,
-            bls_provider,
-            secp_provider,
-            o.env_context.interpreter_cache);
-
     auto head{
         o.ts_load->lazyLoad(std::prev(o.ts_main->chain.end())->second).value()};
     auto head_weight{
         o.env_context.interpreter_cache->get(head->key).value().weight};
     o.chain_store = std::make_shared<sync::ChainStoreImpl>(
-        o.ipld, o.ts_load, head, head_weight, std::move(block_validator));
+        o.ipld, o.ts_load, head, head_weight, block_validator);
 
+    o.interpreter_pipeline =
+        std::make_shared<vm::interpreter::InterpreterPipeline>(
+            o.interpreter,
+            o.env_context.interpreter_cache,
+            o.ipld,
+            std::thread::hardware_concurrency());
     o.sync_job =
         std::make_shared<sync::SyncJob>(o.host,
                                         o.chain_store,
                                         o.scheduler,
-                                        o.vm_interpreter,
+                                        o.interpreter_pipeline,
                                         o.env_context.interpreter_cache,
                                         o.env_context.ts_branches_mutex,
                                         o.ts_branches,
                                         o.ts_main_kv,
                                         o.ts_main,
                                         o.ts_load,
-                                        o.ipld);
+                                        o.ipld,
+                                        block_validator);
 
     log()->debug("Creating API...");
 
     auto mpool = storage::mpool::MessagePool::create(
-        o.env_context, o.ts_main, o.chain_store);
+        o.env_context, o.ts_main, o.chain_store, o.signature_verifier);
 
     auto msg_waiter = storage::blockchain::MsgWaiter::create(
         o.ts_load, o.ipld, o.chain_store);
@@ -543,6 +575,14 @@ namespace fc::node {
         genesis_timestamp,
         std::chrono::seconds(kEpochDurationSeconds));
 
+    o.state_cache = std::make_shared<api::StateCache>(api::kStateCacheBytes);
+    if (config.api_threads != 0) {
+      o.api_dispatcher =
+          std::make_shared<api::rpc::Dispatcher>(config.api_threads);
+      for (auto &[method, limit] : config.api_method_limits) {
+        o.api_dispatcher->limit(method, limit);
+      }
+    }
     o.api = api::makeImpl(o.chain_store,
                           *config.network_name,
                           weight_calculator,
@@ -556,7 +596,11 @@ namespace fc::node {
                           o.key_store,
                           o.market_discovery,
                           o.retrieval_market_client,
-                          o.wallet_default_address);
+                          o.wallet_default_address,
+                          o.state_cache,
+                          std::make_shared<storage::hamt::HamtIndex>(
+                              std::make_shared<storage::MapPrefix>(
+                                  "hamt_index/", o.kv_store)));
 
     o.datatransfer = DataTransfer::make(o.host, o.graphsync);
     OUTCOME_TRY(createStorageMarketClient(o));
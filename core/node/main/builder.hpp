@@ -10,6 +10,8 @@
 
 #include "api/full_node/node_api.hpp"
 #include "api/full_node/node_api_v1_wrapper.hpp"
+#include "api/full_node/state_cache.hpp"
+#include "api/rpc/dispatcher.hpp"
 #include "api/rpc/json.hpp"
 #include "common/outcome.hpp"
 #include "data_transfer/dt.hpp"
@@ -29,6 +31,7 @@
 #include "storage/keystore/keystore.hpp"
 #include "storage/leveldb/leveldb.hpp"
 #include "storage/leveldb/prefix.hpp"
+#include "vm/message/signature_verifier.hpp"
 #include "vm/runtime/env_context.hpp"
 
 namespace fc::node {
@@ -88,6 +91,7 @@ namespace fc::node {
     // pubsub
     std::shared_ptr<libp2p::protocol::gossip::Gossip> gossip;
     std::shared_ptr<sync::PubSubGate> pubsub_gate;
+    std::shared_ptr<vm::message::SignatureVerifier> signature_verifier;
 
     // graphsync
     std::shared_ptr<storage::ipfs::graphsync::Graphsync> graphsync;
@@ -97,6 +101,7 @@ namespace fc::node {
     std::shared_ptr<sync::blocksync::BlocksyncServer> blocksync_server;
     std::shared_ptr<vm::interpreter::InterpreterImpl> interpreter;
     std::shared_ptr<vm::interpreter::CachedInterpreter> vm_interpreter;
+    std::shared_ptr<vm::interpreter::InterpreterPipeline> interpreter_pipeline;
     std::shared_ptr<sync::SyncJob> sync_job;
     vm::runtime::EnvironmentContext env_context;
 
@@ -117,6 +122,8 @@ namespace fc::node {
     std::shared_ptr<api::FullNodeApiV1Wrapper> api_v1;
     // Full node API v2.x.x (latest)
     std::shared_ptr<api::FullNodeApi> api;
+    std::shared_ptr<api::StateCache> state_cache;
+    std::shared_ptr<api::rpc::Dispatcher> api_dispatcher;
   };
 
   /**
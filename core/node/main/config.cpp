@@ -73,6 +73,7 @@ namespace fc::node {
     struct {
       char log_level;
       boost::optional<boost::filesystem::path> copy_genesis, copy_config;
+      std::vector<std::string> api_method_limits;
     } raw;
     namespace po = boost::program_options;
     po::options_description desc("Fuhon node options");
@@ -90,6 +91,22 @@ namespace fc::node {
            po::value(&raw.log_level)->default_value('i'),
            "log level, [e,w,i,d,t]");
     option("import-snapshot", po::value(&config.snapshot));
+    option("speculative-threads",
+           po::value(&config.speculative_threads),
+           "threads to execute messages of different senders concurrently, "
+           "0 disables speculative execution");
+    option("prefetch-threads",
+           po::value(&config.prefetch_threads),
+           "threads to read ahead children of visited state tree nodes, "
+           "0 disables prefetch");
+    option("api-threads",
+           po::value(&config.api_threads),
+           "threads to run heavy API methods without blocking other calls, "
+           "0 runs all methods on io thread");
+    option("api-method-limit",
+           po::value(&raw.api_method_limits)->composing(),
+           "METHOD=N, run API method on api threads with at most N "
+           "concurrent calls, 0 runs it on io thread");
     option("import-key",
            po::value(&config.wallet_default_key_path),
            "on first run, imports a default key from a given file. The key "
@@ -142,6 +159,21 @@ namespace fc::node {
       po::notify(vm);
     }
 
+    for (auto &limit : raw.api_method_limits) {
+      auto eq{limit.find('=')};
+      if (eq == std::string::npos) {
+        std::cerr << "invalid api-method-limit: " << limit << std::endl;
+        exit(EXIT_FAILURE);
+      }
+      auto method{limit.substr(0, eq)};
+      auto n{std::stoull(limit.substr(eq + 1))};
+      if (n == 0) {
+        config.api_method_limits.erase(method);
+      } else {
+        config.api_method_limits[method] = n;
+      }
+    }
+
     config.log_level = getLogLevel(raw.log_level);
     spdlog::set_level(config.log_level);
 
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <boost/filesystem/path.hpp>
+#include <map>
 #include <libp2p/peer/peer_info.hpp>
 #include <libp2p/protocol/gossip/gossip.hpp>
 #include <libp2p/protocol/kademlia/config.hpp>
@@ -38,6 +39,24 @@ namespace fc::node {
     boost::optional<int64_t> drand_period;
     size_t beaconizer_cache_size = 100;
 
+    /** Speculative message execution threads, disabled if 0 */
+    size_t speculative_threads = 0;
+
+    /** Threads reading ahead ipld nodes of traversed trees, disabled if 0 */
+    size_t prefetch_threads = 4;
+
+    /** Threads running heavy API methods off io thread, disabled if 0 */
+    size_t api_threads = 0;
+    /**
+     * Concurrent calls limit of API methods run by `api_threads`.
+     * Methods reading actors through state cache are not listed by default.
+     */
+    std::map<std::string, size_t> api_method_limits{
+        {"ChainGetParentMessages", 2},
+        {"StateListActors", 1},
+        {"StateListMessages", 1},
+    };
+
     /**
      * Adds libp2p connection in order to increase host score. Used for
      * debugging.
@@ -198,6 +198,11 @@ namespace fc {
 
     auto rpc{api::makeRpc(*node_objects.api)};
 
+    if (node_objects.api_dispatcher) {
+      node_objects.api_dispatcher->wrap(*rpc_v1);
+      node_objects.api_dispatcher->wrap(*rpc);
+    }
+
     std::map<std::string, std::shared_ptr<api::Rpc>> rpcs;
     rpcs.emplace("/rpc/v0", rpc_v1);
     rpcs.emplace("/rpc/v1", rpc);
@@ -13,6 +13,7 @@
 #include "node/events.hpp"
 #include "node/main/builder.hpp"
 #include "node/sync_job.hpp"
+#include "vm/interpreter/impl/interpreter_pipeline.hpp"
 
 namespace fc::node {
   struct Metrics {
@@ -43,13 +44,46 @@ namespace fc::node {
       metric("height_expected",
              o.chain_epoch_clock->epochAtTime(o.utc_clock->nowUTC()).value());
 
-      metric("car_size", o.ipld_cids_write->car_offset);
+      metric("car_size", o.ipld_cids_write->car_offset.load());
       std::shared_lock index_lock{o.ipld_cids_write->index_mutex};
       metric("car_count", o.ipld_cids_write->index->size());
       index_lock.unlock();
       std::shared_lock written_lock{o.ipld_cids_write->written_mutex};
       metric("car_tmp", o.ipld_cids_write->written.size());
       written_lock.unlock();
+      metric("car_bloom_absent", o.ipld_cids_write->bloom_absent.load());
+      metric("car_bloom_present", o.ipld_cids_write->bloom_present.load());
+      metric("car_bloom_false_positive",
+             o.ipld_cids_write->bloom_false_positive.load());
+
+      auto &interpreter{o.interpreter_pipeline->metrics};
+      metric("interpret_tipsets", interpreter.tipsets.load());
+      metric("interpret_messages", interpreter.messages.load());
+      metric("interpret_wall_us", interpreter.wall_us.load());
+      metric("interpret_prefetch_us", interpreter.prefetch_us.load());
+      metric("interpret_prefetch_wait_us",
+             interpreter.prefetch_wait_us.load());
+      metric("interpret_execute_us", interpreter.execute_us.load());
+      metric("interpret_flush_us", interpreter.flush_us.load());
+
+      auto &verifier{*o.signature_verifier};
+      metric("signature_cache_hits", verifier.hits.load());
+      metric("signature_cache_misses", verifier.misses.load());
+      metric("signature_invalid", verifier.invalid.load());
+
+      auto &state_cache{*o.state_cache};
+      metric("api_actor_cache_hits", state_cache.actor_hits.load());
+      metric("api_actor_cache_misses", state_cache.actor_misses.load());
+      metric("api_actor_cache_bytes", state_cache.bytes());
+
+      if (o.api_dispatcher) {
+        o.api_dispatcher->stats([&](auto &method, auto &stats) {
+          auto label{"{method=\"" + method + "\"}"};
+          metric("api_dispatch_calls" + label, stats.calls.load());
+          metric("api_dispatch_running" + label, stats.running.load());
+          metric("api_dispatch_queued" + label, stats.queued.load());
+        });
+      }
 
       return ss.str();
     }
@@ -5,10 +5,12 @@
 
 #include "node/pubsub_gate.hpp"
 
+#include "blockchain/block_validator/block_validator.hpp"
 #include "codec/cbor/cbor_codec.hpp"
 #include "common/logger.hpp"
 #include "primitives/block/block.hpp"
 #include "primitives/cid/cid_of_cbor.hpp"
+#include "vm/message/signature_verifier.hpp"
 
 namespace fc::sync {
 
@@ -27,9 +29,19 @@ namespace fc::sync {
     }
   }  // namespace
 
-  PubSubGate::PubSubGate(std::shared_ptr<Gossip> gossip)
-      : gossip_(std::move(gossip)) {
+  PubSubGate::PubSubGate(std::shared_ptr<Gossip> gossip,
+                         std::shared_ptr<boost::asio::io_context> io,
+                         std::shared_ptr<storage::ipfs::IpfsDatastore> ipld,
+                         std::shared_ptr<BlockValidator> block_validator,
+                         std::shared_ptr<SignatureVerifier> verifier)
+      : gossip_(std::move(gossip)),
+        io_(std::move(io)),
+        ipld_(std::move(ipld)),
+        block_validator_(std::move(block_validator)),
+        verifier_(std::move(verifier)) {
     assert(gossip_);
+    assert(io_);
+    assert(ipld_);
   }
 
   void PubSubGate::start(const std::string &network_name,
@@ -94,10 +106,47 @@ namespace fc::sync {
       OUTCOME_EXCEPT(cid,
                      primitives::cid::getCidOfCbor<BlockHeader>(bm.header));
 
-      // TODO validate
+      // messages not received yet are fetched by sync, which validates
+      // aggregates of whole tipset
+      auto complete{true};
+      if (block_validator_) {
+        for (const auto &message : bm.bls_messages) {
+          auto has{ipld_->contains(message)};
+          if (!has || !has.value()) {
+            complete = false;
+            break;
+          }
+        }
+      }
+      if (!block_validator_ || !complete) {
+        events_->signalBlockFromPubSub(
+            events::BlockFromPubSub{from, std::move(cid), std::move(bm)});
+        return true;
+      }
 
-      events_->signalBlockFromPubSub(
-          events::BlockFromPubSub{from, std::move(cid), std::move(bm)});
+      // one pairing batch for all BLS messages of block, block is signaled
+      // when it is valid
+      validate_thread_.io->post([wptr{weak_from_this()},
+                                 validator{block_validator_},
+                                 io{io_},
+                                 from,
+                                 cid{std::move(cid)},
+                                 bm{std::move(bm)}] {
+        auto valid{validator->validateBlsAggregates(gsl::make_span(&bm, 1))};
+        if (!valid) {
+          log()->warn("invalid block {} from peer {}, {}",
+                      cid.toString().value(),
+                      from.toBase58(),
+                      valid.error().message());
+          return;
+        }
+        io->post([wptr, from, cid, bm] {
+          if (auto self{wptr.lock()}) {
+            self->events_->signalBlockFromPubSub(
+                events::BlockFromPubSub{from, cid, bm});
+          }
+        });
+      });
 
       return true;
     } catch (std::system_error &e) {
@@ -122,6 +171,15 @@ namespace fc::sync {
       e = cid_res.error();
     } else {
       auto res = codec::cbor::decode<primitives::block::SignedMessage>(raw);
+      // keys of senders with id addresses are not known without state
+      if (res && verifier_ && res.value().message.from.isKeyType()
+          && !verifier_->verify({res.value().message.getCid(),
+                                 res.value().signature,
+                                 res.value().message.from})) {
+        log()->warn("pubsub: invalid message signature from peer {}",
+                    from.toBase58());
+        return false;
+      }
       if (res) {
         events_->signalMessageFromPubSub(events::MessageFromPubSub{
             from,
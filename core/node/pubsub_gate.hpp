@@ -7,19 +7,41 @@
 
 #include <libp2p/protocol/gossip/gossip.hpp>
 
+#include "common/io_thread.hpp"
 #include "node/events.hpp"
+#include "storage/ipfs/datastore.hpp"
 
 namespace fc::clock {
   class UTCClock;
 }
 
+namespace fc::blockchain::block_validator {
+  class BlockValidator;
+}  // namespace fc::blockchain::block_validator
+
+namespace fc::vm::message {
+  class SignatureVerifier;
+}  // namespace fc::vm::message
+
 namespace fc::sync {
 
+  using blockchain::block_validator::BlockValidator;
   using Gossip = libp2p::protocol::gossip::Gossip;
+  using vm::message::SignatureVerifier;
 
   class PubSubGate : public std::enable_shared_from_this<PubSubGate> {
    public:
-    explicit PubSubGate(std::shared_ptr<Gossip> gossip);
+    /**
+     * @param io - gossip thread, blocks are signaled there after validation
+     * @param ipld - messages of blocks are looked up in
+     * @param block_validator - validates BLS aggregates of blocks if set
+     * @param verifier - verifies signatures of messages if set
+     */
+    PubSubGate(std::shared_ptr<Gossip> gossip,
+               std::shared_ptr<boost::asio::io_context> io,
+               std::shared_ptr<storage::ipfs::IpfsDatastore> ipld,
+               std::shared_ptr<BlockValidator> block_validator = nullptr,
+               std::shared_ptr<SignatureVerifier> verifier = nullptr);
 
     void start(const std::string &network_name,
                std::shared_ptr<events::Events> events);
@@ -39,6 +61,10 @@ namespace fc::sync {
     bool onMsg(const PeerId &from, const Bytes &raw);
 
     std::shared_ptr<Gossip> gossip_;
+    std::shared_ptr<boost::asio::io_context> io_;
+    std::shared_ptr<storage::ipfs::IpfsDatastore> ipld_;
+    std::shared_ptr<BlockValidator> block_validator_;
+    std::shared_ptr<SignatureVerifier> verifier_;
 
     std::shared_ptr<events::Events> events_;
 
@@ -51,6 +77,9 @@ namespace fc::sync {
     std::string msgs_topic_;
 
     events::Connection peer_connected_event_;
+
+    // pairings of BLS aggregates, off gossip thread
+    IoThread validate_thread_;
   };
 
 }  // namespace fc::sync
@@ -14,9 +14,12 @@
 #include "vm/interpreter/interpreter.hpp"
 
 namespace fc::sync {
+  using primitives::block::MsgMeta;
   using primitives::tipset::chain::stepParent;
 
   constexpr auto kBranchCompactTreshold{200u};
+  // estimated
+  constexpr auto kInterpretPrefetch{16u};
 
   namespace {
     auto log() {
@@ -44,14 +47,15 @@ namespace fc::sync {
   SyncJob::SyncJob(std::shared_ptr<libp2p::Host> host,
                    std::shared_ptr<ChainStoreImpl> chain_store,
                    std::shared_ptr<libp2p::protocol::Scheduler> scheduler,
-                   std::shared_ptr<Interpreter> interpreter,
+                   std::shared_ptr<InterpreterPipeline> interpreter,
                    std::shared_ptr<InterpreterCache> interpreter_cache,
                    SharedMutexPtr ts_branches_mutex,
                    TsBranchesPtr ts_branches,
                    KvPtr ts_main_kv,
                    TsBranchPtr ts_main,
                    TsLoadPtr ts_load,
-                   IpldPtr ipld)
+                   IpldPtr ipld,
+                   std::shared_ptr<BlockValidator> block_validator)
       : host_(std::move(host)),
         chain_store_(std::move(chain_store)),
         scheduler_(std::move(scheduler)),
@@ -62,7 +66,9 @@ namespace fc::sync {
         ts_main_kv_(std::move(ts_main_kv)),
         ts_main_(std::move(ts_main)),
         ts_load_(std::move(ts_load)),
-        ipld_(std::move(ipld)) {
+        ipld_(std::move(ipld)),
+        block_validator_(std::move(block_validator)) {
+    assert(block_validator_);
     attached_.insert(ts_main_);
   }
 
@@ -243,7 +249,7 @@ namespace fc::sync {
     }
     auto it{std::prev(branch->chain.end())};
     while (true) {
-      if (auto _res{interpreter_cache_->tryGet(it->second.key)}) {
+      if (auto _res{interpreter_->tryGet(it->second.key)}) {
         if (*_res) {
           if (auto _ts{ts_load_->lazyLoad(it->second)}) {
             interpret_ts_ = _ts.value();
@@ -282,7 +288,7 @@ namespace fc::sync {
 
   bool SyncJob::checkParent(TipsetCPtr ts) {
     if (ts->height() != 0) {
-      if (auto _res{interpreter_cache_->tryGet(ts->getParents())}) {
+      if (auto _res{interpreter_->tryGet(ts->getParents())}) {
         if (*_res) {
           auto &res{_res->value()};
           if (ts->getParentStateRoot() != res.state_root) {
@@ -309,8 +315,10 @@ namespace fc::sync {
                     fmt::join(ts->key.cids(), ","));
         return false;
       }
-      if (auto _has{ipld_->contains(ts->getParentStateRoot())};
-          !_has || !_has.value()) {
+      if (interpreter_->pending(ts->getParents())) {
+        // parent state is being flushed
+      } else if (auto _has{ipld_->contains(ts->getParentStateRoot())};
+                 !_has || !_has.value()) {
         log()->warn("no parent state {} {}",
                     ts->height(),
                     fmt::join(ts->key.cids(), ","));
@@ -320,6 +328,20 @@ namespace fc::sync {
     return true;
   }
 
+  outcome::result<void> SyncJob::validateBls(const TipsetCPtr &ts) const {
+    std::vector<BlockWithCids> blocks;
+    for (const auto &block : ts->blks) {
+      OUTCOME_TRY(meta, ipld_->getCbor<MsgMeta>(block.messages));
+      auto &block_cids{blocks.emplace_back(BlockWithCids{block, {}, {}})};
+      OUTCOME_TRY(meta.bls_messages.visit(
+          [&](auto, auto &cid) -> outcome::result<void> {
+            block_cids.bls_messages.push_back(cid);
+            return outcome::success();
+          }));
+    }
+    return block_validator_->validateBlsAggregates(blocks);
+  }
+
   void SyncJob::interpretDequeue() {
     if (interpreting_ || !interpret_ts_) {
       return;
@@ -329,20 +351,33 @@ namespace fc::sync {
     if (!checkParent(ts)) {
       // TODO: detach and ban branches
       interpret_ts_ = nullptr;
+      interpreter_->clearPrefetch();
       return;
     }
     interpreting_ = true;
+    interpretPrefetch(ts);
     interpret_thread.io->post([=] {
-      auto result{interpreter_->interpret(branch, ts)};
+      auto result{[&]() -> outcome::result<InterpreterResult> {
+        // pairings of all blocks of tipset are checked together
+        OUTCOME_TRY(validateBls(ts));
+        // state is flushed in background, head is updated after that
+        return interpreter_->interpret(branch, ts, [=](auto flushed) {
+          if (!flushed) {
+            log()->warn("interpret flush error {:#}", flushed.error());
+            return;
+          }
+          thread.io->post([=] {
+            std::unique_lock lock{*ts_branches_mutex_};
+            onInterpret(ts, flushed.value());
+          });
+        });
+      }()};
       if (!result) {
         log()->warn("interpret error {:#}", result.error());
       }
       thread.io->post([=] {
         std::unique_lock lock{*ts_branches_mutex_};
         interpreting_ = false;
-        if (result) {
-          onInterpret(ts, result.value());
-        }
         if (interpret_ts_ == ts) {
           if (result) {
             if (auto _ts{stepUp(
@@ -354,6 +389,7 @@ namespace fc::sync {
           } else {
             // TODO: detach and ban branches
             interpret_ts_ = nullptr;
+            interpreter_->clearPrefetch();
           }
         }
         interpretDequeue();
@@ -361,6 +397,17 @@ namespace fc::sync {
     });
   }
 
+  void SyncJob::interpretPrefetch(TipsetCPtr ts) {
+    for (auto i{0u}; ts && i < kInterpretPrefetch; ++i) {
+      interpreter_->prefetch(ts);
+      if (auto _ts{stepUp(ts_load_, attached_heaviest_.first, ts)}) {
+        ts = _ts.value();
+      } else {
+        break;
+      }
+    }
+  }
+
   void SyncJob::fetch(const PeerId &peer, const TipsetKey &tsk) {
     std::unique_lock lock{requests_mutex_};
     requests_.emplace(peer, tsk);
@@ -8,16 +8,18 @@
 #include <queue>
 
 #include "blocksync_request.hpp"
+#include "blockchain/block_validator/block_validator.hpp"
 #include "common/io_thread.hpp"
 #include "primitives/tipset/chain.hpp"
 #include "storage/buffer_map.hpp"
-#include "vm/interpreter/interpreter.hpp"
+#include "vm/interpreter/impl/interpreter_pipeline.hpp"
 
 namespace fc::sync {
+  using blockchain::block_validator::BlockValidator;
   using blocksync::BlocksyncRequest;
   using primitives::tipset::chain::KvPtr;
-  using vm::interpreter::Interpreter;
   using vm::interpreter::InterpreterCache;
+  using vm::interpreter::InterpreterPipeline;
   using InterpreterResult = vm::interpreter::Result;
 
   class SyncJob {
@@ -25,14 +27,15 @@ namespace fc::sync {
     SyncJob(std::shared_ptr<libp2p::Host> host,
             std::shared_ptr<ChainStoreImpl> chain_store,
             std::shared_ptr<libp2p::protocol::Scheduler> scheduler,
-            std::shared_ptr<Interpreter> interpreter,
+            std::shared_ptr<InterpreterPipeline> interpreter,
             std::shared_ptr<InterpreterCache> interpreter_cache,
             SharedMutexPtr ts_branches_mutex,
             TsBranchesPtr ts_branches,
             KvPtr ts_main_kv,
             TsBranchPtr ts_main,
             TsLoadPtr ts_load,
-            IpldPtr ipld);
+            IpldPtr ipld,
+            std::shared_ptr<BlockValidator> block_validator);
 
     /// Listens to PossibleHead and PeerConnected events
     void start(std::shared_ptr<events::Events> events);
@@ -56,8 +59,14 @@ namespace fc::sync {
 
     bool checkParent(TipsetCPtr ts);
 
+    /// Validates BLS aggregates of all blocks of tipset in one batch
+    outcome::result<void> validateBls(const TipsetCPtr &ts) const;
+
     void interpretDequeue();
 
+    /// Prefetches messages of next tipsets to interpret
+    void interpretPrefetch(TipsetCPtr ts);
+
     void fetch(const PeerId &peer, const TipsetKey &tsk);
 
     void fetchDequeue();
@@ -67,7 +76,7 @@ namespace fc::sync {
     std::shared_ptr<libp2p::Host> host_;
     std::shared_ptr<ChainStoreImpl> chain_store_;
     std::shared_ptr<libp2p::protocol::Scheduler> scheduler_;
-    std::shared_ptr<Interpreter> interpreter_;
+    std::shared_ptr<InterpreterPipeline> interpreter_;
     std::shared_ptr<InterpreterCache> interpreter_cache_;
     SharedMutexPtr ts_branches_mutex_;
     TsBranchesPtr ts_branches_;
@@ -75,6 +84,7 @@ namespace fc::sync {
     TsBranchPtr ts_main_;
     TsLoadPtr ts_load_;
     IpldPtr ipld_;
+    std::shared_ptr<BlockValidator> block_validator_;
     TsBranches attached_;
     std::pair<TsBranchPtr, BigInt> attached_heaviest_;
     TipsetCPtr interpret_ts_;
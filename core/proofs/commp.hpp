@@ -0,0 +1,69 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <deque>
+#include <future>
+
+#include "common/blob.hpp"
+#include "common/span.hpp"
+#include "primitives/cid/cid.hpp"
+#include "primitives/piece/piece.hpp"
+
+namespace fc::proofs {
+  using common::BytesIn;
+  using common::Hash256;
+  using primitives::piece::UnpaddedPieceSize;
+
+  /**
+   * Computes piece commitment (CommP) without ffi.
+   * Unpadded bytes are fr32 padded and hashed into sha256-trunc254 binary
+   * merkle tree. Full batches are hashed in parallel on shared thread pool,
+   * missing tail of piece is filled with zero piece commitments.
+   */
+  class CommP {
+   public:
+    /** Unpadded bytes hashed by one task */
+    static constexpr size_t kBatchUnpadded{127 << 13};
+    /** Padded bytes hashed by one task */
+    static constexpr size_t kBatchPadded{128 << 13};
+
+    /** @param parallel max batches hashed at same time, 0 for cpu count */
+    explicit CommP(size_t parallel = 0);
+
+    /** Appends unpadded piece bytes */
+    void update(BytesIn input);
+
+    /** Returns number of unpadded bytes appended */
+    uint64_t count() const;
+
+    /**
+     * Pads appended bytes with zeros up to piece size and returns piece
+     * commitment. Resets state, so instance can be reused.
+     */
+    outcome::result<CID> finish(UnpaddedPieceSize size);
+
+   private:
+    void flush();
+    void pop();
+    void push(Hash256 hash, size_t level);
+
+    size_t parallel_;
+    uint64_t count_{};
+    std::vector<uint8_t> batch_;
+    std::deque<std::future<Hash256>> pending_;
+    std::vector<boost::optional<Hash256>> layers_;
+  };
+
+  /**
+   * Reads piece from file descriptor and computes its commitment.
+   * File shorter than piece size is padded with zeros.
+   */
+  outcome::result<CID> generatePieceCommitment(int fd,
+                                               UnpaddedPieceSize size,
+                                               size_t parallel = 0);
+}  // namespace fc::proofs
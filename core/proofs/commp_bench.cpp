@@ -0,0 +1,85 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <filecoin-ffi/filcrypto.h>
+#include <spdlog/fmt/fmt.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <gsl/gsl_util>
+#include <random>
+#include <thread>
+
+#include "common/bench.hpp"
+#include "common/ffi.hpp"
+#include "primitives/cid/comm_cid.hpp"
+#include "primitives/piece/piece_data.hpp"
+#include "proofs/commp.hpp"
+
+namespace fc::proofs {
+  namespace fs = boost::filesystem;
+  using primitives::piece::PieceData;
+
+  CID ffiCommitment(const std::string &path, UnpaddedPieceSize size) {
+    PieceData piece{path, O_RDONLY};
+    auto res{common::ffi::wrap(
+        fil_generate_piece_commitment(
+            fil_RegisteredSealProof_StackedDrg32GiBV1, piece.getFd(), size),
+        fil_destroy_generate_piece_commitment_response)};
+    if (res->status_code != FCPResponseStatus::FCPResponseStatus_FCPNoError) {
+      throw std::runtime_error{res->error_msg};
+    }
+    return primitives::cid::dataCommitmentV1ToCID(
+               gsl::make_span(res->comm_p,
+                              primitives::cid::kCommitmentBytesLen))
+        .value();
+  }
+}  // namespace fc::proofs
+
+/**
+ * Measures piece commitment throughput of native single-threaded,
+ * native parallel and ffi implementations, and checks they are equal.
+ * Piece size is given in MiB of padded bytes.
+ */
+int main(int argc, char **argv) {
+  using namespace fc::proofs;
+  using fc::common::benchBytes;
+  using fc::primitives::piece::PaddedPieceSize;
+  uint64_t mib{argc > 1 ? std::stoull(argv[1]) : 256};
+  UnpaddedPieceSize size{PaddedPieceSize{mib << 20}.unpadded()};
+  if (!size.validate()) {
+    fmt::print("piece size must be power of two\n");
+    return 1;
+  }
+
+  auto path{(fs::temp_directory_path() / fs::unique_path()).string()};
+  auto _remove{gsl::finally([&] { fs::remove(path); })};
+  {
+    std::mt19937_64 random;
+    std::vector<uint64_t> chunk(1 << 16);
+    std::ofstream file{path, std::ios::binary};
+    for (uint64_t left{size}; left != 0;) {
+      std::generate(chunk.begin(), chunk.end(), std::ref(random));
+      auto n{std::min<uint64_t>(left, chunk.size() * sizeof(uint64_t))};
+      file.write((const char *)chunk.data(), n);
+      left -= n;
+    }
+  }
+
+  auto commp{[&](size_t parallel) {
+    PieceData piece{path, O_RDONLY};
+    return generatePieceCommitment(piece.getFd(), size, parallel).value();
+  }};
+  auto single{benchBytes("native 1 thread", size, [&] { return commp(1); })};
+  auto parallel{benchBytes(fmt::format("native {} threads",
+                                       std::thread::hardware_concurrency()),
+                           size,
+                           [&] { return commp(0); })};
+  auto ffi{
+      benchBytes("ffi", size, [&] { return ffiCommitment(path, size); })};
+  if (single != ffi || parallel != ffi) {
+    fmt::print("commitment mismatch\n");
+    return 1;
+  }
+}
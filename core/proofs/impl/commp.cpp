@@ -0,0 +1,219 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "proofs/commp.hpp"
+
+#include <openssl/sha.h>
+#include <unistd.h>
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <cerrno>
+#include <thread>
+
+#include "common/bitsutil.hpp"
+#include "primitives/cid/comm_cid.hpp"
+#include "primitives/piece/piece_data.hpp"
+#include "proofs/proofs_error.hpp"
+#include "sector_storage/zerocomm/zerocomm.hpp"
+
+namespace fc::proofs {
+  using common::countTrailingZeros;
+  using primitives::cid::CIDToPieceCommitmentV1;
+  using primitives::cid::dataCommitmentV1ToCID;
+  using primitives::piece::PaddedPieceSize;
+  using sector_storage::zerocomm::getZeroPieceCommitment;
+
+  namespace {
+    constexpr size_t kNode{32};
+    // padded fr32 chunk of 127 unpadded bytes is subtree of 4 nodes
+    constexpr size_t kChunkUnpadded{127};
+    constexpr size_t kChunkPadded{128};
+    constexpr size_t kChunkLevel{2};
+    constexpr size_t kBatchLevel{15};
+    // zero commitments are known up to 32GiB * 2^6 pieces
+    constexpr size_t kMaxLevel{37};
+    static_assert(kNode << kBatchLevel == CommP::kBatchPadded);
+    static_assert(kNode << kChunkLevel == kChunkPadded);
+
+    /**
+     * Hashes two adjacent nodes into parent, input may overlap output.
+     * Uses sha256 context directly, one-shot `SHA256` looks up digest
+     * implementation on each call.
+     */
+    inline void hashNodes(const uint8_t *nodes, uint8_t *parent) {
+      SHA256_CTX ctx;
+      SHA256_Init(&ctx);
+      SHA256_Update(&ctx, nodes, 2 * kNode);
+      SHA256_Final(parent, &ctx);
+      parent[kNode - 1] &= 0x3f;
+    }
+
+    /** Reduces `count` (power of two) adjacent nodes to root in place */
+    inline void reduce(uint8_t *nodes, size_t count) {
+      for (; count > 1; count /= 2) {
+        for (size_t i{0}; i < count / 2; ++i) {
+          hashNodes(nodes + 2 * kNode * i, nodes + kNode * i);
+        }
+      }
+    }
+
+    const Hash256 &zeroHash(size_t level) {
+      static const auto zeros{[] {
+        std::array<Hash256, kMaxLevel> zeros{};
+        uint8_t nodes[2 * kNode]{};
+        hashNodes(nodes, zeros[1].data());
+        for (size_t level{kChunkLevel}; level < kMaxLevel; ++level) {
+          zeros[level] = CIDToPieceCommitmentV1(
+                             getZeroPieceCommitment(
+                                 PaddedPieceSize{kNode << level}.unpadded())
+                                 .value())
+                             .value();
+        }
+        return zeros;
+      }()};
+      return zeros.at(level);
+    }
+
+    Hash256 batchRoot(const std::vector<uint8_t> &batch) {
+      thread_local std::vector<uint8_t> padded(CommP::kBatchPadded);
+      primitives::piece::pad(batch, padded);
+      reduce(padded.data(), CommP::kBatchPadded / kNode);
+      Hash256 root;
+      std::copy_n(padded.begin(), kNode, root.begin());
+      return root;
+    }
+
+    boost::asio::thread_pool &pool() {
+      static boost::asio::thread_pool pool{
+          std::max(1u, std::thread::hardware_concurrency())};
+      return pool;
+    }
+  }  // namespace
+
+  CommP::CommP(size_t parallel)
+      : parallel_{parallel != 0
+                      ? parallel
+                      : std::max(1u, std::thread::hardware_concurrency())} {
+    batch_.reserve(kBatchUnpadded);
+  }
+
+  void CommP::update(BytesIn input) {
+    count_ += input.size();
+    while (!input.empty()) {
+      auto n{std::min<size_t>(input.size(), kBatchUnpadded - batch_.size())};
+      batch_.insert(batch_.end(), input.begin(), input.begin() + n);
+      input = input.subspan(n);
+      if (batch_.size() == kBatchUnpadded) {
+        flush();
+      }
+    }
+  }
+
+  uint64_t CommP::count() const {
+    return count_;
+  }
+
+  outcome::result<CID> CommP::finish(UnpaddedPieceSize size) {
+    OUTCOME_TRY(size.validate());
+    if (count_ > size) {
+      return ProofsError::kOutOfBound;
+    }
+    while (!pending_.empty()) {
+      pop();
+    }
+    if (!batch_.empty()) {
+      // last batch is zero filled to whole fr32 chunks
+      batch_.resize((batch_.size() + kChunkUnpadded - 1) / kChunkUnpadded
+                    * kChunkUnpadded);
+      std::vector<uint8_t> padded(batch_.size() / kChunkUnpadded
+                                  * kChunkPadded);
+      primitives::piece::pad(batch_, padded);
+      Hash256 hash;
+      for (auto it{padded.begin()}; it != padded.end(); it += kChunkPadded) {
+        reduce(&*it, kChunkPadded / kNode);
+        std::copy_n(it, kNode, hash.begin());
+        push(hash, kChunkLevel);
+      }
+      batch_.clear();
+    }
+    auto level{countTrailingZeros(size.padded()) - countTrailingZeros(kNode)};
+    for (size_t i{0}; i < level && i < layers_.size(); ++i) {
+      if (layers_[i]) {
+        push(zeroHash(i), i);
+      }
+    }
+    auto root{level < layers_.size() && layers_[level] ? *layers_[level]
+                                                       : zeroHash(level)};
+    layers_.clear();
+    count_ = 0;
+    return dataCommitmentV1ToCID(root);
+  }
+
+  void CommP::flush() {
+    if (parallel_ == 1) {
+      push(batchRoot(batch_), kBatchLevel);
+      batch_.clear();
+      return;
+    }
+    if (pending_.size() >= parallel_) {
+      pop();
+    }
+    auto task{std::make_shared<std::packaged_task<Hash256()>>(
+        [batch{std::move(batch_)}] { return batchRoot(batch); })};
+    pending_.push_back(task->get_future());
+    boost::asio::post(pool(), [task] { (*task)(); });
+    batch_ = {};
+    batch_.reserve(kBatchUnpadded);
+  }
+
+  void CommP::pop() {
+    push(pending_.front().get(), kBatchLevel);
+    pending_.pop_front();
+  }
+
+  void CommP::push(Hash256 hash, size_t level) {
+    uint8_t nodes[2 * kNode];
+    for (;; ++level) {
+      if (layers_.size() <= level) {
+        layers_.resize(level + 1);
+      }
+      auto &layer{layers_[level]};
+      if (!layer) {
+        layer = hash;
+        return;
+      }
+      std::copy(layer->begin(), layer->end(), nodes);
+      std::copy(hash.begin(), hash.end(), nodes + kNode);
+      hashNodes(nodes, hash.data());
+      layer.reset();
+    }
+  }
+
+  outcome::result<CID> generatePieceCommitment(int fd,
+                                               UnpaddedPieceSize size,
+                                               size_t parallel) {
+    if (fd == primitives::piece::kUnopenedFileDescriptor) {
+      return ProofsError::kCannotOpenFile;
+    }
+    CommP commp{parallel};
+    std::vector<uint8_t> buffer(CommP::kBatchUnpadded);
+    while (commp.count() < size) {
+      auto n{::read(fd,
+                    buffer.data(),
+                    std::min<uint64_t>(buffer.size(), size - commp.count()))};
+      if (n == -1 && errno == EINTR) {
+        continue;
+      }
+      if (n == -1) {
+        return ProofsError::kNotReadEnough;
+      }
+      if (n == 0) {
+        break;
+      }
+      commp.update(gsl::make_span(buffer.data(), n));
+    }
+    return commp.finish(size);
+  }
+}  // namespace fc::proofs
@@ -6,11 +6,11 @@
 #include "proofs/impl/proof_engine_impl.hpp"
 
 #include <filecoin-ffi/filcrypto.h>
-#include <thread>
 
 #include "common/ffi.hpp"
 #include "primitives/address/address_codec.hpp"
 #include "primitives/cid/comm_cid.hpp"
+#include "proofs/commp.hpp"
 #include "proofs/proofs_error.hpp"
 #include "sector_storage/zerocomm/zerocomm.hpp"
 
@@ -664,55 +664,24 @@ namespace fc::proofs {
 
   outcome::result<CID> ProofEngineImpl::generatePieceCID(
       RegisteredSealProof proof_type, gsl::span<const uint8_t> data) {
-    assert(UnpaddedPieceSize(data.size()).validate());
+    OUTCOME_TRY(cRegisteredSealProof(proof_type));
 
-    int fds[2];
-    if (pipe(fds) < 0) {
-      return ProofsError::kCannotCreatePipe;
-    }
-
-    std::error_code ec;
-    std::thread t([output = PieceData(fds[1]), &data, &ec]() {
-      if (write(output.getFd(), (char *)data.data(), data.size()) == -1) {
-        ec = ProofsError::kCannotWriteData;
-      }
-    });
-
-    auto maybe_cid = generatePieceCID(
-        proof_type, PieceData(fds[0]), UnpaddedPieceSize(data.size()));
-
-    t.join();
-
-    if (ec) {
-      return ec;
-    }
-
-    return maybe_cid;
+    CommP commp;
+    commp.update(data);
+    return commp.finish(UnpaddedPieceSize(data.size()));
   }
 
   outcome::result<CID> ProofEngineImpl::generatePieceCID(
       RegisteredSealProof proof_type,
       const PieceData &piece,
       UnpaddedPieceSize piece_size) {
-    OUTCOME_TRY(c_proof_type, cRegisteredSealProof(proof_type));
+    OUTCOME_TRY(cRegisteredSealProof(proof_type));
 
     if (!piece.isOpened()) {
       return ProofsError::kCannotOpenFile;
     }
 
-    auto res_ptr = ffi::wrap(
-        fil_generate_piece_commitment(c_proof_type, piece.getFd(), piece_size),
-        fil_destroy_generate_piece_commitment_response);
-
-    if (res_ptr->status_code
-        != FCPResponseStatus::FCPResponseStatus_FCPNoError) {
-      logger_->error("GeneratePieceCIDFromFile: "
-                     + std::string(res_ptr->error_msg));
-      return cppResponseStatus(res_ptr->status_code);
-    }
-
-    return dataCommitmentV1ToCID(
-        gsl::make_span(res_ptr->comm_p, kCommitmentBytesLen));
+    return generatePieceCommitment(piece.getFd(), piece_size);
   }
 
   outcome::result<CID> ProofEngineImpl::generateUnsealedCID(
@@ -5,11 +5,21 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "api/rpc/ws.hpp"
 #include "sector_storage/stores/store.hpp"
 
 namespace fc::sector_storage {
 
+  /**
+   * Parses single byte range of `Range` header value, "bytes=first-last",
+   * "bytes=first-" or "bytes=-suffix".
+   * @return [begin, end) within size, none if invalid or not satisfiable
+   */
+  boost::optional<std::pair<uint64_t, uint64_t>> parseRange(
+      const std::string &header, uint64_t size);
+
   api::RouteHandler serveHttp(
       const std::shared_ptr<stores::LocalStore> &local_store);
 
@@ -7,6 +7,7 @@
 
 #include <boost/filesystem.hpp>
 #include <regex>
+#include <spdlog/fmt/fmt.h>
 #include "api/rpc/json.hpp"
 #include "codec/json/json.hpp"
 #include "common/logger.hpp"
@@ -36,6 +37,34 @@ namespace fc::sector_storage {
     return api::WrapperResponse(std::move(response));
   }
 
+  boost::optional<std::pair<uint64_t, uint64_t>> parseRange(
+      const std::string &header, uint64_t size) {
+    static const std::regex range_rgx(R"(bytes=(\d{0,19})-(\d{0,19}))");
+    std::smatch matches;
+    if (!std::regex_match(header, matches, range_rgx)) {
+      return boost::none;
+    }
+    auto first{matches[1].str()};
+    auto last{matches[2].str()};
+    if (first.empty()) {
+      if (last.empty()) {
+        return boost::none;
+      }
+      auto suffix{std::min<uint64_t>(std::stoull(last), size)};
+      if (suffix == 0) {
+        return boost::none;
+      }
+      return std::make_pair(size - suffix, size);
+    }
+    auto begin{std::stoull(first)};
+    auto end{last.empty() ? size
+                          : std::min<uint64_t>(std::stoull(last) + 1, size)};
+    if (begin >= end) {
+      return boost::none;
+    }
+    return std::make_pair(begin, end);
+  }
+
   api::WrapperResponse remoteStatFs(
       const http::request<http::dynamic_body> &request,
       const std::shared_ptr<stores::LocalStore> &local_store,
@@ -120,8 +149,9 @@ namespace fc::sector_storage {
     std::string response_file = maybe_path.value();
 
     std::function<void()> clear_function;
-    http::response<http::file_body> response;
+    http::response<api::FileRangeBody> response;
     setupResponse(request, response);
+    response.set(http::field::accept_ranges, "bytes");
     if (boost::filesystem::is_directory(maybe_path.value())) {
       auto temp_file = fs::temp_directory_path() / fs::unique_path();
       clear_function = [temp_file]() {
@@ -142,12 +172,33 @@ namespace fc::sector_storage {
     }
 
     boost::system::error_code ec;
-    response.body().open(
-        response_file.c_str(), boost::beast::file_mode::scan, ec);
+    auto &body{response.body()};
+    body.file.open(response_file.c_str(), boost::beast::file_mode::scan, ec);
     if (ec.failed()) {
       logger->error("Error remote get sector: {}", ec.message());
       return makeErrorResponse(request, http::status::internal_server_error);
     }
+    const auto size{body.file.size(ec)};
+    if (ec.failed()) {
+      logger->error("Error remote get sector: {}", ec.message());
+      return makeErrorResponse(request, http::status::internal_server_error);
+    }
+    body.length = size;
+
+    // resumed or parallel fetch requests part of file
+    const auto range_header{request[http::field::range]};
+    if (!range_header.empty()) {
+      auto range{parseRange(range_header.to_string(), size)};
+      if (!range) {
+        return makeErrorResponse(request, http::status::range_not_satisfiable);
+      }
+      body.offset = range->first;
+      body.length = range->second - range->first;
+      response.result(http::status::partial_content);
+      response.set(
+          http::field::content_range,
+          fmt::format("bytes {}-{}/{}", range->first, range->second - 1, size));
+    }
     return api::WrapperResponse(std::move(response), std::move(clear_function));
   }
 
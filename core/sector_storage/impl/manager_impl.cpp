@@ -19,7 +19,6 @@
 #include "sector_storage/impl/existing_selector.hpp"
 #include "sector_storage/impl/local_worker.hpp"
 #include "sector_storage/impl/task_selector.hpp"
-#include "sector_storage/stores/store_error.hpp"
 
 namespace fc::sector_storage {
   using fc::primitives::sector_file::SectorFileType;
@@ -41,39 +40,6 @@ namespace fc::sector_storage {
     return fc::outcome::success();
   }
 
-  void addCachePathsForSectorSize(
-      std::unordered_map<std::string, uint64_t> &check,
-      const std::string &cache_dir,
-      SectorSize ssize,
-      const fc::common::Logger &logger) {
-    switch (ssize) {
-      case SectorSize(2) << 10:
-      case SectorSize(8) << 20:
-      case SectorSize(512) << 20:
-        check[(fs::path(cache_dir) / "sc-02-data-tree-r-last.dat").string()] =
-            0;
-        break;
-      case SectorSize(32) << 30:
-        for (int i = 0; i < 8; i++) {
-          check[(fs::path(cache_dir)
-                 / ("sc-02-data-tree-r-last-" + std::to_string(i) + ".dat"))
-                    .string()] = 0;
-        }
-        break;
-      case SectorSize(64) << 30:
-        for (int i = 0; i < 16; i++) {
-          check[(fs::path(cache_dir)
-                 / ("sc-02-data-tree-r-last-" + std::to_string(i) + ".dat"))
-                    .string()] = 0;
-        }
-        break;
-      default:
-        logger->warn("not checking cache files of {} sectors for faults",
-                     ssize);
-        break;
-    }
-  }
-
   fc::outcome::result<std::string> expandPath(const std::string &path) {
     if (path.empty() || path[0] != '~') return path;
 
@@ -95,88 +61,7 @@ namespace fc::sector_storage {
 
   outcome::result<std::vector<SectorId>> ManagerImpl::checkProvable(
       RegisteredSealProof seal_proof_type, gsl::span<const SectorId> sectors) {
-    std::vector<SectorId> bad{};
-
-    OUTCOME_TRY(ssize, primitives::sector::getSectorSize(seal_proof_type));
-
-    for (const auto &sector : sectors) {
-      auto locked = index_->storageTryLock(
-          sector,
-          static_cast<SectorFileType>(SectorFileType::FTSealed
-                                      | SectorFileType::FTCache),
-          SectorFileType::FTNone);
-
-      if (!locked) {
-        logger_->warn("can't acquire read lock for {} sector",
-                      sectorName(sector));
-        bad.push_back(sector);
-        continue;
-      }
-
-      auto maybe_response = local_store_->acquireSector(
-          sector,
-          seal_proof_type,
-          static_cast<SectorFileType>(SectorFileType::FTSealed
-                                      | SectorFileType::FTCache),
-          SectorFileType::FTNone,
-          PathType::kStorage,
-          AcquireMode::kMove);
-
-      if (maybe_response.has_error()) {
-        if (maybe_response
-            == outcome::failure(stores::StoreError::kNotFoundSector)) {
-          logger_->warn("cache an/or sealed paths not found for {} sector",
-                        sectorName(sector));
-          bad.push_back(sector);
-          continue;
-        }
-        return maybe_response.error();
-      }
-
-      std::unordered_map<std::string, uint64_t> to_check = {
-          {maybe_response.value().paths.sealed, 1},
-          {(fs::path(maybe_response.value().paths.cache) / "t_aux").string(),
-           0},
-          {(fs::path(maybe_response.value().paths.cache) / "p_aux").string(),
-           0},
-      };
-
-      addCachePathsForSectorSize(
-          to_check, maybe_response.value().paths.cache, ssize, logger_);
-
-      for (const auto &[path, size] : to_check) {
-        if (!fs::exists(path)) {
-          logger_->warn(
-              "{} doesnt exist for {} sector", path, sectorName(sector));
-          bad.push_back(sector);
-          break;
-        }
-
-        if (size != 0) {
-          boost::system::error_code ec;
-          size_t actual_size = fs::file_size(path, ec);
-          if (ec.failed()) {
-            logger_->warn("sector {}. Can't get size for {}: {}",
-                          sectorName(sector),
-                          path,
-                          ec.message());
-            bad.push_back(sector);
-            break;
-          }
-
-          if (actual_size != ssize * size) {
-            logger_->warn(
-                "sector {}. Actual and declared sizes do not match for {}",
-                sectorName(sector),
-                path);
-            bad.push_back(sector);
-            break;
-          }
-        }
-      }
-    }
-
-    return std::move(bad);
+    return checker_->checkProvable(seal_proof_type, sectors);
   }
 
   SectorSize ManagerImpl::getSectorSize() {
@@ -677,12 +562,14 @@ namespace fc::sector_storage {
       const std::shared_ptr<stores::RemoteStore> &remote,
       const std::shared_ptr<Scheduler> &scheduler,
       const SealerConfig &config,
+      const std::shared_ptr<FaultTracker> &checker,
       const std::shared_ptr<proofs::ProofEngine> &proofs) {
     struct make_unique_enabler : public ManagerImpl {
       make_unique_enabler(std::shared_ptr<stores::SectorIndex> sector_index,
                           RegisteredSealProof seal_proof_type,
                           std::shared_ptr<stores::LocalStorage> local_storage,
                           std::shared_ptr<stores::LocalStore> local_store,
+                          std::shared_ptr<FaultTracker> checker,
                           std::shared_ptr<stores::RemoteStore> store,
                           std::shared_ptr<Scheduler> scheduler,
                           std::shared_ptr<proofs::ProofEngine> proofs)
@@ -690,6 +577,7 @@ namespace fc::sector_storage {
                         seal_proof_type,
                         std::move(local_storage),
                         std::move(local_store),
+                        std::move(checker),
                         std::move(store),
                         std::move(scheduler),
                         std::move(proofs)} {};
@@ -704,6 +592,7 @@ namespace fc::sector_storage {
                                               proof_type,
                                               local_storage,
                                               local_store,
+                                              checker,
                                               remote,
                                               scheduler,
                                               proofs);
@@ -749,6 +638,7 @@ namespace fc::sector_storage {
                            RegisteredSealProof seal_proof_type,
                            std::shared_ptr<stores::LocalStorage> local_storage,
                            std::shared_ptr<stores::LocalStore> local_store,
+                           std::shared_ptr<FaultTracker> checker,
                            std::shared_ptr<stores::RemoteStore> store,
                            std::shared_ptr<Scheduler> scheduler,
                            std::shared_ptr<proofs::ProofEngine> proofs)
@@ -756,6 +646,7 @@ namespace fc::sector_storage {
         seal_proof_type_(seal_proof_type),
         local_storage_(std::move(local_storage)),
         local_store_(std::move(local_store)),
+        checker_(std::move(checker)),
         remote_store_(std::move(store)),
         scheduler_(std::move(scheduler)),
         logger_(common::createLogger("manager")),
@@ -25,10 +25,14 @@ namespace fc::sector_storage {
 
   class ManagerImpl : public Manager {
    public:
+    /**
+     * @param checker - checks provable sectors, shared with window post
+     */
     static outcome::result<std::shared_ptr<Manager>> newManager(
         const std::shared_ptr<stores::RemoteStore> &remote,
         const std::shared_ptr<Scheduler> &scheduler,
         const SealerConfig &config,
+        const std::shared_ptr<FaultTracker> &checker,
         const std::shared_ptr<proofs::ProofEngine> &proofs =
             std::make_shared<proofs::ProofEngineImpl>());
 
@@ -108,6 +112,7 @@ namespace fc::sector_storage {
                 RegisteredSealProof seal_proof_type,
                 std::shared_ptr<stores::LocalStorage> local_storage,
                 std::shared_ptr<stores::LocalStore> local_store,
+                std::shared_ptr<FaultTracker> checker,
                 std::shared_ptr<stores::RemoteStore> store,
                 std::shared_ptr<Scheduler> scheduler,
                 std::shared_ptr<proofs::ProofEngine> proofs);
@@ -140,6 +145,7 @@ namespace fc::sector_storage {
 
     std::shared_ptr<stores::LocalStorage> local_storage_;
     std::shared_ptr<stores::LocalStore> local_store_;
+    std::shared_ptr<FaultTracker> checker_;
     std::shared_ptr<stores::RemoteStore> remote_store_;
 
     std::shared_ptr<Scheduler> scheduler_;
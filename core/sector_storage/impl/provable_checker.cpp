@@ -0,0 +1,391 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sector_storage/impl/provable_checker.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <random>
+#include <thread>
+#include <unordered_map>
+
+#include "sector_storage/stores/store_error.hpp"
+
+namespace fc::sector_storage {
+  using primitives::SectorSize;
+  using primitives::sector_file::SectorFileType;
+  using primitives::sector_file::SectorPaths;
+  using primitives::sector_file::sectorName;
+  using stores::AcquireMode;
+  using stores::PathType;
+  namespace fs = boost::filesystem;
+
+  namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr auto kSealedAndCache{static_cast<SectorFileType>(
+        SectorFileType::FTSealed | SectorFileType::FTCache)};
+    constexpr uint64_t kNode{32};
+
+    /** Sectors of one `checkProvable` call */
+    struct Run {
+      size_t remaining{};
+      std::vector<SectorId> bad;
+    };
+
+    struct Task {
+      std::shared_ptr<Run> run;
+      SectorPaths paths;
+      SectorSize ssize{};
+      ProvableChecker::CheckSector check;
+    };
+
+    /** Thread of path pool, task is set while checking */
+    struct Worker {
+      boost::optional<Task> task;
+      Clock::time_point started;
+      bool hung{false};
+    };
+
+    /** Threads checking sectors of one storage path */
+    struct Path {
+      StorageID id;
+      std::shared_ptr<ProvableChecker::Stats> stats;
+      std::condition_variable cv;
+      std::deque<Task> queue;
+      std::list<Worker> workers;
+      size_t hung{};
+    };
+
+    void addCachePathsForSectorSize(
+        std::unordered_map<std::string, uint64_t> &check,
+        const std::string &cache_dir,
+        SectorSize ssize,
+        const common::Logger &logger) {
+      switch (ssize) {
+        case SectorSize(2) << 10:
+        case SectorSize(8) << 20:
+        case SectorSize(512) << 20:
+          check[(fs::path(cache_dir) / "sc-02-data-tree-r-last.dat")
+                    .string()] = 0;
+          break;
+        case SectorSize(32) << 30:
+          for (int i = 0; i < 8; i++) {
+            check[(fs::path(cache_dir)
+                   / ("sc-02-data-tree-r-last-" + std::to_string(i) + ".dat"))
+                      .string()] = 0;
+          }
+          break;
+        case SectorSize(64) << 30:
+          for (int i = 0; i < 16; i++) {
+            check[(fs::path(cache_dir)
+                   / ("sc-02-data-tree-r-last-" + std::to_string(i) + ".dat"))
+                      .string()] = 0;
+          }
+          break;
+        default:
+          logger->warn("not checking cache files of {} sectors for faults",
+                       ssize);
+          break;
+      }
+    }
+
+    /** Reads random node of sealed replica, so file is not only listed */
+    bool readChallenge(const SectorPaths &paths,
+                       SectorSize ssize,
+                       const common::Logger &logger) {
+      thread_local std::mt19937_64 random{std::random_device{}()};
+      std::uniform_int_distribution<uint64_t> nodes{0, ssize / kNode - 1};
+      auto node{nodes(random)};
+      auto fd{::open(paths.sealed.c_str(), O_RDONLY)};
+      if (fd == -1) {
+        logger->warn("sector {}. Can't open {}: {}",
+                     sectorName(paths.id),
+                     paths.sealed,
+                     strerror(errno));
+        return false;
+      }
+      uint8_t bytes[kNode];
+      auto read{::pread(fd, bytes, kNode, node * kNode)};
+      ::close(fd);
+      if (read != kNode) {
+        logger->warn("sector {}. Can't read node {} of {}",
+                     sectorName(paths.id),
+                     node,
+                     paths.sealed);
+        return false;
+      }
+      return true;
+    }
+
+    bool checkSector(const SectorPaths &paths,
+                     SectorSize ssize,
+                     bool read_challenge,
+                     const common::Logger &logger) {
+      std::unordered_map<std::string, uint64_t> to_check = {
+          {paths.sealed, 1},
+          {(fs::path(paths.cache) / "t_aux").string(), 0},
+          {(fs::path(paths.cache) / "p_aux").string(), 0},
+      };
+
+      addCachePathsForSectorSize(to_check, paths.cache, ssize, logger);
+
+      for (const auto &[path, size] : to_check) {
+        if (!fs::exists(path)) {
+          logger->warn(
+              "{} doesnt exist for {} sector", path, sectorName(paths.id));
+          return false;
+        }
+
+        if (size != 0) {
+          boost::system::error_code ec;
+          size_t actual_size = fs::file_size(path, ec);
+          if (ec.failed()) {
+            logger->warn("sector {}. Can't get size for {}: {}",
+                         sectorName(paths.id),
+                         path,
+                         ec.message());
+            return false;
+          }
+
+          if (actual_size != ssize * size) {
+            logger->warn(
+                "sector {}. Actual and declared sizes do not match for {}",
+                sectorName(paths.id),
+                path);
+            return false;
+          }
+        }
+      }
+
+      return !read_challenge || readChallenge(paths, ssize, logger);
+    }
+  }  // namespace
+
+  struct ProvableChecker::Pools {
+    std::mutex mutex;
+    /** Notified when sector check of any run completes */
+    std::condition_variable done;
+    bool stop{false};
+    std::map<StorageID, std::shared_ptr<Path>> paths;
+
+    /** Checks queued sectors of path until stopped */
+    static void work(const std::shared_ptr<Pools> &pools,
+                     const std::shared_ptr<Path> &path,
+                     std::list<Worker>::iterator worker) {
+      std::unique_lock lock{pools->mutex};
+      while (true) {
+        path->cv.wait(lock,
+                      [&] { return pools->stop || !path->queue.empty(); });
+        if (pools->stop) {
+          break;
+        }
+        worker->task = std::move(path->queue.front());
+        path->queue.pop_front();
+        auto start{Clock::now()};
+        worker->started = start;
+        auto &task{*worker->task};
+        lock.unlock();
+        auto ok{task.check(task.paths, task.ssize)};
+        auto latency{std::chrono::duration_cast<std::chrono::microseconds>(
+            Clock::now() - start)};
+        lock.lock();
+        if (worker->hung) {
+          // sector was already failed by timeout
+          worker->hung = false;
+          --path->hung;
+        } else {
+          path->stats->observe(latency);
+          if (!ok) {
+            ++path->stats->faulty;
+            task.run->bad.push_back(task.paths.id);
+          }
+          --task.run->remaining;
+          pools->done.notify_all();
+        }
+        worker->task.reset();
+      }
+      path->workers.erase(worker);
+    }
+  };
+
+  void ProvableChecker::Stats::observe(std::chrono::microseconds latency) {
+    uint64_t us = latency.count();
+    auto bucket{std::find_if(kBucketsMs.begin(),
+                             kBucketsMs.end(),
+                             [&](auto ms) { return us <= ms * 1000; })
+                - kBucketsMs.begin()};
+    ++buckets[bucket];
+    sum_us += us;
+    ++count;
+  }
+
+  ProvableChecker::ProvableChecker(
+      std::shared_ptr<stores::SectorIndex> index,
+      std::shared_ptr<stores::LocalStore> local_store,
+      ProvableCheckerConfig config,
+      CheckSector check)
+      : index_{std::move(index)},
+        local_store_{std::move(local_store)},
+        config_{config},
+        check_{std::move(check)},
+        pools_{std::make_shared<Pools>()},
+        logger_{common::createLogger("provable checker")} {
+    config_.per_path = std::max<size_t>(1, config_.per_path);
+    if (!check_) {
+      check_ = [read_challenge{config_.read_challenge}, logger{logger_}](
+                   const SectorPaths &paths, SectorSize ssize) {
+        return checkSector(paths, ssize, read_challenge, logger);
+      };
+    }
+  }
+
+  ProvableChecker::~ProvableChecker() {
+    // hung threads exit when their checks return
+    std::lock_guard lock{pools_->mutex};
+    pools_->stop = true;
+    for (auto &[id, path] : pools_->paths) {
+      path->cv.notify_all();
+    }
+  }
+
+  outcome::result<std::vector<SectorId>> ProvableChecker::checkProvable(
+      RegisteredSealProof seal_proof_type, gsl::span<const SectorId> sectors) {
+    OUTCOME_TRY(ssize, primitives::sector::getSectorSize(seal_proof_type));
+
+    auto run{std::make_shared<Run>()};
+    std::vector<std::unique_ptr<stores::WLock>> locks;
+    std::map<StorageID, std::vector<SectorPaths>> sectors_by_path;
+    for (const auto &sector : sectors) {
+      auto locked = index_->storageTryLock(
+          sector, kSealedAndCache, SectorFileType::FTNone);
+
+      if (!locked) {
+        logger_->warn("can't acquire read lock for {} sector",
+                      sectorName(sector));
+        run->bad.push_back(sector);
+        continue;
+      }
+
+      auto maybe_response = local_store_->acquireSector(sector,
+                                                        seal_proof_type,
+                                                        kSealedAndCache,
+                                                        SectorFileType::FTNone,
+                                                        PathType::kStorage,
+                                                        AcquireMode::kMove);
+
+      if (maybe_response.has_error()) {
+        if (maybe_response
+            == outcome::failure(stores::StoreError::kNotFoundSector)) {
+          logger_->warn("cache an/or sealed paths not found for {} sector",
+                        sectorName(sector));
+          run->bad.push_back(sector);
+          continue;
+        }
+        return maybe_response.error();
+      }
+
+      auto &response{maybe_response.value()};
+      sectors_by_path[response.storages.sealed].push_back(
+          std::move(response.paths));
+      locks.push_back(std::move(locked));
+    }
+
+    std::unique_lock lock{pools_->mutex};
+    auto fail{[&](Path &path, const SectorId &sector) {
+      ++path.stats->timeouts;
+      run->bad.push_back(sector);
+    }};
+    std::vector<std::shared_ptr<Path>> paths;
+    for (auto &[id, path_sectors] : sectors_by_path) {
+      auto &path{pools_->paths[id]};
+      if (!path) {
+        path = std::make_shared<Path>();
+        path->id = id;
+        path->stats = pathStats(id);
+      }
+      if (path->hung >= config_.per_path) {
+        logger_->warn("all threads of storage {} are hung, failing {} sectors",
+                      id,
+                      path_sectors.size());
+        for (auto &sector : path_sectors) {
+          fail(*path, sector.id);
+        }
+        continue;
+      }
+      run->remaining += path_sectors.size();
+      for (auto &sector : path_sectors) {
+        path->queue.push_back({run, std::move(sector), ssize, check_});
+      }
+      // hung threads are not replaced beyond `per_path`
+      while (path->workers.size()
+             < std::min(config_.per_path, path->hung + path->queue.size())) {
+        path->workers.emplace_back();
+        std::thread{Pools::work, pools_, path, std::prev(path->workers.end())}
+            .detach();
+      }
+      path->cv.notify_all();
+      paths.push_back(path);
+    }
+
+    while (run->remaining != 0) {
+      auto now{Clock::now()};
+      auto deadline{now + config_.timeout};
+      for (auto &path : paths) {
+        for (auto &worker : path->workers) {
+          if (worker.hung || !worker.task || worker.task->run != run) {
+            continue;
+          }
+          auto timeout{worker.started + config_.timeout};
+          if (timeout > now) {
+            deadline = std::min(deadline, timeout);
+            continue;
+          }
+          logger_->warn("sector {} check timed out on storage {}",
+                        sectorName(worker.task->paths.id),
+                        path->id);
+          worker.hung = true;
+          ++path->hung;
+          fail(*path, worker.task->paths.id);
+          --run->remaining;
+        }
+        if (path->hung == path->workers.size()) {
+          auto &queue{path->queue};
+          auto it{std::stable_partition(
+              queue.begin(), queue.end(), [&](auto &task) {
+                return task.run != run;
+              })};
+          for (auto task{it}; task != queue.end(); ++task) {
+            fail(*path, task->paths.id);
+            --run->remaining;
+          }
+          queue.erase(it, queue.end());
+        }
+      }
+      if (run->remaining != 0) {
+        pools_->done.wait_until(lock, deadline);
+      }
+    }
+    return run->bad;
+  }
+
+  std::shared_ptr<ProvableChecker::Stats> ProvableChecker::pathStats(
+      const StorageID &id) {
+    std::lock_guard lock{mutex_};
+    auto &stats{stats_[id]};
+    if (!stats) {
+      stats = std::make_shared<Stats>();
+    }
+    return stats;
+  }
+}  // namespace fc::sector_storage
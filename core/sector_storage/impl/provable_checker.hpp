@@ -0,0 +1,96 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+
+#include "common/logger.hpp"
+#include "sector_storage/fault_tracker.hpp"
+#include "sector_storage/stores/index.hpp"
+#include "sector_storage/stores/store.hpp"
+
+namespace fc::sector_storage {
+  using primitives::StorageID;
+
+  struct ProvableCheckerConfig {
+    /** Sectors checked at once on each storage path */
+    size_t per_path{8};
+    /** Sector check running longer is failed, its thread is marked hung */
+    std::chrono::milliseconds timeout{std::chrono::seconds{30}};
+    /** Also read random node of sealed replica, not only stat files */
+    bool read_challenge{false};
+  };
+
+  /**
+   * Checks that sealed and cache files of sectors are present.
+   * Sectors are grouped by storage path of sealed file, each path is checked
+   * by long-lived pool of at most `per_path` threads, so slow or hung network
+   * storage doesn't delay other paths. Hung thread returns to pool when its
+   * check finally returns, no thread is started in its place. When all
+   * threads of path hang, its sectors are failed without checking.
+   */
+  class ProvableChecker : public FaultTracker {
+   public:
+    /** Latency histogram of sector checks on one storage path */
+    struct Stats {
+      /** Upper bounds of buckets in milliseconds, last bucket is +Inf */
+      static constexpr std::array<uint64_t, 10> kBucketsMs{
+          1, 5, 10, 50, 100, 500, 1000, 5000, 10000, 30000};
+
+      void observe(std::chrono::microseconds latency);
+
+      std::array<std::atomic_uint64_t, kBucketsMs.size() + 1> buckets{};
+      std::atomic_uint64_t sum_us{}, count{}, faulty{}, timeouts{};
+    };
+
+    /** Checks files of sector, returns false if sector is faulty */
+    using CheckSector =
+        std::function<bool(const primitives::sector_file::SectorPaths &,
+                           primitives::SectorSize)>;
+
+    /**
+     * @param check - checks sector files, by default stats and reads them
+     */
+    ProvableChecker(std::shared_ptr<stores::SectorIndex> index,
+                    std::shared_ptr<stores::LocalStore> local_store,
+                    ProvableCheckerConfig config = {},
+                    CheckSector check = {});
+    ~ProvableChecker() override;
+
+    outcome::result<std::vector<SectorId>> checkProvable(
+        RegisteredSealProof seal_proof_type,
+        gsl::span<const SectorId> sectors) override;
+
+    /** Calls `f(storage_id, stats)` for each storage path checked */
+    template <typename F>
+    void stats(const F &f) const {
+      std::lock_guard lock{mutex_};
+      for (auto &[id, stats] : stats_) {
+        f(id, *stats);
+      }
+    }
+
+   private:
+    /** Thread pools of storage paths, shared with threads */
+    struct Pools;
+
+    std::shared_ptr<Stats> pathStats(const StorageID &id);
+
+    std::shared_ptr<stores::SectorIndex> index_;
+    std::shared_ptr<stores::LocalStore> local_store_;
+    ProvableCheckerConfig config_;
+    CheckSector check_;
+    std::shared_ptr<Pools> pools_;
+    mutable std::mutex mutex_;
+    std::map<StorageID, std::shared_ptr<Stats>> stats_;
+    common::Logger logger_;
+  };
+}  // namespace fc::sector_storage
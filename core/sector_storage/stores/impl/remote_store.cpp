@@ -6,7 +6,13 @@
 #include "sector_storage/stores/impl/remote_store.hpp"
 
 #include <curl/curl.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
 #include <boost/filesystem.hpp>
+#include <cctype>
+#include <future>
 #include <utility>
 
 #include "api/rpc/json.hpp"
@@ -27,18 +33,214 @@ namespace {
     out->append(in, totalBytes);
     return totalBytes;
   }
-
-  std::size_t callbackFile(const char *ptr,
-                           std::size_t size,
-                           std::size_t nmemb,
-                           std::ofstream *stream) {
-    const std::size_t totalBytes(size * nmemb);
-    stream->write(ptr, size);
-    return totalBytes;
-  }
 }  // namespace
 
 namespace fc::sector_storage::stores {
+  namespace {
+    constexpr auto kTarType{"application/x-tar"};
+    constexpr auto kFileType{"application/octet-stream"};
+    /** Attempts to fetch each range, resuming from received bytes */
+    constexpr size_t kFetchRetries{5};
+    /** Files of at least this size are fetched by parallel range requests */
+    constexpr uint64_t kParallelFetchMinSize{1 << 30};
+    constexpr uint64_t kParallelFetchParts{8};
+    /** Stalled transfer is aborted, so it can be resumed */
+    constexpr long kLowSpeedLimit{1 << 10};
+    constexpr long kLowSpeedTimeSec{60};
+
+    /** GET request, response body is streamed to `on_body` */
+    struct HttpGet {
+      /** Returns false to stop transfer */
+      std::function<bool(BytesIn)> on_body;
+      long status{};
+      std::string content_type;
+      bool accept_ranges{false};
+      boost::optional<uint64_t> content_length;
+      /** Size of whole file from Content-Range of partial response */
+      boost::optional<uint64_t> range_total;
+      bool stopped{false};
+
+      /** Size of whole file */
+      boost::optional<uint64_t> total() const {
+        return status == 206 ? range_total : content_length;
+      }
+    };
+
+    std::size_t callbackHeader(char *ptr,
+                               std::size_t size,
+                               std::size_t num,
+                               HttpGet *get) {
+      const std::size_t total_bytes{size * num};
+      std::string line{ptr, total_bytes};
+      while (!line.empty()
+             && std::isspace(static_cast<unsigned char>(line.back()))) {
+        line.pop_back();
+      }
+      if (line.rfind("HTTP/", 0) == 0) {
+        // new response, e.g. after redirect
+        *get = HttpGet{std::move(get->on_body)};
+        auto space{line.find(' ')};
+        if (space != std::string::npos) {
+          get->status = std::strtol(line.c_str() + space + 1, nullptr, 10);
+        }
+        return total_bytes;
+      }
+      auto colon{line.find(':')};
+      if (colon == std::string::npos) {
+        return total_bytes;
+      }
+      auto name{line.substr(0, colon)};
+      std::transform(
+          name.begin(), name.end(), name.begin(), [](unsigned char c) {
+            return std::tolower(c);
+          });
+      auto value{line.substr(colon + 1)};
+      value.erase(0, value.find_first_not_of(' '));
+      if (name == "content-type") {
+        get->content_type = value.substr(0, value.find(';'));
+      } else if (name == "accept-ranges") {
+        get->accept_ranges = value == "bytes";
+      } else if (name == "content-length") {
+        get->content_length = std::strtoull(value.c_str(), nullptr, 10);
+      } else if (name == "content-range") {
+        auto slash{value.rfind('/')};
+        if (slash != std::string::npos && value[slash + 1] != '*') {
+          get->range_total =
+              std::strtoull(value.c_str() + slash + 1, nullptr, 10);
+        }
+      }
+      return total_bytes;
+    }
+
+    std::size_t callbackBody(char *ptr,
+                             std::size_t size,
+                             std::size_t num,
+                             HttpGet *get) {
+      const std::size_t total_bytes{size * num};
+      if (get->status != 200 && get->status != 206) {
+        // error description
+        return total_bytes;
+      }
+      if (!get->on_body(
+              {reinterpret_cast<const uint8_t *>(ptr),
+               static_cast<ptrdiff_t>(total_bytes)})) {
+        get->stopped = true;
+        return 0;
+      }
+      return total_bytes;
+    }
+
+    /** Performs GET of bytes [begin, end] (or to end of file if none) */
+    CURLcode performGet(
+        const std::string &url,
+        const std::unordered_map<HeaderName, HeaderValue> &auth_headers,
+        uint64_t begin,
+        boost::optional<uint64_t> end,
+        HttpGet &get) {
+      CURL *curl = curl_easy_init();
+      if (!curl) {
+        return CURLE_FAILED_INIT;
+      }
+      curl_easy_setopt(curl, CURLOPT_IPRESOLVE, CURL_IPRESOLVE_V4);
+      curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+      curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+      curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, kLowSpeedLimit);
+      curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, kLowSpeedTimeSec);
+      std::string range;
+      if (begin != 0 || end) {
+        range = std::to_string(begin) + "-"
+                + (end ? std::to_string(*end) : std::string{});
+        curl_easy_setopt(curl, CURLOPT_RANGE, range.c_str());
+      }
+      struct curl_slist *headers = nullptr;
+      for (const auto &header : auth_headers) {
+        headers = curl_slist_append(
+            headers, (header.first + ": " + header.second).c_str());
+      }
+      if (headers) {
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+      }
+      curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, callbackHeader);
+      curl_easy_setopt(curl, CURLOPT_HEADERDATA, &get);
+      curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, callbackBody);
+      curl_easy_setopt(curl, CURLOPT_WRITEDATA, &get);
+      auto code{curl_easy_perform(curl)};
+      curl_easy_cleanup(curl);
+      if (headers) {
+        curl_slist_free_all(headers);
+      }
+      return code;
+    }
+
+    bool pwriteAll(int fd, BytesIn bytes, uint64_t offset) {
+      while (!bytes.empty()) {
+        auto n{::pwrite(fd, bytes.data(), bytes.size(), offset)};
+        if (n <= 0) {
+          return false;
+        }
+        bytes = bytes.subspan(n);
+        offset += n;
+      }
+      return true;
+    }
+
+    /**
+     * Extracts tar in background while it is being received.
+     * Bytes are passed through socket pair, so archive is not stored.
+     */
+    class TarStream {
+     public:
+      ~TarStream() {
+        finish();
+      }
+
+      static outcome::result<std::unique_ptr<TarStream>> start(
+          const std::string &output_path) {
+        int fds[2];
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+          return StoreError::kCannotOpenTempFile;
+        }
+        auto stream{std::make_unique<TarStream>()};
+        stream->fd_ = fds[0];
+        stream->extracted_ =
+            std::async(std::launch::async, [fd{fds[1]}, output_path] {
+              auto result{common::extractTar(fd, output_path)};
+              // unblocks writer if archive ended before stream
+              ::close(fd);
+              return result;
+            });
+        return std::move(stream);
+      }
+
+      /** Returns false if extraction stopped reading */
+      bool write(BytesIn bytes) {
+        while (!bytes.empty()) {
+          auto n{::send(fd_, bytes.data(), bytes.size(), MSG_NOSIGNAL)};
+          if (n <= 0) {
+            return false;
+          }
+          bytes = bytes.subspan(n);
+        }
+        return true;
+      }
+
+      /** Ends stream and waits for extraction */
+      outcome::result<void> finish() {
+        if (fd_ != -1) {
+          ::close(fd_);
+          fd_ = -1;
+        }
+        if (extracted_.valid()) {
+          return extracted_.get();
+        }
+        return outcome::success();
+      }
+
+     private:
+      int fd_{-1};
+      std::future<outcome::result<void>> extracted_;
+    };
+  }  // namespace
 
   RemoteStoreImpl::RemoteStoreImpl(
       std::shared_ptr<LocalStore> local,
@@ -317,89 +519,180 @@ namespace fc::sector_storage::stores {
                                                const std::string &output_path) {
     logger_->info("fetch: {} -> {}", url, output_path);
 
-    CURL *curl = curl_easy_init();
-
-    if (!curl) {
-      return StoreError::kUnableCreateRequest;
-    }
-    curl_easy_setopt(curl, CURLOPT_IPRESOLVE, CURL_IPRESOLVE_V4);
-
-    // Follow HTTP redirects if necessary
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-
-    fs::path temp_file_path =
-        fs::temp_directory_path() / (fs::unique_path().string() + ".tar");
-
-    std::ofstream temp_file(temp_file_path.string(),
-                            std::ios_base::out | std::ios_base::binary);
-
-    if (!temp_file.good()) {
-      curl_easy_cleanup(curl);
-      return StoreError::kCannotOpenTempFile;
-    }
-
-    struct curl_slist *headers = nullptr;
-
-    for (const auto &header : auth_headers_) {
-      headers = curl_slist_append(
-          headers, (header.first + ": " + header.second).c_str());
-    }
-
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, callbackFile);
-
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &temp_file);
-
-    if (headers) {
-      curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    }
-
-    long status_code;
-    std::string content_type;
-    curl_easy_perform(curl);
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status_code);
-    curl_easy_getinfo(curl, CURLINFO_CONTENT_TYPE, &content_type);
-    curl_easy_cleanup(curl);
-    if (headers) {
-      curl_slist_free_all(headers);
-    }
-
-    temp_file.close();
-
-    if (status_code != 200) {
-      logger_->error("non-200 code - {}", status_code);
-      return StoreError::kNotOkStatusCode;
-    }
-
     boost::system::error_code ec;
     fs::remove_all(output_path, ec);
-
     if (ec.failed()) {
       logger_->error("Cannot remove output path: {}", ec.message());
       return StoreError::kCannotRemovePath;
     }
-    ec.clear();
 
-    if (content_type == "application/x-tar") {
-      auto result = common::extractTar(temp_file_path, output_path);
-      fs::remove_all(temp_file_path, ec);
-      if (ec.failed()) {
-        logger_->warn("fetch: failed to remove archive - {}", ec.message());
+    // body is extracted as it arrives, or written into output file
+    std::unique_ptr<TarStream> tar;
+    int fd{-1};
+    auto _fd{gsl::finally([&] {
+      if (fd != -1) {
+        ::close(fd);
       }
-      return result;
+    })};
+    uint64_t received{0};
+    // end of first request, rest is fetched by parallel range requests
+    boost::optional<uint64_t> first_end;
+    boost::optional<uint64_t> total;
+    bool not_resumable{false};
+    for (size_t attempt{0};; ++attempt) {
+      HttpGet get;
+      const auto begin{received};
+      auto first_body{true};
+      get.on_body = [&](BytesIn bytes) {
+        if (first_body) {
+          first_body = false;
+          if (begin != 0 && get.status != 206) {
+            // range ignored, tar stream can't be rewound
+            if (tar) {
+              not_resumable = true;
+              return false;
+            }
+            received = 0;
+          }
+          if (!total) {
+            total = get.total();
+          }
+        }
+        if (!tar && fd == -1) {
+          if (get.content_type == kTarType) {
+            auto maybe_tar{TarStream::start(output_path)};
+            if (!maybe_tar) {
+              return false;
+            }
+            tar = std::move(maybe_tar.value());
+          } else if (get.content_type == kFileType) {
+            fd = ::open(output_path.c_str(), O_WRONLY | O_CREAT, 0644);
+            if (fd == -1) {
+              return false;
+            }
+            if (get.accept_ranges && total
+                && *total >= kParallelFetchMinSize) {
+              first_end = (*total + kParallelFetchParts - 1)
+                          / kParallelFetchParts;
+            }
+          } else {
+            return false;
+          }
+        }
+        if (tar) {
+          received += bytes.size();
+          return tar->write(bytes);
+        }
+        if (first_end) {
+          bytes = bytes.first(std::min<uint64_t>(bytes.size(),
+                                                 *first_end - received));
+        }
+        if (!pwriteAll(fd, bytes, received)) {
+          return false;
+        }
+        received += bytes.size();
+        return !first_end || received < *first_end;
+      };
+      auto code{performGet(url,
+                           auth_headers_,
+                           begin,
+                           first_end ? boost::make_optional(*first_end - 1)
+                                     : boost::none,
+                           get)};
+      if (code == CURLE_FAILED_INIT) {
+        return StoreError::kUnableCreateRequest;
+      }
+      if (get.status != 0 && get.status != 200 && get.status != 206) {
+        logger_->error("non-200 code - {}", get.status);
+        return StoreError::kNotOkStatusCode;
+      }
+      if (get.status != 0 && !tar && fd == -1) {
+        if (code != CURLE_OK || get.content_type != kFileType) {
+          return StoreError::kUnknownContentType;
+        }
+        // empty file
+        fd = ::open(output_path.c_str(), O_WRONLY | O_CREAT, 0644);
+        if (fd == -1) {
+          return StoreError::kCannotOpenTempFile;
+        }
+        break;
+      }
+      if (not_resumable) {
+        logger_->error("fetch: {} doesn't support resume", url);
+        return StoreError::kNotOkStatusCode;
+      }
+      if (code == CURLE_OK
+          || (get.stopped && first_end && received >= *first_end)) {
+        break;
+      }
+      if (get.stopped && tar) {
+        // extraction failed
+        break;
+      }
+      if (attempt + 1 >= kFetchRetries) {
+        logger_->error("fetch: {} failed after {} attempts - {}",
+                       url,
+                       kFetchRetries,
+                       curl_easy_strerror(code));
+        return StoreError::kUnableRemoteAcquireSector;
+      }
+      logger_->warn("fetch: {} interrupted at {} - {}, resuming",
+                    url,
+                    received,
+                    curl_easy_strerror(code));
     }
 
-    if (content_type == "application/octet-stream") {
-      fs::rename(temp_file_path, output_path, ec);
-      if (ec.failed()) {
-        logger_->error("Cannot move file: {}", ec.message());
-        return StoreError::kCannotMoveFile;
+    if (tar) {
+      return tar->finish();
+    }
+
+    if (first_end) {
+      std::vector<std::future<outcome::result<void>>> parts;
+      for (auto begin{*first_end}; begin < *total; begin += *first_end) {
+        auto end{std::min(begin + *first_end, *total)};
+        parts.push_back(std::async(std::launch::async, [&, begin, end] {
+          return fetchRange(url, fd, begin, end);
+        }));
+      }
+      for (auto &part : parts) {
+        OUTCOME_TRY(part.get());
       }
-      return outcome::success();
     }
+    return outcome::success();
+  }
 
-    return StoreError::kUnknownContentType;
+  outcome::result<void> RemoteStoreImpl::fetchRange(const std::string &url,
+                                                    int fd,
+                                                    uint64_t begin,
+                                                    uint64_t end) const {
+    auto offset{begin};
+    for (size_t attempt{0}; attempt < kFetchRetries; ++attempt) {
+      HttpGet get;
+      get.on_body = [&](BytesIn bytes) {
+        if (get.status != 206) {
+          return false;
+        }
+        bytes = bytes.first(std::min<uint64_t>(bytes.size(), end - offset));
+        if (!pwriteAll(fd, bytes, offset)) {
+          return false;
+        }
+        offset += bytes.size();
+        return offset < end;
+      };
+      auto code{performGet(url, auth_headers_, offset, end - 1, get)};
+      if (offset >= end) {
+        return outcome::success();
+      }
+      if (get.status != 0 && get.status != 206) {
+        logger_->error("fetch range: non-206 code - {}", get.status);
+        return StoreError::kNotOkStatusCode;
+      }
+      logger_->warn("fetch range: {} interrupted at {} - {}, resuming",
+                    url,
+                    offset,
+                    curl_easy_strerror(code));
+    }
+    return StoreError::kUnableRemoteAcquireSector;
   }
 
   outcome::result<void> RemoteStoreImpl::deleteFromRemote(
@@ -48,9 +48,20 @@ namespace fc::sector_storage::stores {
                                                    SectorFileType file_type,
                                                    const std::string &dest);
 
+    /**
+     * Fetches file or directory, tar of directory is extracted as it arrives.
+     * Interrupted transfers are resumed with range requests, large files are
+     * fetched by several parallel range requests.
+     */
     outcome::result<void> fetch(const std::string &url,
                                 const std::string &output_path);
 
+    /** Fetches bytes [begin, end) of file into `fd` */
+    outcome::result<void> fetchRange(const std::string &url,
+                                     int fd,
+                                     uint64_t begin,
+                                     uint64_t end) const;
+
     outcome::result<void> deleteFromRemote(const std::string &url);
 
     std::shared_ptr<LocalStore> local_;
@@ -22,6 +22,7 @@ namespace fc::storage::amt {
     kNotFound,
     kRootBitsWrong,
     kNodeBitsWrong,
+    kNotSorted,
   };
 }  // namespace fc::storage::amt
 
@@ -59,12 +60,27 @@ namespace fc::storage::amt {
    public:
     using Visitor =
         std::function<outcome::result<void>(uint64_t, const Value &)>;
+    /// Called with key and its values before and after, none if absent
+    using DiffVisitor =
+        std::function<outcome::result<void>(uint64_t,
+                                            const boost::optional<Value> &,
+                                            const boost::optional<Value> &)>;
 
     explicit Amt(std::shared_ptr<ipfs::IpfsDatastore> store,
                  OptBitWidth bit_width = {});
     Amt(std::shared_ptr<ipfs::IpfsDatastore> store,
         const CID &root,
         OptBitWidth bit_width = {});
+    /**
+     * Build amt bottom-up from values with strictly increasing keys,
+     * writing each node once. Result is same as `set` of each value and
+     * `flush`.
+     * @return root cid
+     */
+    static outcome::result<CID> build(
+        std::shared_ptr<ipfs::IpfsDatastore> store,
+        gsl::span<const std::pair<uint64_t, Value>> values,
+        OptBitWidth bit_width = {});
     /// Get values quantity
     outcome::result<uint64_t> count() const;
     /// Set value by key, does not write to storage
@@ -83,6 +99,13 @@ namespace fc::storage::amt {
     outcome::result<void> visit(const Visitor &visitor) const;
     /// Loads root item
     outcome::result<void> loadRoot() const;
+    /**
+     * Visit keys added, removed or changed between two amts.
+     * Subtrees with same cid are skipped without loading.
+     */
+    static outcome::result<void> diff(const Amt &before,
+                                      const Amt &after,
+                                      const DiffVisitor &visitor);
     /// Store CBOR encoded value by key
     template <typename T>
     outcome::result<void> setCbor(uint64_t key, const T &value) {
@@ -110,6 +133,14 @@ namespace fc::storage::amt {
                                 uint64_t height,
                                 uint64_t offset,
                                 const Visitor &visitor) const;
+    static outcome::result<void> diff(const Amt &before,
+                                      Node *node_before,
+                                      uint64_t height_before,
+                                      const Amt &after,
+                                      Node *node_after,
+                                      uint64_t height_after,
+                                      uint64_t offset,
+                                      const DiffVisitor &visitor);
     outcome::result<Node::Ptr> loadLink(Node &node,
                                         uint64_t index,
                                         bool create) const;
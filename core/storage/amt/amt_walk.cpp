@@ -22,11 +22,24 @@ OUTCOME_CPP_DEFINE_CATEGORY(fc::storage::amt, AmtError, e) {
       return "AmtError::kRootBitsWrong";
     case AmtError::kNodeBitsWrong:
       return "AmtError::kNodeBitsWrong";
+    case AmtError::kNotSorted:
+      return "AmtError::kNotSorted";
   }
   return "Unknown error";
 }
 
 namespace fc::storage::amt {
+  namespace {
+    /// Inner node without children may be decoded as empty values
+    Node::Links &asLinks(Node &node) {
+      if (which<Node::Values>(node.items)
+          && boost::get<Node::Values>(node.items).empty()) {
+        node.items = Node::Links{};
+      }
+      return boost::get<Node::Links>(node.items);
+    }
+  }  // namespace
+
   CBOR2_ENCODE(Node) {
     std::vector<uint8_t> bits;
     bits.resize(v.bits_bytes);
@@ -128,6 +141,69 @@ namespace fc::storage::amt {
     assert(this->bits() != 0);
   }
 
+  outcome::result<CID> Amt::build(
+      std::shared_ptr<ipfs::IpfsDatastore> store,
+      gsl::span<const std::pair<uint64_t, Value>> values,
+      OptBitWidth bit_width) {
+    const Amt amt{std::move(store), bit_width};
+    const auto width{amt.maskAt(1)};
+    Root root{bit_width, 0, 0, {Node::Values{}, amt.bitsBytes()}};
+    if (!values.empty()) {
+      auto last{values[values.size() - 1].first};
+      if (last > kMaxIndex) {
+        return AmtError::kIndexTooBig;
+      }
+      while (last >= amt.maxAt(root.height)) {
+        ++root.height;
+      }
+    }
+    root.count = values.size();
+
+    // incomplete node of each height, with index at that height
+    std::vector<boost::optional<std::pair<uint64_t, Node>>> open(root.height
+                                                                 + 1);
+    std::function<outcome::result<void>(uint64_t)> close{
+        [&](uint64_t height) -> outcome::result<void> {
+          auto [index, node]{std::move(*open[height])};
+          open[height].reset();
+          OUTCOME_TRY(cid, amt.ipld->setCbor(node));
+          auto &parent{open[height + 1]};
+          if (parent && parent->first != index / width) {
+            OUTCOME_TRY(close(height + 1));
+          }
+          if (!parent) {
+            parent.emplace(index / width, Node{Node::Links{}, amt.bitsBytes()});
+          }
+          boost::get<Node::Links>(parent->second.items)
+              .emplace(index % width, cid);
+          return outcome::success();
+        }};
+    boost::optional<uint64_t> prev;
+    for (auto &[key, value] : values) {
+      if (prev && key <= *prev) {
+        return AmtError::kNotSorted;
+      }
+      prev = key;
+      auto &leaf{open[0]};
+      if (leaf && leaf->first != key / width) {
+        OUTCOME_TRY(close(0));
+      }
+      if (!leaf) {
+        leaf.emplace(key / width, Node{Node::Values{}, amt.bitsBytes()});
+      }
+      boost::get<Node::Values>(leaf->second.items).emplace(key % width, value);
+    }
+    for (uint64_t height{0}; height < root.height; ++height) {
+      if (open[height]) {
+        OUTCOME_TRY(close(height));
+      }
+    }
+    if (open[root.height]) {
+      root.node = std::move(open[root.height]->second);
+    }
+    return amt.ipld->setCbor(root);
+  }
+
   outcome::result<uint64_t> Amt::count() const {
     OUTCOME_TRY(loadRoot());
     return boost::get<Root>(root_).count;
@@ -301,6 +377,16 @@ namespace fc::storage::amt {
       return outcome::success();
     }
     auto mask = maskAt(height);
+    // request all children at once, they are loaded in order below
+    std::vector<CID> cids;
+    for (auto &it : boost::get<Node::Links>(node.items)) {
+      if (which<CID>(it.second)) {
+        cids.push_back(boost::get<CID>(it.second));
+      }
+    }
+    if (!cids.empty()) {
+      ipld->prefetch(cids);
+    }
     for (auto &it : boost::get<Node::Links>(node.items)) {
       OUTCOME_TRY(loadLink(node, it.first, false));
       OUTCOME_TRY(visit(*boost::get<Node::Ptr>(it.second),
@@ -322,6 +408,179 @@ namespace fc::storage::amt {
     return outcome::success();
   }
 
+  outcome::result<void> Amt::diff(const Amt &before,
+                                  const Amt &after,
+                                  const DiffVisitor &visitor) {
+    if (which<CID>(before.root_) && which<CID>(after.root_)
+        && boost::get<CID>(before.root_) == boost::get<CID>(after.root_)) {
+      return outcome::success();
+    }
+    OUTCOME_TRY(before.loadRoot());
+    OUTCOME_TRY(after.loadRoot());
+    if (before.bits() != after.bits()) {
+      return AmtError::kRootBitsWrong;
+    }
+    auto &root_before{boost::get<Root>(before.root_)};
+    auto &root_after{boost::get<Root>(after.root_)};
+    return diff(before,
+                &root_before.node,
+                root_before.height,
+                after,
+                &root_after.node,
+                root_after.height,
+                0,
+                visitor);
+  }
+
+  outcome::result<void> Amt::diff(const Amt &before,
+                                  Node *node_before,
+                                  uint64_t height_before,
+                                  const Amt &after,
+                                  Node *node_after,
+                                  uint64_t height_after,
+                                  uint64_t offset,
+                                  const DiffVisitor &visitor) {
+    if (!node_after) {
+      if (node_before) {
+        return before.visit(
+            *node_before, height_before, offset, [&](auto key, auto &value) {
+              return visitor(key, value, boost::none);
+            });
+      }
+      return outcome::success();
+    }
+    if (!node_before) {
+      return after.visit(
+          *node_after, height_after, offset, [&](auto key, auto &value) {
+            return visitor(key, boost::none, value);
+          });
+    }
+    if (height_before != height_after) {
+      // lower tree is the first child of higher tree
+      auto lower_before{height_before < height_after};
+      auto &higher{lower_before ? after : before};
+      auto &node{lower_before ? *node_after : *node_before};
+      auto height{std::max(height_before, height_after)};
+      auto mask{higher.maskAt(height)};
+      auto &links{asLinks(node)};
+      if (links.find(0) == links.end()) {
+        OUTCOME_TRY(lower_before ? diff(before,
+                                        node_before,
+                                        height_before,
+                                        after,
+                                        nullptr,
+                                        height - 1,
+                                        offset,
+                                        visitor)
+                                 : diff(before,
+                                        nullptr,
+                                        height - 1,
+                                        after,
+                                        node_after,
+                                        height_after,
+                                        offset,
+                                        visitor));
+      }
+      for (auto &it : links) {
+        OUTCOME_TRY(child, higher.loadLink(node, it.first, false));
+        auto child_offset{offset + it.first * mask};
+        auto other{it.first == 0 ? (lower_before ? node_before : node_after)
+                                 : nullptr};
+        OUTCOME_TRY(lower_before ? diff(before,
+                                        other,
+                                        height_before,
+                                        after,
+                                        child.get(),
+                                        height - 1,
+                                        child_offset,
+                                        visitor)
+                                 : diff(before,
+                                        child.get(),
+                                        height - 1,
+                                        after,
+                                        other,
+                                        height_after,
+                                        child_offset,
+                                        visitor));
+      }
+      return outcome::success();
+    }
+    auto height{height_before};
+    if (height == 0) {
+      auto &values_before{boost::get<Node::Values>(node_before->items)};
+      auto &values_after{boost::get<Node::Values>(node_after->items)};
+      auto it_before{values_before.begin()};
+      auto it_after{values_after.begin()};
+      while (it_before != values_before.end()
+             || it_after != values_after.end()) {
+        if (it_after == values_after.end()
+            || (it_before != values_before.end()
+                && it_before->first < it_after->first)) {
+          OUTCOME_TRY(visitor(
+              offset + it_before->first, it_before->second, boost::none));
+          ++it_before;
+        } else if (it_before == values_before.end()
+                   || it_after->first < it_before->first) {
+          OUTCOME_TRY(
+              visitor(offset + it_after->first, boost::none, it_after->second));
+          ++it_after;
+        } else {
+          if (it_before->second != it_after->second) {
+            OUTCOME_TRY(visitor(offset + it_before->first,
+                                it_before->second,
+                                it_after->second));
+          }
+          ++it_before;
+          ++it_after;
+        }
+      }
+      return outcome::success();
+    }
+    auto mask{before.maskAt(height)};
+    auto &links_before{asLinks(*node_before)};
+    auto &links_after{asLinks(*node_after)};
+    auto it_before{links_before.begin()};
+    auto it_after{links_after.begin()};
+    while (it_before != links_before.end() || it_after != links_after.end()) {
+      size_t index{};
+      Node::Ptr child_before, child_after;
+      if (it_after == links_after.end()
+          || (it_before != links_before.end()
+              && it_before->first < it_after->first)) {
+        index = it_before->first;
+        OUTCOME_TRYA(child_before,
+                     before.loadLink(*node_before, index, false));
+        ++it_before;
+      } else if (it_before == links_before.end()
+                 || it_after->first < it_before->first) {
+        index = it_after->first;
+        OUTCOME_TRYA(child_after, after.loadLink(*node_after, index, false));
+        ++it_after;
+      } else {
+        index = it_before->first;
+        auto &link_before{it_before->second};
+        auto &link_after{it_after->second};
+        ++it_before;
+        ++it_after;
+        if (link_before == link_after) {
+          continue;
+        }
+        OUTCOME_TRYA(child_before,
+                     before.loadLink(*node_before, index, false));
+        OUTCOME_TRYA(child_after, after.loadLink(*node_after, index, false));
+      }
+      OUTCOME_TRY(diff(before,
+                       child_before.get(),
+                       height - 1,
+                       after,
+                       child_after.get(),
+                       height - 1,
+                       offset + index * mask,
+                       visitor));
+    }
+    return outcome::success();
+  }
+
   outcome::result<Node::Ptr> Amt::loadLink(Node &parent,
                                            uint64_t index,
                                            bool create) const {
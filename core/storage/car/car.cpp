@@ -212,4 +212,32 @@ namespace fc::storage::car {
     }
     return makeCar(output, store, roots, cid_order);
   }
+
+  SelectiveCarWriter::SelectiveCarWriter(Ipld &store,
+                                         const CID &root,
+                                         Output output)
+      : store_{store},
+        traverser_{store, root, kAllSelector},
+        output_{std::move(output)} {
+    writeHeader(buffer_, {root});
+    output_(buffer_);
+  }
+
+  outcome::result<bool> SelectiveCarWriter::write() {
+    while (!traverser_.isCompleted()) {
+      OUTCOME_TRY(has, store_.contains(traverser_.next()));
+      if (!has) {
+        return false;
+      }
+      auto visited{traverser_.visitOrder().size()};
+      OUTCOME_TRY(cid, traverser_.advance());
+      if (traverser_.visitOrder().size() != visited) {
+        OUTCOME_TRY(bytes, store_.get(cid));
+        buffer_.clear();
+        writeItem(buffer_, cid, bytes);
+        output_(buffer_);
+      }
+    }
+    return true;
+  }
 }  // namespace fc::storage::car
@@ -9,6 +9,7 @@
 
 #include "storage/ipfs/datastore.hpp"
 #include "storage/ipld/selector.hpp"
+#include "storage/ipld/traverser.hpp"
 
 namespace fc::storage::car {
   using Ipld = ipfs::IpfsDatastore;
@@ -83,6 +84,31 @@ namespace fc::storage::car {
       Ipld &store,
       const std::vector<std::pair<CID, Selector>> &dags,
       const std::string &output_path);
+
+  /**
+   * Writes car of single dag while its blocks are being received.
+   * Blocks are written in same order as by `makeSelectiveCar`, each as soon
+   * as it and all preceding blocks are in store.
+   */
+  class SelectiveCarWriter {
+   public:
+    using Output = std::function<void(BytesIn)>;
+
+    /** Writes header immediately */
+    SelectiveCarWriter(Ipld &store, const CID &root, Output output);
+
+    /**
+     * Writes blocks available in store
+     * @return true if all blocks were written
+     */
+    outcome::result<bool> write();
+
+   private:
+    Ipld &store_;
+    ipld::traverser::Traverser traverser_;
+    Output output_;
+    Buffer buffer_;
+  };
 }  // namespace fc::storage::car
 
 OUTCOME_HPP_DECLARE_ERROR(fc::storage::car, CarError);
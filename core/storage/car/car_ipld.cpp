@@ -0,0 +1,49 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/car/car_ipld.hpp"
+
+#include "common/error_text.hpp"
+#include "storage/car/car.hpp"
+
+namespace fc::storage::car {
+  outcome::result<std::shared_ptr<CarIpld>> CarIpld::open(
+      const std::string &path) {
+    OUTCOME_TRY(mapped, common::mapFile(path));
+    auto ipld{std::make_shared<CarIpld>()};
+    ipld->file_ = std::move(mapped.first);
+    OUTCOME_TRY(reader, CarReader::make(mapped.second));
+    while (!reader.end()) {
+      OUTCOME_TRY(item, reader.next());
+      ipld->index_.emplace(std::move(item.first), item.second);
+    }
+    ipld->roots_ = std::move(reader.roots);
+    return ipld;
+  }
+
+  outcome::result<bool> CarIpld::contains(const CID &cid) const {
+    return index_.count(cid) != 0;
+  }
+
+  outcome::result<void> CarIpld::set(const CID &cid, Buffer value) {
+    return ERROR_TEXT("CarIpld: read-only");
+  }
+
+  outcome::result<Buffer> CarIpld::get(const CID &cid) const {
+    auto it{index_.find(cid)};
+    if (it == index_.end()) {
+      return ipfs::IpfsDatastoreError::kNotFound;
+    }
+    return Buffer{it->second};
+  }
+
+  outcome::result<void> CarIpld::remove(const CID &cid) {
+    return ERROR_TEXT("CarIpld: read-only");
+  }
+
+  const std::vector<CID> &CarIpld::roots() const {
+    return roots_;
+  }
+}  // namespace fc::storage::car
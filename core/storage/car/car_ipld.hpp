@@ -0,0 +1,41 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <unordered_map>
+
+#include "common/file.hpp"
+#include "storage/ipfs/datastore.hpp"
+
+namespace fc::storage::car {
+  using common::MappedFile;
+
+  /**
+   * Read-only ipld over mapped car file.
+   * Offsets of blocks are indexed once on open, `get` copies block bytes
+   * from mapping, so car is never loaded into other store.
+   */
+  class CarIpld : public Ipld, public std::enable_shared_from_this<CarIpld> {
+   public:
+    static outcome::result<std::shared_ptr<CarIpld>> open(
+        const std::string &path);
+
+    outcome::result<bool> contains(const CID &cid) const override;
+    outcome::result<void> set(const CID &cid, Buffer value) override;
+    outcome::result<Buffer> get(const CID &cid) const override;
+    outcome::result<void> remove(const CID &cid) override;
+    IpldPtr shared() override {
+      return shared_from_this();
+    }
+
+    const std::vector<CID> &roots() const;
+
+   private:
+    MappedFile file_;
+    std::vector<CID> roots_;
+    std::unordered_map<CID, BytesIn> index_;
+  };
+}  // namespace fc::storage::car
@@ -0,0 +1,119 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <boost/endian/conversion.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <random>
+
+#include "common/bench.hpp"
+#include "storage/car/cids_index/cids_index.hpp"
+#include "storage/car/cids_index/progress.hpp"
+
+namespace fc::storage::cids_index {
+  /** deterministic uniform keys, sorted by row number */
+  struct SyntheticKeys {
+    size_t count{};
+
+    static uint64_t mix(uint64_t x) {
+      x ^= x >> 33;
+      x *= 0xff51afd7ed558ccdULL;
+      x ^= x >> 33;
+      x *= 0xc4ceb9fe1a85ec53ULL;
+      x ^= x >> 33;
+      return x;
+    }
+
+    Key key(size_t i) const {
+      auto step{std::numeric_limits<uint64_t>::max() / count};
+      Key key;
+      boost::endian::store_big_u64(key.data(), i * step + mix(i) % step);
+      for (size_t j{1}; j < key.size() / 8; ++j) {
+        boost::endian::store_big_u64(key.data() + 8 * j, mix(i * 4 + j));
+      }
+      return key;
+    }
+  };
+
+  bool writeIndex(const std::string &path, const SyntheticKeys &keys) {
+    std::ofstream file{path, std::ios::binary};
+    if (!common::write(file, gsl::make_span(&kHeaderV0, 1))) {
+      return false;
+    }
+    std::vector<Row> rows;
+    // estimated, 64mb
+    rows.reserve((64 << 20) / sizeof(Row));
+    for (size_t i{0}; i < keys.count; ++i) {
+      auto &row{rows.emplace_back()};
+      row.key = keys.key(i);
+      row.offset = i;
+      row.max_size64 = 1;
+      if (rows.size() == rows.capacity() || i + 1 == keys.count) {
+        if (!common::write(file, gsl::make_span(rows))) {
+          return false;
+        }
+        rows.resize(0);
+      }
+    }
+    return common::write(file, gsl::make_span(&kTrailerV0, 1));
+  }
+
+  /** Looks up present and absent keys, returns count of found */
+  size_t lookup(const Index &index, const SyntheticKeys &keys, size_t lookups) {
+    std::mt19937_64 random{0};
+    std::uniform_int_distribution<size_t> row{0, keys.count - 1};
+    size_t found{};
+    for (size_t i{0}; i < lookups; ++i) {
+      auto key{keys.key(row(random))};
+      if (auto _row{index.find(key).value()}) {
+        ++found;
+      }
+      // absent key
+      ++key[key.size() - 1];
+      if (index.find(key).value()) {
+        fmt::print("unexpected row\n");
+      }
+    }
+    return found;
+  }
+
+  void bench(const std::string &name,
+             const Index &index,
+             const SyntheticKeys &keys,
+             size_t lookups) {
+    auto found{common::bench(
+        name, 2 * lookups, [&] { return lookup(index, keys, lookups); })};
+    fmt::print("{}: {} lookups, {} found\n", name, 2 * lookups, found);
+  }
+}  // namespace fc::storage::cids_index
+
+/**
+ * Compares SparseIndex and RadixIndex lookups over synthetic index file.
+ */
+int main(int argc, char **argv) {
+  using namespace fc::storage::cids_index;
+  if (argc < 2) {
+    fmt::print("usage: {} INDEX [ROWS=100000000] [LOOKUPS=1000000]\n",
+               argv[0]);
+    return 0;
+  }
+  std::string path{argv[1]};
+  SyntheticKeys keys{argc > 2 ? std::stoull(argv[2]) : 100000000};
+  size_t lookups{argc > 3 ? std::stoull(argv[3]) : 1000000};
+  if (!boost::filesystem::exists(path)) {
+    fmt::print("writing {} rows ({})\n",
+               keys.count,
+               bytesUnits(keys.count * sizeof(Row)));
+    if (!writeIndex(path, keys)) {
+      fmt::print("write error\n");
+      return 1;
+    }
+  }
+  // estimated, 1gb like node writable car
+  constexpr size_t kMaxMemory{1 << 30};
+  auto sparse{load(path, kMaxMemory).value()};
+  bench("SparseIndex", *sparse, keys, lookups);
+  auto radix{load(path, kMaxMemory, true).value()};
+  bench("RadixIndex", *radix, keys, lookups);
+}
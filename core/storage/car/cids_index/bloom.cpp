@@ -0,0 +1,158 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/car/cids_index/bloom.hpp"
+
+#include <boost/endian/conversion.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include "common/error_text.hpp"
+#include "common/file.hpp"
+
+namespace fc::storage::cids_index {
+  inline auto bits(size_t words) {
+    return words * 64;
+  }
+
+  template <typename B, typename F>
+  inline void probes(B &bloom, const Key &key, const F &f) {
+    auto h1{boost::endian::load_little_u64(key.data())};
+    auto h2{boost::endian::load_little_u64(key.data() + 8) | 1};
+    auto n{bits(bloom.words.size())};
+    for (size_t i{0}; i < bloom.hashes; ++i) {
+      auto bit{(h1 + i * h2) % n};
+      if (!f(bloom.words[bit / 64], uint64_t{1} << (bit % 64))) {
+        return;
+      }
+    }
+  }
+
+  BloomFilter::BloomFilter(size_t capacity)
+      : words(std::max<size_t>(1, ceilDiv(capacity * kBitsPerKey, 64))) {}
+
+  size_t BloomFilter::capacity(size_t count, bool writable) {
+    if (writable) {
+      // estimated
+      return count + count / 4 + (1 << 20);
+    }
+    return count;
+  }
+
+  size_t BloomFilter::maxCount() const {
+    return bits(words.size()) / kBitsPerKey;
+  }
+
+  void BloomFilter::add(const Key &key) {
+    probes(*this, key, [](std::atomic_uint64_t &word, uint64_t mask) {
+      word.fetch_or(mask, std::memory_order_relaxed);
+      return true;
+    });
+  }
+
+  bool BloomFilter::maybe(const Key &key) const {
+    auto found{true};
+    probes(*this, key, [&](const std::atomic_uint64_t &word, uint64_t mask) {
+      found = word.load(std::memory_order_relaxed) & mask;
+      return found;
+    });
+    return found;
+  }
+
+  outcome::result<void> BloomFilter::save(const std::string &path,
+                                          const RowsInfo &info) const {
+    BloomHeader header;
+    header.magic = kMagic;
+    header.hashes = hashes;
+    header.words = words.size();
+    header.count = info.count;
+    header.max_offset = info.max_offset;
+    header.max_key = info.max_key;
+    std::vector<boost::endian::little_uint64_buf_t> data;
+    data.reserve(words.size());
+    for (auto &word : words) {
+      data.emplace_back(word.load(std::memory_order_relaxed));
+    }
+    auto tmp_path{path + ".tmp"};
+    std::ofstream file{tmp_path, std::ios::binary};
+    if (!common::write(file, gsl::make_span(&header, 1))
+        || !common::write(file, gsl::make_span(data))
+        || !file.flush().good()) {
+      return ERROR_TEXT("BloomFilter::save: write error");
+    }
+    file.close();
+    boost::system::error_code ec;
+    boost::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+      return ec;
+    }
+    return outcome::success();
+  }
+
+  outcome::result<std::shared_ptr<BloomFilter>> BloomFilter::load(
+      const std::string &path, const RowsInfo &info) {
+    std::ifstream file{path, std::ios::binary};
+    BloomHeader header;
+    if (!common::read(file, gsl::make_span(&header, 1))) {
+      return ERROR_TEXT("BloomFilter::load: read header failed");
+    }
+    if (header.magic.value() != kMagic || header.hashes.value() == 0
+        || header.words.value() == 0) {
+      return ERROR_TEXT("BloomFilter::load: invalid header");
+    }
+    if (header.count.value() != info.count
+        || header.max_offset != info.max_offset
+        || header.max_key != info.max_key) {
+      return ERROR_TEXT("BloomFilter::load: another index");
+    }
+    // don't allocate words for truncated or corrupted file
+    boost::system::error_code ec;
+    auto size{boost::filesystem::file_size(path, ec)};
+    if (ec) {
+      return ec;
+    }
+    size -= sizeof(BloomHeader);
+    if (size % sizeof(uint64_t) != 0
+        || size / sizeof(uint64_t) != header.words.value()) {
+      return ERROR_TEXT("BloomFilter::load: file size mismatch");
+    }
+    std::vector<boost::endian::little_uint64_buf_t> data(header.words.value());
+    if (!common::read(file, gsl::make_span(data))) {
+      return ERROR_TEXT("BloomFilter::load: read words failed");
+    }
+    auto bloom{std::make_shared<BloomFilter>(0)};
+    bloom->hashes = header.hashes.value();
+    bloom->words = std::vector<std::atomic_uint64_t>(data.size());
+    for (size_t i{0}; i < data.size(); ++i) {
+      bloom->words[i].store(data[i].value(), std::memory_order_relaxed);
+    }
+    return bloom;
+  }
+
+  outcome::result<std::shared_ptr<BloomFilter>> BloomFilter::build(
+      const std::vector<std::string> &index_paths, size_t capacity) {
+    auto bloom{std::make_shared<BloomFilter>(capacity)};
+    for (auto &index_path : index_paths) {
+      std::ifstream index_file{index_path, std::ios::binary};
+      OUTCOME_TRY(count, checkIndex(index_file));
+      if (count == 0) {
+        continue;
+      }
+      MergeRange range;
+      range.file = &index_file;
+      range.begin = 1;
+      range.end = 1 + count;
+      // estimated, 64kb
+      range.rows.resize(1638);
+      while (!range.empty()) {
+        if (!range.read()) {
+          return ERROR_TEXT("BloomFilter::build: read error");
+        }
+        bloom->add(range.front().key);
+        range.pop();
+      }
+    }
+    return bloom;
+  }
+}  // namespace fc::storage::cids_index
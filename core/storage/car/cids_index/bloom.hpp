@@ -0,0 +1,61 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+
+#include "storage/car/cids_index/cids_index.hpp"
+
+namespace fc::storage::cids_index {
+  struct BloomHeader {
+    boost::endian::little_uint64_buf_t magic;
+    boost::endian::little_uint64_buf_t hashes;
+    boost::endian::little_uint64_buf_t words;
+    /** index rows info, bloom is invalid for another index */
+    boost::endian::little_uint64_buf_t count;
+    Row max_offset;
+    Key max_key;
+  };
+  static_assert(sizeof(BloomHeader) == 104);
+
+  /**
+   * Bloom filter of index keys, answers "definitely absent" without index
+   * lookup. Keys are blake2b hashes, so probes are derived from key bits.
+   * Keys may be added concurrently with lookups.
+   */
+  struct BloomFilter {
+    /** "cidbloom" */
+    static constexpr uint64_t kMagic{0x6d6f6f6c62646963};
+    // estimated, ~1% false positives
+    static constexpr size_t kBitsPerKey{10};
+    static constexpr size_t kHashes{7};
+
+    size_t hashes{kHashes};
+    std::vector<std::atomic_uint64_t> words;
+
+    explicit BloomFilter(size_t capacity);
+
+    /** writable index grows until next flush rebuilds filter */
+    static size_t capacity(size_t count, bool writable);
+
+    /** keys count for ~1% false positives */
+    size_t maxCount() const;
+
+    void add(const Key &key);
+    bool maybe(const Key &key) const;
+
+    outcome::result<void> save(const std::string &path,
+                               const RowsInfo &info) const;
+
+    /** loads filter saved for index with same info */
+    static outcome::result<std::shared_ptr<BloomFilter>> load(
+        const std::string &path, const RowsInfo &info);
+
+    /** reads all rows of index files */
+    static outcome::result<std::shared_ptr<BloomFilter>> build(
+        const std::vector<std::string> &index_paths, size_t capacity);
+  };
+}  // namespace fc::storage::cids_index
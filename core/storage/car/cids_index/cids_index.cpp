@@ -5,12 +5,18 @@
 
 #include "storage/car/cids_index/cids_index.hpp"
 
+#include <boost/endian/conversion.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <map>
+#include <thread>
+
 #include "codec/uvarint.hpp"
 #include "common/error_text.hpp"
 #include "common/file.hpp"
 #include "common/from_span.hpp"
 #include "common/logger.hpp"
 #include "common/ptr.hpp"
+#include "storage/car/cids_index/bloom.hpp"
 #include "storage/car/cids_index/progress.hpp"
 #include "storage/ipfs/ipfs_datastore_error.hpp"
 
@@ -70,6 +76,25 @@ namespace fc::storage::cids_index {
     return {false, 0};
   }
 
+  boost::optional<BytesIn> readCarItem(BytesIn car, const Row &row) {
+    auto offset{row.offset.value()};
+    if (offset >= static_cast<uint64_t>(car.size())) {
+      return boost::none;
+    }
+    auto input{car.subspan(offset)};
+    BytesIn item;
+    if (!codec::uvarint::readBytes(item, input)) {
+      return boost::none;
+    }
+    if (!codec::readPrefix(item, kCborBlakePrefix)) {
+      return boost::none;
+    }
+    if (!codec::readPrefix(item, row.key)) {
+      return boost::none;
+    }
+    return item;
+  }
+
   RowsInfo &RowsInfo::feed(const Row &row) {
     valid = valid && !row.isMeta();
     if (valid) {
@@ -107,8 +132,10 @@ namespace fc::storage::cids_index {
     ++current;
   }
 
-  outcome::result<void> merge(std::ostream &out,
-                              std::vector<MergeRange> &&ranges) {
+  /** merges ranges without header and trailer */
+  inline outcome::result<void> mergeRows(std::ostream &out,
+                                         std::vector<MergeRange> &&ranges,
+                                         BloomFilter *bloom) {
     auto read_error{ERROR_TEXT("merge: read error")};
     auto write_error{ERROR_TEXT("merge: write error")};
     std::greater<MergeRange> cmp;
@@ -128,15 +155,15 @@ namespace fc::storage::cids_index {
       }
     }
     std::make_heap(ranges.begin(), ranges.end(), cmp);
-    if (!common::write(out, gsl::make_span(&kHeaderV0, 1))) {
-      return write_error;
-    }
     while (!ranges.empty()) {
       std::pop_heap(ranges.begin(), ranges.end(), cmp);
       auto &range{ranges.back()};
       if (!common::write(out, gsl::make_span(&range.front(), 1))) {
         return write_error;
       }
+      if (bloom) {
+        bloom->add(range.front().key);
+      }
       range.pop();
       if (range.empty()) {
         ranges.pop_back();
@@ -147,6 +174,17 @@ namespace fc::storage::cids_index {
         std::push_heap(ranges.begin(), ranges.end(), cmp);
       }
     }
+    return outcome::success();
+  }
+
+  outcome::result<void> merge(std::ostream &out,
+                              std::vector<MergeRange> &&ranges,
+                              BloomFilter *bloom) {
+    auto write_error{ERROR_TEXT("merge: write error")};
+    if (!common::write(out, gsl::make_span(&kHeaderV0, 1))) {
+      return write_error;
+    }
+    OUTCOME_TRY(mergeRows(out, std::move(ranges), bloom));
     if (!common::write(out, gsl::make_span(&kTrailerV0, 1))) {
       return write_error;
     }
@@ -154,6 +192,147 @@ namespace fc::storage::cids_index {
     return outcome::success();
   }
 
+  /** runs f(i) for each thread i and waits */
+  template <typename F>
+  inline void parallel(size_t threads, const F &f) {
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (size_t i{0}; i < threads; ++i) {
+      workers.emplace_back([&f, i] { f(i); });
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }
+
+  /** returns index of first row not less than key in file range */
+  inline outcome::result<size_t> lowerBound(std::istream &file,
+                                            size_t begin,
+                                            size_t end,
+                                            const Key &key) {
+    while (begin < end) {
+      auto middle{begin + (end - begin) / 2};
+      file.seekg(middle * sizeof(Row));
+      Row row;
+      if (!read(file, row)) {
+        return ERROR_TEXT("mergeParallel: read error");
+      }
+      if (row < key) {
+        begin = middle + 1;
+      } else {
+        end = middle;
+      }
+    }
+    return begin;
+  }
+
+  outcome::result<void> mergeParallel(const std::string &out_path,
+                                      std::vector<MergeRange> &&ranges,
+                                      size_t threads,
+                                      BloomFilter *bloom) {
+    auto write_error{ERROR_TEXT("mergeParallel: write error")};
+    // keys are uniformly distributed, partitions by 16bit key prefix
+    auto partitions{std::clamp<size_t>(threads, 1, 1 << 16)};
+    std::vector<Key> bounds(partitions + 1);
+    for (size_t p{1}; p < partitions; ++p) {
+      auto prefix{p * (1 << 16) / partitions};
+      bounds[p][0] = prefix >> 8;
+      bounds[p][1] = prefix & 0xFF;
+    }
+    // splits[range][p] is first row of partition p
+    std::vector<std::vector<size_t>> splits;
+    size_t total{};
+    for (auto &range : ranges) {
+      assert(!range.path.empty());
+      assert(range.rows.empty());
+      auto &split{splits.emplace_back(partitions + 1)};
+      split[0] = range.begin;
+      split[partitions] = range.end;
+      std::ifstream file{range.path, std::ios::binary};
+      for (size_t p{1}; p < partitions; ++p) {
+        OUTCOME_TRYA(split[p],
+                     lowerBound(file, split[p - 1], range.end, bounds[p]));
+      }
+      total += range.end - range.begin;
+    }
+    {
+      std::ofstream out{out_path, std::ios::binary | std::ios::trunc};
+      if (!common::write(out, gsl::make_span(&kHeaderV0, 1))) {
+        return write_error;
+      }
+      out.seekp((1 + total) * sizeof(Row));
+      if (!common::write(out, gsl::make_span(&kTrailerV0, 1))
+          || !out.flush().good()) {
+        return write_error;
+      }
+    }
+    std::mutex error_mutex;
+    outcome::result<void> result{outcome::success()};
+    parallel(partitions, [&](size_t p) {
+      auto _merged{[&]() -> outcome::result<void> {
+        size_t offset{1};
+        for (auto &split : splits) {
+          offset += split[p] - split[0];
+        }
+        std::map<std::string, std::ifstream> files;
+        std::vector<MergeRange> part;
+        for (size_t i{0}; i < ranges.size(); ++i) {
+          auto &file{files[ranges[i].path]};
+          if (!file.is_open()) {
+            file.open(ranges[i].path, std::ios::binary);
+          }
+          auto &range{part.emplace_back()};
+          range.file = &file;
+          range.begin = splits[i][p];
+          range.end = splits[i][p + 1];
+        }
+        std::fstream out{out_path,
+                         std::ios::in | std::ios::out | std::ios::binary};
+        out.seekp(offset * sizeof(Row));
+        OUTCOME_TRY(mergeRows(out, std::move(part), bloom));
+        if (!out.flush().good()) {
+          return write_error;
+        }
+        return outcome::success();
+      }()};
+      if (!_merged) {
+        std::unique_lock lock{error_mutex};
+        result = _merged.error();
+      }
+    });
+    return result;
+  }
+
+  /** adds row for blake cbor item, or stores other item to ipld */
+  inline outcome::result<void> indexCarItem(std::vector<Row> &rows,
+                                            BytesIn item,
+                                            uint64_t offset,
+                                            uint64_t size,
+                                            const IpldPtr &ipld,
+                                            std::mutex *ipld_mutex) {
+    BytesIn input{item};
+    if (startsWith(item, kCborBlakePrefix)) {
+      input = input.subspan(kCborBlakePrefix.size());
+      OUTCOME_TRY(key, fromSpan<Key>(input, false));
+      auto &row{rows.emplace_back()};
+      row.key = key;
+      row.offset = offset;
+      row.max_size64 = maxSize64(size);
+    } else {
+      OUTCOME_TRY(cid, CID::read(input));
+      if (ipld) {
+        if (!asIdentity(cid)) {
+          std::unique_lock<std::mutex> lock;
+          if (ipld_mutex) {
+            lock = std::unique_lock{*ipld_mutex};
+          }
+          OUTCOME_TRY(ipld->set(cid, Buffer{input}));
+        }
+      }
+    }
+    return outcome::success();
+  }
+
   outcome::result<size_t> readCar(std::istream &car_file,
                                   uint64_t car_min,
                                   uint64_t car_max,
@@ -198,24 +377,10 @@ namespace fc::storage::cids_index {
       if (!varint) {
         break;
       }
-      BytesIn input{item};
       auto size{varint + item.size()};
-      if (startsWith(item, kCborBlakePrefix)) {
-        input = input.subspan(kCborBlakePrefix.size());
-        OUTCOME_TRY(key, fromSpan<Key>(input, false));
-        auto &row{rows.emplace_back()};
-        row.key = key;
-        row.offset = offset;
-        row.max_size64 = maxSize64(size);
-        ++total;
-      } else {
-        OUTCOME_TRY(cid, CID::read(input));
-        if (ipld) {
-          if (!asIdentity(cid)) {
-            OUTCOME_TRY(ipld->set(cid, Buffer{input}));
-          }
-        }
-      }
+      auto count{rows.size()};
+      OUTCOME_TRY(indexCarItem(rows, item, offset, size, ipld, nullptr));
+      total += rows.size() - count;
       offset += size;
       if (max_memory && rows.size() == rows.capacity() && !flush()) {
         return write_error;
@@ -236,6 +401,207 @@ namespace fc::storage::cids_index {
     return total;
   }
 
+  /** returns item end if item at offset is valid */
+  inline boost::optional<uint64_t> nextCarItem(BytesIn car,
+                                               uint64_t offset,
+                                               BytesIn *out = nullptr) {
+    if (offset >= static_cast<uint64_t>(car.size())) {
+      return boost::none;
+    }
+    auto input{car.subspan(offset)};
+    BytesIn item;
+    if (!codec::uvarint::readBytes(item, input) || item.empty()) {
+      return boost::none;
+    }
+    if (out) {
+      *out = item;
+    }
+    return car.size() - input.size();
+  }
+
+  /** returns first item boundary at or after limit, or invalid item offset */
+  inline uint64_t skipCarItems(BytesIn car, uint64_t offset, uint64_t limit) {
+    while (offset < limit) {
+      auto next{nextCarItem(car, offset)};
+      if (!next) {
+        break;
+      }
+      offset = *next;
+    }
+    return offset;
+  }
+
+  /** guesses item boundary, guess is validated by skipCarItems */
+  inline uint64_t guessCarItem(BytesIn car, uint64_t offset) {
+    for (; offset < static_cast<uint64_t>(car.size()); ++offset) {
+      auto next{offset};
+      auto good{true};
+      // estimated, few consecutive items starting with cid
+      for (auto i{0}; good && i < 4 && next < (uint64_t)car.size(); ++i) {
+        BytesIn item;
+        auto _next{nextCarItem(car, next, &item)};
+        good = _next && (item[0] == 0x01 || item[0] == 0x12);
+        if (good) {
+          next = *_next;
+        }
+      }
+      if (good) {
+        return offset;
+      }
+    }
+    return car.size();
+  }
+
+  outcome::result<size_t> readCarParallel(const std::string &car_path,
+                                          uint64_t car_min,
+                                          uint64_t car_max,
+                                          boost::optional<size_t> max_memory,
+                                          IpldPtr ipld,
+                                          Progress *progress,
+                                          const std::string &rows_path,
+                                          std::fstream &rows_file,
+                                          std::vector<MergeRange> &ranges,
+                                          size_t threads,
+                                          boost::optional<uint64_t>
+                                              segment_size) {
+    assert(car_min <= car_max);
+    auto write_error{ERROR_TEXT("readCarParallel: write error")};
+    threads = std::max<size_t>(threads, 1);
+    OUTCOME_TRY(mapped, common::mapFile(car_path));
+    auto car{mapped.second};
+    if ((uint64_t)car.size() < car_max) {
+      return ERROR_TEXT("readCarParallel: car is truncated");
+    }
+    car = car.first(car_max);
+
+    if (!segment_size) {
+      // estimated, 256mb, several segments per thread for balance
+      segment_size = std::max<uint64_t>(
+          ceilDiv(car_max - car_min, threads * 4), 256 << 20);
+    }
+    segment_size = std::max<uint64_t>(*segment_size, 1);
+    auto segments{ceilDiv(car_max - car_min, *segment_size)};
+    std::vector<uint64_t> starts(segments + 1), ends(segments);
+    starts[0] = car_min;
+    starts[segments] = car_max;
+    parallel(threads, [&](size_t thread) {
+      for (auto i{thread + 1}; i < segments; i += threads) {
+        starts[i] = guessCarItem(car, car_min + i * *segment_size);
+      }
+    });
+    parallel(threads, [&](size_t thread) {
+      for (auto i{thread}; i < segments; i += threads) {
+        ends[i] = skipCarItems(car, starts[i], starts[i + 1]);
+      }
+    });
+    // first segment starts at item, so each segment starts at end of previous
+    for (size_t i{0}; i + 1 < segments; ++i) {
+      if (ends[i] != starts[i + 1]) {
+        starts[i + 1] = ends[i];
+        ends[i + 1] = skipCarItems(
+            car, starts[i + 1], std::max(starts[i + 1], starts[i + 2]));
+      }
+    }
+    if (segments != 0) {
+      starts[segments] = ends[segments - 1];
+    }
+
+    size_t max_rows{};
+    if (max_memory) {
+      // estimated, 16mb, 512mb
+      max_rows = std::max<size_t>(
+          std::clamp<size_t>(*max_memory, 16 << 20, 512 << 20) / sizeof(Row)
+              / threads,
+          1);
+    }
+    if (!common::write(rows_file, gsl::make_span(&kHeaderV0, 1))) {
+      return write_error;
+    }
+    std::mutex rows_mutex, ipld_mutex, progress_mutex;
+    size_t total{};
+    outcome::result<void> result{outcome::success()};
+    std::atomic_size_t next_segment{};
+    std::atomic_bool failed{};
+    auto flush{[&](std::vector<Row> &rows) -> outcome::result<void> {
+      std::sort(rows.begin(), rows.end());
+      std::unique_lock lock{rows_mutex};
+      auto &range{ranges.emplace_back()};
+      range.begin = 1 + total;
+      range.end = 1 + total + rows.size();
+      range.file = &rows_file;
+      range.path = rows_path;
+      total += rows.size();
+      if (!common::write(rows_file, gsl::make_span(rows))) {
+        return write_error;
+      }
+      rows.resize(0);
+      return outcome::success();
+    }};
+    auto report{[&](uint64_t bytes, size_t items) {
+      if (progress) {
+        std::unique_lock lock{progress_mutex};
+        progress->car_offset.value += bytes;
+        progress->items.value += items;
+        progress->update();
+      }
+    }};
+    parallel(threads, [&](size_t) {
+      auto _read{[&]() -> outcome::result<void> {
+        std::vector<Row> rows;
+        if (max_memory) {
+          rows.reserve(max_rows);
+        }
+        size_t i;
+        while (!failed && (i = next_segment++) < segments) {
+          auto offset{starts[i]};
+          uint64_t reported{offset};
+          size_t items{};
+          while (offset < starts[i + 1]) {
+            BytesIn item;
+            auto next{nextCarItem(car, offset, &item)};
+            if (!next) {
+              return ERROR_TEXT("readCarParallel: inconsistent");
+            }
+            OUTCOME_TRY(indexCarItem(
+                rows, item, offset, *next - offset, ipld, &ipld_mutex));
+            offset = *next;
+            if (max_memory && rows.size() >= max_rows) {
+              OUTCOME_TRY(flush(rows));
+            }
+            // estimated
+            if (++items == 4096) {
+              report(offset - reported, items);
+              reported = offset;
+              items = 0;
+            }
+          }
+          report(offset - reported, items);
+        }
+        if (!rows.empty()) {
+          OUTCOME_TRY(flush(rows));
+        }
+        return outcome::success();
+      }()};
+      if (!_read) {
+        failed = true;
+        std::unique_lock lock{rows_mutex};
+        result = _read.error();
+      }
+    });
+    OUTCOME_TRY(result);
+    if (ranges.empty()) {
+      auto &range{ranges.emplace_back()};
+      range.begin = range.end = 1;
+      range.file = &rows_file;
+      range.path = rows_path;
+    }
+    if (!common::write(rows_file, gsl::make_span(&kTrailerV0, 1))) {
+      return write_error;
+    }
+    rows_file.flush();
+    return total;
+  }
+
   inline boost::optional<size_t> sparseSize(
       size_t count, boost::optional<size_t> max_memory) {
     if (max_memory && count * sizeof(Row) > *max_memory) {
@@ -358,8 +724,134 @@ namespace fc::storage::cids_index {
     return index;
   }
 
-  outcome::result<std::shared_ptr<Index>> load(
+  outcome::result<boost::optional<Row>> MmapIndex::find(const Key &key) const {
+    auto it{std::lower_bound(rows.begin(), rows.end(), key)};
+    if (it != rows.end() && it->key == key) {
+      if (it->isMeta()) {
+        return ERROR_TEXT("MmapIndex.find: inconsistent");
+      }
+      return *it;
+    }
+    return boost::none;
+  }
+
+  size_t MmapIndex::size() const {
+    return rows.size();
+  }
+
+  inline outcome::result<void> mmapLoad(MmapIndex &index,
+                                        const std::string &index_path) {
+    index.file.open(index_path);
+    if (!index.file.is_open()) {
+      return ERROR_TEXT("mmapLoad: map file failed");
+    }
+    auto size{index.file.size()};
+    if (size % sizeof(Row) != 0 || size < 2 * sizeof(Row)) {
+      return ERROR_TEXT("mmapLoad: invalid file size");
+    }
+    gsl::span<const Row> rows{
+        common::span::cast<const Row>(index.file.data()),
+        static_cast<ptrdiff_t>(size / sizeof(Row))};
+    if (rows[0] != kHeaderV0) {
+      return ERROR_TEXT("mmapLoad: invalid header");
+    }
+    if (rows[rows.size() - 1] != kTrailerV0) {
+      return ERROR_TEXT("mmapLoad: invalid trailer");
+    }
+    index.rows = rows.subspan(1, rows.size() - 2);
+    for (auto &row : index.rows) {
+      if (!index.info.feed(row).valid) {
+        return ERROR_TEXT("mmapLoad: invalid index");
+      }
+    }
+    return outcome::success();
+  }
+
+  size_t RadixTable::bucket(const Key &key) const {
+    if (bits == 0) {
+      return 0;
+    }
+    return boost::endian::load_big_u64(key.data()) >> (64 - bits);
+  }
+
+  void RadixTable::build(gsl::span<const Row> rows,
+                         boost::optional<size_t> max_memory) {
+    // estimated, 8 rows per bucket, up to 512mb table
+    constexpr size_t kBucketRows{8};
+    constexpr size_t kMaxBits{26};
+    bits = 0;
+    while (bits < kMaxBits
+           && (size_t{2} << bits) * kBucketRows <= (size_t)rows.size()
+           && (!max_memory
+               || ((size_t{2} << bits) + 1) * sizeof(uint64_t)
+                      <= *max_memory)) {
+      ++bits;
+    }
+    size_t buckets{size_t{1} << bits};
+    begin.resize(buckets + 1);
+    size_t i{0};
+    for (size_t b{0}; b < buckets; ++b) {
+      while (i < (size_t)rows.size() && bucket(rows[i].key) < b) {
+        ++i;
+      }
+      begin[b] = i;
+    }
+    begin[buckets] = rows.size();
+  }
+
+  boost::optional<Row> RadixTable::find(gsl::span<const Row> rows,
+                                        const Key &key) const {
+    auto b{bucket(key)};
+    auto lo{begin[b]};
+    auto hi{begin[b + 1]};
+    if (lo == hi) {
+      return boost::none;
+    }
+    // next 64 key bits after bucket prefix
+    auto rest{boost::endian::load_big_u64(key.data()) << bits};
+    if (bits != 0) {
+      rest |= boost::endian::load_big_u64(key.data() + 8) >> (64 - bits);
+    }
+    auto i{lo
+           + static_cast<uint64_t>(
+               (static_cast<unsigned __int128>(rest) * (hi - lo)) >> 64)};
+    while (i > lo && !(rows[i - 1] < key)) {
+      --i;
+    }
+    while (i < hi && rows[i] < key) {
+      ++i;
+    }
+    if (i < hi && rows[i].key == key) {
+      return rows[i];
+    }
+    return boost::none;
+  }
+
+  outcome::result<boost::optional<Row>> RadixIndex::find(
+      const Key &key) const {
+    auto row{radix.find(rows, key)};
+    if (row && row->isMeta()) {
+      return ERROR_TEXT("RadixIndex.find: inconsistent");
+    }
+    return row;
+  }
+
+  outcome::result<std::shared_ptr<RadixIndex>> RadixIndex::load(
       const std::string &index_path, boost::optional<size_t> max_memory) {
+    auto index{std::make_shared<RadixIndex>()};
+    OUTCOME_TRY(mmapLoad(*index, index_path));
+    index->radix.build(index->rows, max_memory);
+    return index;
+  }
+
+  outcome::result<std::shared_ptr<Index>> load(
+      const std::string &index_path,
+      boost::optional<size_t> max_memory,
+      bool mmap) {
+    if (mmap) {
+      OUTCOME_TRY(index, RadixIndex::load(index_path, max_memory));
+      return std::move(index);
+    }
     std::ifstream index_file{index_path, std::ios::binary};
     // estimated
     index_file.rdbuf()->pubsetbuf(nullptr, 64 << 10);
@@ -372,4 +864,124 @@ namespace fc::storage::cids_index {
     OUTCOME_TRY(index, MemoryIndex::load(index_file, count));
     return std::move(index);
   }
+
+  outcome::result<boost::optional<Row>> SegmentsIndex::find(
+      const Key &key) const {
+    for (auto it{segments.rbegin()}; it != segments.rend(); ++it) {
+      OUTCOME_TRY(row, it->index->find(key));
+      if (row) {
+        return row;
+      }
+    }
+    return boost::none;
+  }
+
+  size_t SegmentsIndex::size() const {
+    return info.count;
+  }
+
+  void SegmentsIndex::updateInfo() {
+    info = {};
+    for (auto &segment : segments) {
+      auto &other{segment.index->info};
+      info.valid = info.valid && other.valid;
+      info.count += other.count;
+      if (other.count != 0) {
+        if (other.max_offset.offset.value()
+            >= info.max_offset.offset.value()) {
+          info.max_offset = other.max_offset;
+        }
+        info.max_key = std::max(info.max_key, other.max_key);
+      }
+    }
+  }
+
+  std::string SegmentsIndex::deltaPath(size_t id) const {
+    return index_path + "." + std::to_string(id);
+  }
+
+  outcome::result<void> SegmentsIndex::saveManifest() const {
+    auto path{manifestPath(index_path)};
+    auto tmp_path{path + ".tmp"};
+    std::ofstream file{tmp_path};
+    for (size_t i{1}; i < segments.size(); ++i) {
+      file << segments[i].path.substr(index_path.size() + 1) << std::endl;
+    }
+    if (!file.good()) {
+      return ERROR_TEXT("SegmentsIndex.saveManifest: write error");
+    }
+    file.close();
+    boost::system::error_code ec;
+    boost::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+      return ec;
+    }
+    return outcome::success();
+  }
+
+  inline size_t tier(size_t rows) {
+    size_t tier{};
+    while (rows >= SegmentsIndex::kFanout) {
+      rows /= SegmentsIndex::kFanout;
+      ++tier;
+    }
+    return tier;
+  }
+
+  boost::optional<std::pair<size_t, size_t>> SegmentsIndex::compaction()
+      const {
+    if (segments.size() < kFanout) {
+      return boost::none;
+    }
+    auto max_tier{tier(segments.back().index->size())};
+    auto begin{segments.size() - 1};
+    while (begin != 0 && tier(segments[begin - 1].index->size()) <= max_tier) {
+      --begin;
+    }
+    if (segments.size() - begin < kFanout) {
+      return boost::none;
+    }
+    return std::make_pair(begin, segments.size());
+  }
+
+  std::string SegmentsIndex::manifestPath(const std::string &index_path) {
+    return index_path + ".segments";
+  }
+
+  outcome::result<std::shared_ptr<SegmentsIndex>> SegmentsIndex::load(
+      const std::string &index_path,
+      boost::optional<size_t> max_memory,
+      bool mmap) {
+    auto index{std::make_shared<SegmentsIndex>()};
+    index->index_path = index_path;
+    OUTCOME_TRY(base, cids_index::load(index_path, max_memory, mmap));
+    index->segments.push_back({index_path, base});
+    index->next_id = 1;
+    std::ifstream manifest{manifestPath(index_path)};
+    size_t id;
+    while (manifest >> id) {
+      auto path{index->deltaPath(id)};
+      OUTCOME_TRY(delta, cids_index::load(path, max_memory, mmap));
+      index->segments.push_back({path, delta});
+      index->next_id = std::max(index->next_id, id + 1);
+    }
+    index->updateInfo();
+    return index;
+  }
+
+  void SegmentsIndex::removeDeltas(const std::string &index_path) {
+    auto path{manifestPath(index_path)};
+    std::vector<size_t> ids;
+    std::ifstream manifest{path};
+    size_t id;
+    while (manifest >> id) {
+      ids.push_back(id);
+    }
+    manifest.close();
+    boost::system::error_code ec;
+    boost::filesystem::remove(path, ec);
+    for (auto &id : ids) {
+      boost::filesystem::remove(index_path + "." + std::to_string(id), ec);
+    }
+  }
 }  // namespace fc::storage::cids_index
@@ -11,6 +11,7 @@
 
 #include "common/blob.hpp"
 #include "common/enum.hpp"
+#include "common/file.hpp"
 #include "storage/ipfs/datastore.hpp"
 
 namespace boost {
@@ -76,6 +77,7 @@ namespace fc::storage::cids_index {
       {}, decltype(Row::offset){common::to_int(Meta::kTrailerV0)}, {}};
 
   struct Progress;
+  struct BloomFilter;
 
   outcome::result<size_t> checkIndex(std::ifstream &file);
 
@@ -83,6 +85,9 @@ namespace fc::storage::cids_index {
                                       const Row &row,
                                       uint64_t *end);
 
+  /** returns item value bytes from mapped car, or none if inconsistent */
+  boost::optional<BytesIn> readCarItem(BytesIn car, const Row &row);
+
   struct RowsInfo {
     bool valid{true};
     bool sorted{true};
@@ -95,6 +100,8 @@ namespace fc::storage::cids_index {
 
   struct MergeRange {
     std::istream *file{};
+    /** file path, used by parallel merge to open own streams */
+    std::string path;
     std::vector<Row> rows;
     size_t current{(size_t)-1}, begin{}, end{};
 
@@ -111,8 +118,16 @@ namespace fc::storage::cids_index {
     return r.front() < l.front();
   }
 
+  /** adds merged keys to bloom if set */
   outcome::result<void> merge(std::ostream &out,
-                              std::vector<MergeRange> &&ranges);
+                              std::vector<MergeRange> &&ranges,
+                              BloomFilter *bloom = nullptr);
+
+  /** merges file ranges by key partitions in parallel */
+  outcome::result<void> mergeParallel(const std::string &out_path,
+                                      std::vector<MergeRange> &&ranges,
+                                      size_t threads,
+                                      BloomFilter *bloom = nullptr);
 
   outcome::result<size_t> readCar(std::istream &car_file,
                                   uint64_t car_min,
@@ -123,6 +138,24 @@ namespace fc::storage::cids_index {
                                   std::fstream &rows_file,
                                   std::vector<MergeRange> &ranges);
 
+  /**
+   * Splits car into segments at item boundaries, segments are parsed and
+   * sorted in parallel, each worker writes sorted runs to rows file.
+   * @param segment_size - estimated from car size and threads if not set
+   */
+  outcome::result<size_t> readCarParallel(const std::string &car_path,
+                                          uint64_t car_min,
+                                          uint64_t car_max,
+                                          boost::optional<size_t> max_memory,
+                                          IpldPtr ipld,
+                                          Progress *progress,
+                                          const std::string &rows_path,
+                                          std::fstream &rows_file,
+                                          std::vector<MergeRange> &ranges,
+                                          size_t threads,
+                                          boost::optional<uint64_t>
+                                              segment_size = boost::none);
+
   struct Index {
     RowsInfo info;
 
@@ -163,6 +196,83 @@ namespace fc::storage::cids_index {
         std::ifstream &&file, size_t count, size_t max_keys);
   };
 
+  /** reads rows from memory mapped index file, without locks */
+  struct MmapIndex : Index {
+    common::MappedFile file;
+    gsl::span<const Row> rows;
+
+    outcome::result<boost::optional<Row>> find(const Key &key) const override;
+    size_t size() const override;
+  };
+
+  /**
+   * Predicts row position from high-order key bits.
+   * Keys are blake2b hashes, so they are close to uniformly distributed.
+   * Table maps key prefix to bucket of rows, position inside bucket is
+   * interpolated from next key bits, then short scan finds row.
+   */
+  struct RadixTable {
+    size_t bits{};
+    /** first row of each bucket, size is 2^bits + 1 */
+    std::vector<uint64_t> begin;
+
+    size_t bucket(const Key &key) const;
+    void build(gsl::span<const Row> rows, boost::optional<size_t> max_memory);
+    boost::optional<Row> find(gsl::span<const Row> rows, const Key &key) const;
+  };
+
+  /** memory mapped index with radix table lookup */
+  struct RadixIndex : MmapIndex {
+    RadixTable radix;
+
+    outcome::result<boost::optional<Row>> find(const Key &key) const override;
+
+    static outcome::result<std::shared_ptr<RadixIndex>> load(
+        const std::string &index_path, boost::optional<size_t> max_memory);
+  };
+
   outcome::result<std::shared_ptr<Index>> load(
-      const std::string &index_path, boost::optional<size_t> max_memory);
+      const std::string &index_path,
+      boost::optional<size_t> max_memory,
+      bool mmap = false);
+
+  /**
+   * Base index file and sorted delta segments listed in manifest file.
+   * Flush writes only new rows as delta segment, compaction merges
+   * segments of same size tier.
+   */
+  struct SegmentsIndex : Index {
+    /** segments of same tier are merged, each tier is kFanout times larger */
+    static constexpr size_t kFanout{4};
+
+    struct Segment {
+      std::string path;
+      std::shared_ptr<Index> index;
+    };
+
+    std::string index_path;
+    /** base first, newest last */
+    std::vector<Segment> segments;
+    size_t next_id{};
+
+    outcome::result<boost::optional<Row>> find(const Key &key) const override;
+    size_t size() const override;
+
+    /** combines info of segments */
+    void updateInfo();
+    std::string deltaPath(size_t id) const;
+    /** writes delta segments list */
+    outcome::result<void> saveManifest() const;
+    /** returns range of newest segments to merge */
+    boost::optional<std::pair<size_t, size_t>> compaction() const;
+
+    static std::string manifestPath(const std::string &index_path);
+    /** loads base index and delta segments from manifest */
+    static outcome::result<std::shared_ptr<SegmentsIndex>> load(
+        const std::string &index_path,
+        boost::optional<size_t> max_memory,
+        bool mmap);
+    /** removes manifest and then delta segments */
+    static void removeDeltas(const std::string &index_path);
+  };
 }  // namespace fc::storage::cids_index
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <boost/filesystem/operations.hpp>
+#include <thread>
 
 #include "codec/uvarint.hpp"
 #include "common/error_text.hpp"
@@ -13,6 +14,7 @@
 #include "common/logger.hpp"
 #include "common/outcome_fmt.hpp"
 #include "storage/car/car.hpp"
+#include "storage/car/cids_index/bloom.hpp"
 #include "storage/car/cids_index/cids_index.hpp"
 #include "storage/car/cids_index/progress.hpp"
 #include "storage/ipld/cids_ipld.hpp"
@@ -25,7 +27,8 @@ namespace fc::storage::cids_index {
       bool writable,
       boost::optional<size_t> max_memory,
       IpldPtr ipld,
-      common::Logger log) {
+      common::Logger log,
+      bool mmap = false) {
     if (!log) {
       log = spdlog::default_logger();
     }
@@ -48,10 +51,12 @@ namespace fc::storage::cids_index {
     auto header_end{header.length + header.value};
     auto indexed_end{header_end};
     auto cids_path{car_path + ".cids"};
-    std::shared_ptr<Index> index;
+    auto bloom_path{car_path + ".bloom"};
+    std::shared_ptr<SegmentsIndex> index;
+    std::shared_ptr<BloomFilter> bloom;
     if (boost::filesystem::exists(cids_path)) {
       log->info("loading index");
-      if (auto _index{load(cids_path, max_memory)}) {
+      if (auto _index{SegmentsIndex::load(cids_path, max_memory, mmap)}) {
         index = _index.value();
         log->info("index loaded: {}", cids_path);
       } else {
@@ -59,7 +64,7 @@ namespace fc::storage::cids_index {
       }
     }
     std::vector<MergeRange> ranges;
-    std::ifstream index_file;
+    std::vector<std::ifstream> index_files;
     if (index && index->size()) {
       if (!readCarItem(car_file, index->info.max_offset, &indexed_end).first
           || indexed_end > car_size) {
@@ -76,11 +81,16 @@ namespace fc::storage::cids_index {
         car_size = indexed_end;
         boost::filesystem::resize_file(car_path, car_size);
       } else if (index->size()) {
-        auto &range{ranges.emplace_back()};
-        range.begin = 1;
-        range.end = 1 + index->size();
-        index_file.open(cids_path, std::ios::binary);
-        range.file = &index_file;
+        index_files.resize(index->segments.size());
+        for (size_t i{0}; i < index->segments.size(); ++i) {
+          auto &segment{index->segments[i]};
+          auto &range{ranges.emplace_back()};
+          range.begin = 1;
+          range.end = 1 + segment.index->size();
+          index_files[i].open(segment.path, std::ios::binary);
+          range.file = &index_files[i];
+          range.path = segment.path;
+        }
       }
     }
     if (!index || indexed_end < car_size) {
@@ -96,7 +106,8 @@ namespace fc::storage::cids_index {
         progress.car_offset.step = std::min<size_t>(car_size / 100, 1 << 30);
       }
       progress.car_size = car_size - indexed_end;
-      auto _index{[&]() -> outcome::result<std::shared_ptr<Index>> {
+      size_t threads{std::max(1u, std::thread::hardware_concurrency())};
+      auto _index{[&]() -> outcome::result<std::shared_ptr<SegmentsIndex>> {
         progress.begin();
         auto BOOST_OUTCOME_TRY_UNIQUE_NAME{
             gsl::finally([&] { progress.end(); })};
@@ -104,30 +115,47 @@ namespace fc::storage::cids_index {
         std::fstream rows_file{
             rows_path,
             std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc};
-        OUTCOME_TRY(readCar(car_file,
-                            indexed_end,
-                            car_size,
-                            max_memory,
-                            ipld,
-                            &progress,
-                            rows_file,
-                            ranges));
+        auto existing{ranges.size()};
+        OUTCOME_TRY(readCarParallel(car_path,
+                                    indexed_end,
+                                    car_size,
+                                    max_memory,
+                                    ipld,
+                                    &progress,
+                                    rows_path,
+                                    rows_file,
+                                    ranges,
+                                    threads));
+        // no range is read when new items have no rows
+        auto runs{ranges.size() - existing};
         auto tmp_cids_path{cids_path + ".tmp"};
-        if (ranges.size() == 1) {
+        if (runs == 0) {
+          boost::system::error_code ec;
+          boost::filesystem::remove(rows_path, ec);
+          return SegmentsIndex::load(cids_path, max_memory, mmap);
+        }
+        if (existing == 0 && runs == 1) {
           tmp_cids_path = rows_path;
         } else {
           progress.sort();
-          std::ofstream index_file{tmp_cids_path, std::ios::binary};
-          OUTCOME_TRY(merge(index_file, std::move(ranges)));
+          size_t count{};
+          for (auto &range : ranges) {
+            count += range.end - range.begin;
+          }
+          bloom = std::make_shared<BloomFilter>(
+              BloomFilter::capacity(count, writable));
+          OUTCOME_TRY(mergeParallel(
+              tmp_cids_path, std::move(ranges), threads, bloom.get()));
           boost::system::error_code ec;
           boost::filesystem::remove(rows_path, ec);
         }
+        SegmentsIndex::removeDeltas(cids_path);
         boost::system::error_code ec;
         boost::filesystem::rename(tmp_cids_path, cids_path, ec);
         if (ec) {
           return ec;
         }
-        return load(cids_path, max_memory);
+        return SegmentsIndex::load(cids_path, max_memory, mmap);
       }()};
       if (_index) {
         index = _index.value();
@@ -152,9 +180,31 @@ namespace fc::storage::cids_index {
         }
       }
     }
+    if (bloom) {
+      if (auto r{bloom->save(bloom_path, index->info)}; !r) {
+        log->warn("bloom save error: {:#}", r.error());
+      }
+    } else if (auto _bloom{BloomFilter::load(bloom_path, index->info)}) {
+      bloom = _bloom.value();
+    } else {
+      log->info("generating bloom");
+      std::vector<std::string> paths;
+      for (auto &segment : index->segments) {
+        paths.push_back(segment.path);
+      }
+      OUTCOME_TRY(_bloom,
+                  BloomFilter::build(
+                      paths, BloomFilter::capacity(index->size(), writable)));
+      bloom = _bloom;
+      if (auto r{bloom->save(bloom_path, index->info)}; !r) {
+        log->warn("bloom save error: {:#}", r.error());
+      }
+    }
     auto _ipld{std::make_shared<CidsIpld>()};
     _ipld->car_file.open(car_path, std::ios::in | std::ios::binary);
     _ipld->index = index;
+    _ipld->mmap = mmap;
+    _ipld->car_path = car_path;
     _ipld->ipld = ipld;
     if (writable) {
       _ipld->writable.open(car_path, std::ios::app | std::ios::binary);
@@ -162,6 +212,8 @@ namespace fc::storage::cids_index {
     _ipld->car_offset = car_size;
     _ipld->index_path = cids_path;
     _ipld->max_memory = max_memory;
+    _ipld->bloom_path = bloom_path;
+    _ipld->bloom = bloom;
     return _ipld;
   }
 }  // namespace fc::storage::cids_index
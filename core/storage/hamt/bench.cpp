@@ -0,0 +1,62 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <random>
+
+#include "common/bench.hpp"
+#include "storage/hamt/hamt.hpp"
+#include "storage/ipfs/impl/in_memory_datastore.hpp"
+
+namespace fc::storage::hamt {
+  /** key like id address bytes */
+  std::string key(uint64_t i) {
+    std::string key{"\x00", 1};
+    do {
+      key.push_back(static_cast<char>((i & 0x7f) | (i > 0x7f ? 0x80 : 0)));
+      i >>= 7;
+    } while (i != 0);
+    return key;
+  }
+}  // namespace fc::storage::hamt
+
+/**
+ * Measures Hamt set, flush and get over in-memory store.
+ */
+int main(int argc, char **argv) {
+  using namespace fc::storage::hamt;
+  using fc::common::bench;
+  size_t count{argc > 1 ? std::stoull(argv[1]) : 1000000};
+  auto ipld{std::make_shared<fc::storage::ipfs::InMemoryDatastore>()};
+  const Value value{std::vector<uint8_t>(32, 1)};
+
+  Hamt hamt{ipld, kDefaultBitWidth, true};
+  bench("set", count, [&] {
+    for (size_t i{0}; i < count; ++i) {
+      hamt.set(key(i), value).value();
+    }
+  });
+  CID root;
+  bench("flush", count, [&] { root = hamt.flush().value(); });
+
+  std::mt19937_64 random{0};
+  std::uniform_int_distribution<size_t> index{0, count - 1};
+  Hamt loaded{ipld, root, kDefaultBitWidth, true};
+  bench("get cold", count, [&] {
+    for (size_t i{0}; i < count; ++i) {
+      loaded.get(key(index(random))).value();
+    }
+  });
+  bench("get warm", count, [&] {
+    for (size_t i{0}; i < count; ++i) {
+      loaded.get(key(index(random))).value();
+    }
+  });
+  bench("set loaded", count, [&] {
+    for (size_t i{0}; i < count; ++i) {
+      loaded.set(key(index(random)), value).value();
+    }
+  });
+  bench("flush loaded", count, [&] { loaded.flush().value(); });
+}
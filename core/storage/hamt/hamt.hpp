@@ -5,10 +5,13 @@
 
 #pragma once
 
+#include <array>
+#include <mutex>
 #include <string>
 #include <vector>
 
-#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/container/flat_map.hpp>
+#include <boost/container/small_vector.hpp>
 #include <boost/variant.hpp>
 
 #include "codec/cbor/cbor_codec.hpp"
@@ -31,19 +34,60 @@ namespace fc::storage::hamt {
 OUTCOME_HPP_DECLARE_ERROR(fc::storage::hamt, HamtError);
 
 namespace fc::storage::hamt {
-  using boost::multiprecision::cpp_int;
   using common::Buffer;
   using Value = ipfs::IpfsDatastore::Value;
 
   constexpr size_t kLeafMax = 3;
   constexpr size_t kDefaultBitWidth = 5;
+  /// Bitmap has fixed size, so bit width is limited
+  constexpr size_t kMaxBitWidth = 8;
 
-  struct Bits : cpp_int {};
+  /** Fixed size bitmap of present node items */
+  struct Bits {
+    static constexpr size_t kWords{(size_t{1} << kMaxBitWidth) / 64};
+
+    bool test(size_t index) const {
+      return (words[index / 64] >> (index % 64)) & 1;
+    }
+
+    void set(size_t index) {
+      words[index / 64] |= uint64_t{1} << (index % 64);
+    }
+
+    void reset(size_t index) {
+      words[index / 64] &= ~(uint64_t{1} << (index % 64));
+    }
+
+    /** Count of bits set before index */
+    size_t rank(size_t index) const {
+      size_t count{0};
+      for (size_t i{0}; i < index / 64; ++i) {
+        count += popcount(words[i]);
+      }
+      if (auto bit{index % 64}) {
+        count += popcount(words[index / 64] & ((uint64_t{1} << bit) - 1));
+      }
+      return count;
+    }
+
+    static size_t popcount(uint64_t word) {
+      return __builtin_popcountll(word);
+    }
+
+    std::array<uint64_t, kWords> words{};
+  };
 
   CBOR_ENCODE(Bits, bits) {
+    // big-endian without leading zero bytes
     std::vector<uint8_t> bytes;
-    if (bits != 0) {
-      export_bits(bits, std::back_inserter(bytes), 8);
+    for (auto i{Bits::kWords}; i != 0; --i) {
+      auto word{bits.words[i - 1]};
+      for (auto j{8}; j != 0; --j) {
+        uint8_t byte = word >> (8 * (j - 1));
+        if (byte != 0 || !bytes.empty()) {
+          bytes.push_back(byte);
+        }
+      }
     }
     return s << bytes;
   }
@@ -51,10 +95,14 @@ namespace fc::storage::hamt {
   CBOR_DECODE(Bits, bits) {
     std::vector<uint8_t> bytes;
     s >> bytes;
-    if (bytes.empty()) {
-      bits = {0};
-    } else {
-      import_bits(bits, bytes.begin(), bytes.end());
+    if (bytes.size() > 8 * Bits::kWords) {
+      outcome::raise(codec::cbor::CborDecodeError::kWrongSize);
+    }
+    bits = {};
+    auto bit{8 * bytes.size()};
+    for (auto byte : bytes) {
+      bit -= 8;
+      bits.words[bit / 64] |= uint64_t{byte} << (bit % 64);
     }
     return s;
   }
@@ -62,14 +110,128 @@ namespace fc::storage::hamt {
   /** Hamt node representation */
   struct Node {
     using Ptr = std::shared_ptr<Node>;
-    using Leaf = std::map<std::string, Value>;
+    /// Sorted key-value pairs, stored inline
+    using Leaf = boost::container::flat_map<
+        std::string,
+        Value,
+        std::less<>,
+        boost::container::small_vector<std::pair<std::string, Value>,
+                                       kLeafMax>>;
     using Item = boost::variant<CID, Ptr, Leaf>;
 
-    std::map<size_t, Item> items;
+    /** Items stored densely in index order, position is rank of index */
+    struct Items {
+      size_t size() const {
+        return dense.size();
+      }
+
+      bool empty() const {
+        return dense.empty();
+      }
+
+      const Item *find(size_t index) const {
+        return bits.test(index) ? &dense[bits.rank(index)] : nullptr;
+      }
+
+      Item *find(size_t index) {
+        return bits.test(index) ? &dense[bits.rank(index)] : nullptr;
+      }
+
+      /** Get item by index, inserting if not present */
+      Item &operator[](size_t index) {
+        auto position{bits.rank(index)};
+        if (!bits.test(index)) {
+          bits.set(index);
+          dense.emplace(dense.begin() + position);
+        }
+        return dense[position];
+      }
+
+      void erase(size_t index) {
+        if (bits.test(index)) {
+          dense.erase(dense.begin() + bits.rank(index));
+          bits.reset(index);
+        }
+      }
+
+      auto begin() {
+        return dense.begin();
+      }
+      auto end() {
+        return dense.end();
+      }
+      auto begin() const {
+        return dense.begin();
+      }
+      auto end() const {
+        return dense.end();
+      }
+
+      Bits bits;
+      boost::container::small_vector<Item, 4> dense;
+    };
+
+    Items items;
     boost::optional<bool> v3;
   };
   CBOR2_DECODE_ENCODE(Node)
 
+  /**
+   * Pool of node allocations shared by copies of one Hamt.
+   * Freed blocks are reused, memory is released with last node.
+   */
+  class NodeArena {
+   public:
+    NodeArena() = default;
+    NodeArena(const NodeArena &) = delete;
+    NodeArena &operator=(const NodeArena &) = delete;
+    ~NodeArena();
+
+    void *allocate(size_t size);
+    void deallocate(void *ptr, size_t size);
+
+   private:
+    static constexpr size_t kChunkBlocks{256};
+
+    std::mutex mutex_;
+    size_t block_{0};
+    std::vector<uint8_t *> chunks_;
+    size_t chunk_used_{kChunkBlocks};
+    void *free_{nullptr};
+  };
+
+  /** Allocator for `std::allocate_shared` from NodeArena */
+  template <typename T>
+  struct ArenaAllocator {
+    using value_type = T;
+
+    explicit ArenaAllocator(std::shared_ptr<NodeArena> arena)
+        : arena{std::move(arena)} {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) : arena{other.arena} {}
+
+    T *allocate(size_t n) {
+      return static_cast<T *>(arena->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T *ptr, size_t n) {
+      arena->deallocate(ptr, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U> &other) const {
+      return arena == other.arena;
+    }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U> &other) const {
+      return arena != other.arena;
+    }
+
+    std::shared_ptr<NodeArena> arena;
+  };
+
+  class HamtIndex;
+
   // TODO(turuslan): v3 caching
   /**
    * Hamt map
@@ -79,6 +241,11 @@ namespace fc::storage::hamt {
    public:
     using Visitor = std::function<outcome::result<void>(const std::string &,
                                                         const Value &)>;
+    /// Called with key and its values before and after, none if absent
+    using DiffVisitor = std::function<outcome::result<void>(
+        const std::string &,
+        const boost::optional<Value> &,
+        const boost::optional<Value> &)>;
 
     Hamt(std::shared_ptr<ipfs::IpfsDatastore> store, size_t bit_width, bool v3);
     Hamt(std::shared_ptr<ipfs::IpfsDatastore> store,
@@ -89,6 +256,18 @@ namespace fc::storage::hamt {
          const CID &root,
          size_t bit_width,
          bool v3);
+    /**
+     * Build hamt bottom-up, writing each node once.
+     * Items are sorted by key hash internally, for duplicate keys last value
+     * is used. Result is same as `set` of each item and `flush`.
+     * @return root cid
+     */
+    static outcome::result<CID> build(
+        std::shared_ptr<ipfs::IpfsDatastore> store,
+        std::vector<std::pair<std::string, Value>> items,
+        size_t bit_width,
+        bool v3);
+
     /** Set value by key, does not write to storage */
     outcome::result<void> set(const std::string &key,
                               gsl::span<const uint8_t> value);
@@ -122,6 +301,14 @@ namespace fc::storage::hamt {
     /** Loads root item */
     outcome::result<void> loadRoot();
 
+    /**
+     * Visit keys added, removed or changed between two hamts.
+     * Subtrees with same cid are skipped without loading.
+     */
+    static outcome::result<void> diff(const Hamt &before,
+                                      const Hamt &after,
+                                      const DiffVisitor &visitor);
+
     /// Store CBOR encoded value by key
     template <typename T>
     outcome::result<void> setCbor(const std::string &key, const T &value) {
@@ -154,6 +341,8 @@ namespace fc::storage::hamt {
     IpldPtr ipld;
 
    private:
+    friend HamtIndex;
+
     std::vector<size_t> keyToIndices(const std::string &key, int n = -1) const;
     outcome::result<void> set(Node &node,
                               gsl::span<const size_t> indices,
@@ -166,7 +355,14 @@ namespace fc::storage::hamt {
     outcome::result<void> flush(Node::Item &item);
     outcome::result<void> loadItem(Node::Item &item) const;
     outcome::result<void> visit(Node::Item &item, const Visitor &visitor) const;
+    static outcome::result<void> diff(const Hamt &before,
+                                      Node::Item *item_before,
+                                      const Hamt &after,
+                                      Node::Item *item_after,
+                                      const DiffVisitor &visitor);
+    Node::Ptr makeNode(Node node) const;
 
+    std::shared_ptr<NodeArena> arena_;
     mutable Node::Item root_;
     size_t bit_width_;
     bool v3_;
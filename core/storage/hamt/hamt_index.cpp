@@ -0,0 +1,102 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/hamt/hamt_index.hpp"
+
+namespace fc::storage::hamt {
+  HamtIndex::HamtIndex(std::shared_ptr<PersistentBufferMap> kv)
+      : kv_{std::move(kv)} {}
+
+  outcome::result<uint64_t> HamtIndex::count(const Hamt &hamt) {
+    uint64_t count{};
+    OUTCOME_TRY(walk(hamt.ipld, hamt.root_, count, nullptr));
+    return count;
+  }
+
+  outcome::result<std::vector<std::string>> HamtIndex::keys(
+      const Hamt &hamt) {
+    uint64_t count{};
+    std::vector<std::string> keys;
+    OUTCOME_TRY(walk(hamt.ipld, hamt.root_, count, &keys));
+    return keys;
+  }
+
+  outcome::result<HamtIndex::Entry> HamtIndex::entry(const IpldPtr &ipld,
+                                                     const CID &cid) {
+    OUTCOME_TRY(key, cid.toBytes());
+    if (kv_->contains(key)) {
+      OUTCOME_TRY(raw, kv_->get(key));
+      return codec::cbor::decode<Entry>(raw);
+    }
+    OUTCOME_TRY(node, ipld->getCbor<Node>(cid));
+    Entry entry;
+    std::vector<Buffer> keys;
+    auto small{true};
+    for (auto &item : node.items) {
+      if (auto leaf{boost::get<Node::Leaf>(&item)}) {
+        entry.count += leaf->size();
+        if (small) {
+          for (auto &pair : *leaf) {
+            keys.emplace_back(common::span::cbytes(pair.first));
+          }
+        }
+      } else if (auto child_cid{boost::get<CID>(&item)}) {
+        OUTCOME_TRY(child, this->entry(ipld, *child_cid));
+        entry.count += child.count;
+        if (small && child.keys) {
+          keys.insert(keys.end(),
+                      std::make_move_iterator(child.keys->begin()),
+                      std::make_move_iterator(child.keys->end()));
+        } else {
+          small = false;
+        }
+      } else {
+        return HamtError::kExpectedCID;
+      }
+      small = small && entry.count <= kKeysMax;
+    }
+    if (small) {
+      entry.keys = std::move(keys);
+    }
+    OUTCOME_TRY(raw, codec::cbor::encode(entry));
+    OUTCOME_TRY(kv_->put(key, raw));
+    return entry;
+  }
+
+  outcome::result<void> HamtIndex::walk(const IpldPtr &ipld,
+                                        const Node::Item &item,
+                                        uint64_t &count,
+                                        std::vector<std::string> *keys) {
+    if (auto leaf{boost::get<Node::Leaf>(&item)}) {
+      count += leaf->size();
+      if (keys) {
+        for (auto &pair : *leaf) {
+          keys->push_back(pair.first);
+        }
+      }
+    } else if (auto cid{boost::get<CID>(&item)}) {
+      OUTCOME_TRY(entry, this->entry(ipld, *cid));
+      if (!keys) {
+        count += entry.count;
+      } else if (entry.keys) {
+        count += entry.count;
+        for (auto &key : *entry.keys) {
+          keys->emplace_back(key.begin(), key.end());
+        }
+      } else {
+        OUTCOME_TRY(node, ipld->getCbor<Node>(*cid));
+        for (auto &item2 : node.items) {
+          OUTCOME_TRY(walk(ipld, item2, count, keys));
+        }
+      }
+    } else {
+      // not flushed
+      for (auto &item2 : boost::get<Node::Ptr>(item)->items) {
+        OUTCOME_TRY(walk(ipld, item2, count, keys));
+      }
+    }
+    return outcome::success();
+  }
+}  // namespace fc::storage::hamt
@@ -0,0 +1,49 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "storage/buffer_map.hpp"
+#include "storage/hamt/hamt.hpp"
+
+namespace fc::storage::hamt {
+  /** Entry count and keys of hamt subtree */
+  struct HamtIndexEntry {
+    uint64_t count{};
+    /// present if count is not above HamtIndex::kKeysMax
+    boost::optional<std::vector<Buffer>> keys;
+  };
+  CBOR_TUPLE(HamtIndexEntry, count, keys)
+
+  /**
+   * Persistent index of hamt subtree entry counts and keys by node cid.
+   * Nodes are immutable, so subtrees shared by different roots are counted
+   * once. Filled lazily when subtree is first counted.
+   */
+  class HamtIndex {
+   public:
+    /// Keys are stored only for subtrees with at most this many entries
+    static constexpr uint64_t kKeysMax{1024};
+
+    explicit HamtIndex(std::shared_ptr<PersistentBufferMap> kv);
+
+    /// Count entries of hamt
+    outcome::result<uint64_t> count(const Hamt &hamt);
+
+    /// Keys of hamt in visit order
+    outcome::result<std::vector<std::string>> keys(const Hamt &hamt);
+
+   private:
+    using Entry = HamtIndexEntry;
+
+    outcome::result<Entry> entry(const IpldPtr &ipld, const CID &cid);
+    outcome::result<void> walk(const IpldPtr &ipld,
+                               const Node::Item &item,
+                               uint64_t &count,
+                               std::vector<std::string> *keys);
+
+    std::shared_ptr<PersistentBufferMap> kv_;
+  };
+}  // namespace fc::storage::hamt
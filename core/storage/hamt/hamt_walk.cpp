@@ -5,6 +5,8 @@
 
 #include "storage/hamt/hamt.hpp"
 
+#include <algorithm>
+#include <map>
 #include <libp2p/crypto/sha/sha256.hpp>
 
 #include "common/which.hpp"
@@ -28,10 +30,8 @@ namespace fc::storage::hamt {
   using fc::common::which;
 
   CBOR2_ENCODE(Node) {
-    Bits bits;
     auto l_items{s.list()};
-    for (auto &[index, value] : v.items) {
-      bit_set(bits, index);
+    for (auto &value : v.items) {
       if (boost::get<Node::Ptr>(&value)) {
         outcome::raise(HamtError::kExpectedCID);
       }
@@ -54,21 +54,21 @@ namespace fc::storage::hamt {
         l_items << m_item;
       }
     }
-    return s << (s.list() << bits << l_items);
+    return s << (s.list() << v.items.bits << l_items);
   }
 
   CBOR2_DECODE(Node) {
-    v.items.clear();
+    v.items = {};
     auto l_node = s.list();
-    Bits bits;
+    auto &bits{v.items.bits};
     l_node >> bits;
     auto n_items = l_node.listLength();
+    if (n_items != bits.rank(Bits::kWords * 64)) {
+      outcome::raise(HamtError::kInconsistent);
+    }
     auto l_items = l_node.list();
-    size_t j = 0;
+    v.items.dense.reserve(n_items);
     for (size_t i = 0; i < n_items; ++i) {
-      while (!bit_test(bits, j)) {
-        ++j;
-      }
       auto _item{l_items};
       l_items.next();
       auto v3{true};
@@ -86,23 +86,58 @@ namespace fc::storage::hamt {
         outcome::raise(HamtError::kInconsistent);
       }
       if (_item.isCid()) {
-        v.items[j] = _item.get<CID>();
+        v.items.dense.emplace_back(_item.get<CID>());
       } else {
         auto n_leaf{_item.listLength()};
         auto l_leaf{_item.list()};
         Node::Leaf leaf;
+        leaf.reserve(n_leaf);
         for (size_t j = 0; j < n_leaf; ++j) {
           auto l_pair{l_leaf.list()};
           auto key{l_pair.get<Buffer>()};
           leaf.emplace(std::string{key.begin(), key.end()}, l_pair.raw());
         }
-        v.items[j] = std::move(leaf);
+        v.items.dense.emplace_back(std::move(leaf));
       }
-      ++j;
     }
     return s;
   }
 
+  NodeArena::~NodeArena() {
+    for (auto chunk : chunks_) {
+      delete[] chunk;
+    }
+  }
+
+  void *NodeArena::allocate(size_t size) {
+    std::lock_guard lock{mutex_};
+    if (block_ == 0) {
+      constexpr auto kAlign{alignof(std::max_align_t)};
+      block_ = std::max(sizeof(void *), (size + kAlign - 1) / kAlign * kAlign);
+    } else if (size > block_) {
+      return ::operator new(size);
+    }
+    if (free_) {
+      auto ptr{free_};
+      free_ = *static_cast<void **>(free_);
+      return ptr;
+    }
+    if (chunk_used_ == kChunkBlocks) {
+      chunks_.push_back(new uint8_t[kChunkBlocks * block_]);
+      chunk_used_ = 0;
+    }
+    return chunks_.back() + block_ * chunk_used_++;
+  }
+
+  void NodeArena::deallocate(void *ptr, size_t size) {
+    std::lock_guard lock{mutex_};
+    if (size > block_) {
+      return ::operator delete(ptr);
+    }
+    *static_cast<void **>(ptr) = free_;
+    free_ = ptr;
+  }
+
   auto consumeIndex(gsl::span<const size_t> indices) {
     return indices.subspan(1);
   }
@@ -111,24 +146,111 @@ namespace fc::storage::hamt {
              size_t bit_width,
              bool v3)
       : ipld{std::move(store)},
-        root_{std::make_shared<Node>(Node{{}, v3})},
+        arena_{std::make_shared<NodeArena>()},
+        root_{makeNode({{}, v3})},
         bit_width_{bit_width},
-        v3_{v3} {}
+        v3_{v3} {
+    assert(bit_width_ <= kMaxBitWidth);
+  }
 
   Hamt::Hamt(std::shared_ptr<ipfs::IpfsDatastore> store,
              Node::Ptr root,
              size_t bit_width,
              bool v3)
       : ipld{std::move(store)},
+        arena_{std::make_shared<NodeArena>()},
         root_{std::move(root)},
         bit_width_{bit_width},
-        v3_{v3} {}
+        v3_{v3} {
+    assert(bit_width_ <= kMaxBitWidth);
+  }
 
   Hamt::Hamt(std::shared_ptr<ipfs::IpfsDatastore> store,
              const CID &root,
              size_t bit_width,
              bool v3)
-      : ipld{std::move(store)}, root_{root}, bit_width_{bit_width}, v3_{v3} {}
+      : ipld{std::move(store)},
+        arena_{std::make_shared<NodeArena>()},
+        root_{root},
+        bit_width_{bit_width},
+        v3_{v3} {
+    assert(bit_width_ <= kMaxBitWidth);
+  }
+
+  outcome::result<CID> Hamt::build(
+      std::shared_ptr<ipfs::IpfsDatastore> store,
+      std::vector<std::pair<std::string, Value>> items,
+      size_t bit_width,
+      bool v3) {
+    assert(bit_width <= kMaxBitWidth);
+    using Hash = libp2p::common::Hash256;
+    std::vector<std::pair<Hash, size_t>> sorted;
+    sorted.reserve(items.size());
+    for (size_t i{0}; i < items.size(); ++i) {
+      sorted.emplace_back(
+          libp2p::crypto::sha256(common::span::cbytes(items[i].first)), i);
+    }
+    std::sort(sorted.begin(), sorted.end());
+    // last value of same key
+    auto same{[&](auto &l, auto &r) {
+      return l.first == r.first
+             && items[l.second].first == items[r.second].first;
+    }};
+    for (size_t i{1}; i < sorted.size(); ++i) {
+      if (same(sorted[i - 1], sorted[i])) {
+        sorted[i - 1].second = items.size();
+      }
+    }
+    sorted.erase(
+        std::remove_if(sorted.begin(),
+                       sorted.end(),
+                       [&](auto &x) { return x.second == items.size(); }),
+        sorted.end());
+
+    const auto max_depth{8 * std::tuple_size_v<Hash> / bit_width};
+    // same bits as keyToIndices
+    auto indexAt{[&](const Hash &hash, size_t depth) {
+      size_t index{0};
+      for (auto offset{depth * bit_width}; offset < (depth + 1) * bit_width;
+           ++offset) {
+        index = (index << 1) | (1 & (hash[offset / 8] >> (7 - offset % 8)));
+      }
+      return index;
+    }};
+    std::function<outcome::result<Node>(
+        gsl::span<const std::pair<Hash, size_t>>, size_t)>
+        make{[&](auto range, size_t depth) -> outcome::result<Node> {
+          if (depth >= max_depth) {
+            return HamtError::kMaxDepth;
+          }
+          Node node{{}, v3};
+          while (!range.empty()) {
+            auto index{indexAt(range[0].first, depth)};
+            size_t count{1};
+            while (count < range.size()
+                   && indexAt(range[count].first, depth) == index) {
+              ++count;
+            }
+            auto group{range.first(count)};
+            range = range.subspan(count);
+            if (count <= kLeafMax) {
+              Node::Leaf leaf;
+              for (auto &[hash, i] : group) {
+                leaf.emplace(std::move(items[i].first),
+                             std::move(items[i].second));
+              }
+              node.items[index] = std::move(leaf);
+            } else {
+              OUTCOME_TRY(child, make(group, depth + 1));
+              OUTCOME_TRY(cid, store->setCbor(child));
+              node.items[index] = std::move(cid);
+            }
+          }
+          return node;
+        }};
+    OUTCOME_TRY(root, make(sorted, 0));
+    return store->setCbor(root);
+  }
 
   outcome::result<void> Hamt::set(const std::string &key,
                                   gsl::span<const uint8_t> value) {
@@ -140,20 +262,20 @@ namespace fc::storage::hamt {
     OUTCOME_TRY(loadItem(root_));
     auto node = boost::get<Node::Ptr>(root_);
     for (auto index : keyToIndices(key)) {
-      auto it = node->items.find(index);
-      if (it == node->items.end()) {
+      auto item = node->items.find(index);
+      if (!item) {
         return HamtError::kNotFound;
       }
-      auto &item = it->second;
-      OUTCOME_TRY(loadItem(item));
-      if (which<Node::Ptr>(item)) {
-        node = boost::get<Node::Ptr>(item);
+      OUTCOME_TRY(loadItem(*item));
+      if (which<Node::Ptr>(*item)) {
+        node = boost::get<Node::Ptr>(*item);
       } else {
-        auto &leaf = boost::get<Node::Leaf>(item);
-        if (leaf.find(key) == leaf.end()) {
+        auto &leaf = boost::get<Node::Leaf>(*item);
+        auto it = leaf.find(key);
+        if (it == leaf.end()) {
           return HamtError::kNotFound;
         }
-        return leaf[key];
+        return it->second;
       }
     }
     return HamtError::kMaxDepth;
@@ -214,14 +336,14 @@ namespace fc::storage::hamt {
       return HamtError::kMaxDepth;
     }
     auto index = indices[0];
-    auto it = node.items.find(index);
-    if (it == node.items.end()) {
+    auto _item = node.items.find(index);
+    if (!_item) {
       Node::Leaf leaf;
       leaf.emplace(key, std::vector<uint8_t>(value.begin(), value.end()));
-      node.items[index] = leaf;
+      node.items[index] = std::move(leaf);
       return outcome::success();
     }
-    auto &item = it->second;
+    auto &item = *_item;
     OUTCOME_TRY(loadItem(item));
     if (which<Node::Ptr>(item)) {
       return set(
@@ -231,8 +353,7 @@ namespace fc::storage::hamt {
     if (leaf.find(key) != leaf.end() || leaf.size() < kLeafMax) {
       leaf[key] = Value(value);
     } else {
-      auto child = std::make_shared<Node>();
-      child->v3 = v3_;
+      auto child = makeNode({{}, v3_});
       OUTCOME_TRY(set(*child, consumeIndex(indices), key, value));
       for (auto &pair : leaf) {
         auto indices2 = keyToIndices(pair.first, indices.size());
@@ -250,11 +371,11 @@ namespace fc::storage::hamt {
       return HamtError::kMaxDepth;
     }
     auto index = indices[0];
-    auto it = node.items.find(index);
-    if (it == node.items.end()) {
+    auto _item = node.items.find(index);
+    if (!_item) {
       return HamtError::kNotFound;
     }
-    auto &item = it->second;
+    auto &item = *_item;
     OUTCOME_TRY(loadItem(item));
     if (which<Node::Ptr>(item)) {
       OUTCOME_TRY(
@@ -277,17 +398,18 @@ namespace fc::storage::hamt {
   outcome::result<void> Hamt::cleanShard(Node::Item &item) {
     auto &node = *boost::get<Node::Ptr>(item);
     if (node.items.size() == 1) {
-      auto &single_item = node.items.begin()->second;
+      auto &single_item = *node.items.begin();
       if (which<Node::Leaf>(single_item)) {
-        item = single_item;
+        // copy, single_item is owned by item
+        item = Node::Item{single_item};
       }
     } else if (node.items.size() <= kLeafMax) {
       Node::Leaf leaf;
       for (auto &item2 : node.items) {
-        if (!which<Node::Leaf>(item2.second)) {
+        if (!which<Node::Leaf>(item2)) {
           return outcome::success();
         }
-        for (auto &pair : boost::get<Node::Leaf>(item2.second)) {
+        for (auto &pair : boost::get<Node::Leaf>(item2)) {
           leaf.emplace(pair);
           if (leaf.size() > kLeafMax) {
             return outcome::success();
@@ -303,7 +425,7 @@ namespace fc::storage::hamt {
     if (which<Node::Ptr>(item)) {
       auto &node = *boost::get<Node::Ptr>(item);
       for (auto &item2 : node.items) {
-        OUTCOME_TRY(flush(item2.second));
+        OUTCOME_TRY(flush(item2));
       }
       OUTCOME_TRY(cid, ipld->setCbor(node));
       item = cid;
@@ -323,11 +445,16 @@ namespace fc::storage::hamt {
       } else if (*child.v3 != v3_) {
         return HamtError::kInconsistent;
       }
-      item = std::make_shared<Node>(std::move(child));
+      item = makeNode(std::move(child));
     }
     return outcome::success();
   }
 
+  Node::Ptr Hamt::makeNode(Node node) const {
+    return std::allocate_shared<Node>(ArenaAllocator<Node>{arena_},
+                                      std::move(node));
+  }
+
   outcome::result<void> Hamt::visit(const Visitor &visitor) const {
     return visit(root_, visitor);
   }
@@ -336,8 +463,19 @@ namespace fc::storage::hamt {
                                     const Visitor &visitor) const {
     OUTCOME_TRY(loadItem(item));
     if (which<Node::Ptr>(item)) {
-      for (auto &item2 : boost::get<Node::Ptr>(item)->items) {
-        OUTCOME_TRY(visit(item2.second, visitor));
+      auto &items{boost::get<Node::Ptr>(item)->items};
+      // request all children at once, they are loaded in order below
+      std::vector<CID> cids;
+      for (auto &item2 : items) {
+        if (which<CID>(item2)) {
+          cids.push_back(boost::get<CID>(item2));
+        }
+      }
+      if (!cids.empty()) {
+        ipld->prefetch(cids);
+      }
+      for (auto &item2 : items) {
+        OUTCOME_TRY(visit(item2, visitor));
       }
     } else {
       for (auto &pair : boost::get<Node::Leaf>(item)) {
@@ -346,4 +484,85 @@ namespace fc::storage::hamt {
     }
     return outcome::success();
   }
+
+  outcome::result<void> Hamt::diff(const Hamt &before,
+                                   const Hamt &after,
+                                   const DiffVisitor &visitor) {
+    return diff(before, &before.root_, after, &after.root_, visitor);
+  }
+
+  outcome::result<void> Hamt::diff(const Hamt &before,
+                                   Node::Item *item_before,
+                                   const Hamt &after,
+                                   Node::Item *item_after,
+                                   const DiffVisitor &visitor) {
+    if (item_before && item_after) {
+      if (which<CID>(*item_before) && which<CID>(*item_after)
+          && boost::get<CID>(*item_before) == boost::get<CID>(*item_after)) {
+        return outcome::success();
+      }
+      if (which<Node::Ptr>(*item_before) && which<Node::Ptr>(*item_after)
+          && boost::get<Node::Ptr>(*item_before)
+                 == boost::get<Node::Ptr>(*item_after)) {
+        return outcome::success();
+      }
+      OUTCOME_TRY(before.loadItem(*item_before));
+      OUTCOME_TRY(after.loadItem(*item_after));
+      if (which<Node::Ptr>(*item_before) && which<Node::Ptr>(*item_after)) {
+        auto &items_before{boost::get<Node::Ptr>(*item_before)->items};
+        auto &items_after{boost::get<Node::Ptr>(*item_after)->items};
+        for (size_t word{0}; word < Bits::kWords; ++word) {
+          auto bits{items_before.bits.words[word]
+                    | items_after.bits.words[word]};
+          while (bits != 0) {
+            auto index{64 * word + __builtin_ctzll(bits)};
+            bits &= bits - 1;
+            OUTCOME_TRY(diff(before,
+                             items_before.find(index),
+                             after,
+                             items_after.find(index),
+                             visitor));
+          }
+        }
+        return outcome::success();
+      }
+    }
+    // leaf on either side, subtrees are small enough to compare entries
+    std::map<std::string, Value, std::less<>> values_before, values_after;
+    if (item_before) {
+      OUTCOME_TRY(before.visit(*item_before, [&](auto &key, auto &value) {
+        values_before.emplace(key, value);
+        return outcome::success();
+      }));
+    }
+    if (item_after) {
+      OUTCOME_TRY(after.visit(*item_after, [&](auto &key, auto &value) {
+        values_after.emplace(key, value);
+        return outcome::success();
+      }));
+    }
+    auto it_before{values_before.begin()};
+    auto it_after{values_after.begin()};
+    while (it_before != values_before.end()
+           || it_after != values_after.end()) {
+      if (it_after == values_after.end()
+          || (it_before != values_before.end()
+              && it_before->first < it_after->first)) {
+        OUTCOME_TRY(visitor(it_before->first, it_before->second, boost::none));
+        ++it_before;
+      } else if (it_before == values_before.end()
+                 || it_after->first < it_before->first) {
+        OUTCOME_TRY(visitor(it_after->first, boost::none, it_after->second));
+        ++it_after;
+      } else {
+        if (it_before->second != it_after->second) {
+          OUTCOME_TRY(visitor(
+              it_before->first, it_before->second, it_after->second));
+        }
+        ++it_before;
+        ++it_after;
+      }
+    }
+    return outcome::success();
+  }
 }  // namespace fc::storage::hamt
@@ -49,6 +49,13 @@ namespace fc::storage::ipfs {
 
     virtual std::shared_ptr<IpfsDatastore> shared() = 0;
 
+    /**
+     * @brief hints that keys will be read soon, so store may start loading
+     * them in background
+     * @param keys keys to be read
+     */
+    virtual void prefetch(gsl::span<const CID> keys) const {}
+
     /**
      * @brief CBOR-serialize value and store
      * @param value - data to serialize and store
@@ -62,11 +69,11 @@ namespace fc::storage::ipfs {
       return std::move(key);
     }
 
-    /// Get CBOR decoded value by CID
+    /// Get CBOR decoded value by CID, `BytesView` fields share the block
     template <typename T>
     outcome::result<T> getCbor(const CID &key) const {
       OUTCOME_TRY(bytes, get(key));
-      return decode<T>(bytes);
+      return decode<T>(std::make_shared<const Value>(std::move(bytes)));
     }
 
     template <typename T>
@@ -82,6 +89,13 @@ namespace fc::storage::ipfs {
       return std::move(value);
     }
 
+    template <typename T>
+    outcome::result<T> decode(std::shared_ptr<const Value> input) const {
+      OUTCOME_TRY(value, codec::cbor::decode<T>(std::move(input)));
+      load(value);
+      return std::move(value);
+    }
+
     template <typename T>
     void load(T &value) const {
       Load<T>::call(const_cast<IpfsDatastore &>(*this), value);
@@ -5,7 +5,11 @@
 
 #include "storage/ipld/cids_ipld.hpp"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/filesystem/operations.hpp>
 #include "codec/uvarint.hpp"
 #include "common/error_text.hpp"
@@ -15,9 +19,39 @@
 
 namespace fc::storage::ipld {
   using cids_index::kCborBlakePrefix;
+  using cids_index::maxSize;
   using cids_index::maxSize64;
   using cids_index::MergeRange;
 
+  CarMmap::~CarMmap() {
+    if (data) {
+      munmap(const_cast<uint8_t *>(data), size);
+    }
+  }
+
+  CidsIpld::~CidsIpld() {
+    if (car_fd != -1) {
+      close(car_fd);
+    }
+  }
+
+  outcome::result<std::shared_ptr<const CarMmap>> CarMmap::map(
+      const std::string &path, size_t size) {
+    auto fd{open(path.c_str(), O_RDONLY)};
+    if (fd == -1) {
+      return ERROR_TEXT("CarMmap::map: open failed");
+    }
+    auto ptr{::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0)};
+    close(fd);
+    if (ptr == MAP_FAILED) {
+      return ERROR_TEXT("CarMmap::map: mmap failed");
+    }
+    auto car{std::make_shared<CarMmap>()};
+    car->data = static_cast<const uint8_t *>(ptr);
+    car->size = size;
+    return car;
+  }
+
   boost::optional<Row> CidsIpld::findWritten(const Key &key) const {
     assert(writable.is_open());
     auto it{written.lower_bound(Row{key, {}, {}})};
@@ -81,28 +115,26 @@ namespace fc::storage::ipld {
     written_slock.unlock();
     std::sort(rows.begin(), rows.end());
 
-    std::ifstream index_in{index_path, std::ios::binary};
-    std::vector<MergeRange> ranges;
-    auto &range1{ranges.emplace_back()};
-    range1.begin = 1;
-    range1.end = 1 + index->size();
-    range1.file = &index_in;
-    auto &range2{ranges.emplace_back()};
-    range2.current = 0;
-    range2.rows = std::move(rows);
-    auto tmp_path{index_path + ".tmp"};
-    std::ofstream index_out{tmp_path, std::ios::binary};
-    OUTCOME_TRY(merge(index_out, std::move(ranges)));
-
-    OUTCOME_TRY(new_index, cids_index::load(tmp_path, max_memory));
-    std::unique_lock index_lock{index_mutex};
-    boost::system::error_code ec;
-    boost::filesystem::rename(tmp_path, index_path, ec);
-    if (ec) {
-      return ec;
-    }
-    index = new_index;
-    index_lock.unlock();
+    if (!rows.empty()) {
+      auto current{std::atomic_load(&index)};
+      auto new_index{std::make_shared<SegmentsIndex>(*current)};
+      auto path{new_index->deltaPath(new_index->next_id++)};
+      std::vector<MergeRange> ranges;
+      auto &range{ranges.emplace_back()};
+      range.current = 0;
+      range.rows = std::move(rows);
+      std::ofstream index_out{path, std::ios::binary};
+      OUTCOME_TRY(merge(index_out, std::move(ranges)));
+      index_out.close();
+      OUTCOME_TRY(delta, cids_index::load(path, max_memory, mmap));
+      new_index->segments.push_back({path, delta});
+      new_index->updateInfo();
+      OUTCOME_TRY(new_index->saveManifest());
+      saveBloom(new_index->info);
+      std::unique_lock index_lock{index_mutex};
+      std::atomic_store(&index, new_index);
+      index_lock.unlock();
+    }
 
     std::unique_lock written_ulock{written_mutex};
     for (auto it{written.begin()}; it != written.end();) {
@@ -114,26 +146,163 @@ namespace fc::storage::ipld {
     }
     written_ulock.unlock();
 
+    OUTCOME_TRY(compact());
+
+    auto _bloom{std::atomic_load(&bloom)};
+    auto current{std::atomic_load(&index)};
+    if (_bloom && current->size() > _bloom->maxCount()) {
+      // rebuild filter when it is full
+      std::vector<std::string> paths;
+      for (auto &segment : current->segments) {
+        paths.push_back(segment.path);
+      }
+      OUTCOME_TRY(new_bloom,
+                  BloomFilter::build(
+                      paths, BloomFilter::capacity(current->size(), true)));
+      if (auto r{new_bloom->save(bloom_path, current->info)}; !r) {
+        spdlog::warn("CidsIpld({}) bloom save: {:#}", index_path, ~r);
+      }
+      std::unique_lock written_lock{written_mutex};
+      for (auto &row : written) {
+        new_bloom->add(row.key);
+      }
+      std::atomic_store(&bloom, new_bloom);
+    }
+
     flushing.clear();
 
     return outcome::success();
   }
 
+  Outcome<void> CidsIpld::compact() {
+    while (true) {
+      auto current{std::atomic_load(&index)};
+      auto range{current->compaction()};
+      if (!range) {
+        break;
+      }
+      auto [begin, end]{*range};
+      auto base{begin == 0};
+      auto new_index{std::make_shared<SegmentsIndex>(*current)};
+      auto path{base ? index_path + ".tmp"
+                     : new_index->deltaPath(new_index->next_id++)};
+      std::vector<MergeRange> ranges;
+      std::vector<std::ifstream> files(end - begin);
+      for (auto i{begin}; i < end; ++i) {
+        auto &segment{current->segments[i]};
+        auto &file{files[i - begin]};
+        file.open(segment.path, std::ios::binary);
+        auto &range{ranges.emplace_back()};
+        range.file = &file;
+        range.path = segment.path;
+        range.begin = 1;
+        range.end = 1 + segment.index->size();
+      }
+      std::ofstream out{path, std::ios::binary};
+      OUTCOME_TRY(merge(out, std::move(ranges)));
+      out.close();
+      auto merged_path{base ? index_path : path};
+      new_index->segments.erase(new_index->segments.begin() + begin,
+                                new_index->segments.end());
+      OUTCOME_TRY(merged, cids_index::load(path, max_memory, mmap));
+      new_index->segments.push_back({merged_path, merged});
+      new_index->updateInfo();
+      // manifest is saved before base is replaced, so crash loses only
+      // deltas which are indexed again from car
+      OUTCOME_TRY(new_index->saveManifest());
+      saveBloom(new_index->info);
+      std::unique_lock index_lock{index_mutex};
+      if (base) {
+        boost::system::error_code ec;
+        boost::filesystem::rename(path, index_path, ec);
+        if (ec) {
+          return ec;
+        }
+      }
+      std::atomic_store(&index, new_index);
+      index_lock.unlock();
+      for (auto i{begin}; i < end; ++i) {
+        auto &old_path{current->segments[i].path};
+        if (old_path != index_path) {
+          boost::system::error_code ec;
+          boost::filesystem::remove(old_path, ec);
+        }
+      }
+    }
+    return outcome::success();
+  }
+
+  void CidsIpld::saveBloom(const RowsInfo &info) const {
+    auto _bloom{std::atomic_load(&bloom)};
+    if (!_bloom || bloom_path.empty()) {
+      return;
+    }
+    if (auto r{_bloom->save(bloom_path, info)}; !r) {
+      spdlog::warn("CidsIpld({}) bloom save: {:#}", index_path, ~r);
+    }
+  }
+
+  std::shared_ptr<const CarMmap> CidsIpld::mapCar(const Row &row) const {
+    auto end{row.offset.value() + maxSize(row.max_size64.value())};
+    auto car{std::atomic_load(&car_mmap)};
+    if (car && (car->size >= end || car->size >= car_offset)) {
+      return car;
+    }
+    std::unique_lock car_lock{car_mutex};
+    car = std::atomic_load(&car_mmap);
+    if (car && (car->size >= end || car->size >= car_offset)) {
+      return car;
+    }
+    uint64_t size{car_offset};
+    if (writable.is_open()) {
+      // reserve address space for appended items
+      size = std::max<uint64_t>(size + size / 2, end + mmap_reserve);
+    }
+    auto _car{CarMmap::map(car_path, size)};
+    if (!_car) {
+      spdlog::error("CidsIpld.get mmap error: {:#}", _car.error());
+      outcome::raise(ERROR_TEXT("CidsIpld.get: mmap error"));
+    }
+    car = _car.value();
+    std::atomic_store(&car_mmap, car);
+    return car;
+  }
+
   bool CidsIpld::get(const Hash256 &key, Buffer *value) const {
     if (value) {
       value->resize(0);
     }
-    std::shared_lock index_lock{index_mutex};
-    auto row{index->find(key).value()};
-    index_lock.unlock();
+    auto _bloom{std::atomic_load(&bloom)};
+    if (_bloom && !_bloom->maybe(key)) {
+      ++bloom_absent;
+      return false;
+    }
+    auto row{std::atomic_load(&index)->find(key).value()};
     if (!row && writable.is_open()) {
       std::shared_lock written_lock{written_mutex};
       row = findWritten(key);
     }
     if (!row) {
+      if (_bloom) {
+        ++bloom_false_positive;
+      }
       return false;
     }
-    if (value) {
+    if (_bloom) {
+      ++bloom_present;
+    }
+    if (value && mmap) {
+      auto car{mapCar(*row)};
+      auto item{cids_index::readCarItem(
+          gsl::make_span(car->data,
+                         std::min<uint64_t>(car->size, car_offset)),
+          *row)};
+      if (!item) {
+        spdlog::error("CidsIpld.get inconsistent");
+        outcome::raise(ERROR_TEXT("CidsIpld.get: inconsistent"));
+      }
+      value->put(*item);
+    } else if (value) {
       std::unique_lock car_lock{car_mutex};
       auto [good, size]{readCarItem(car_file, *row, nullptr)};
       if (!good) {
@@ -183,6 +352,9 @@ namespace fc::storage::ipld {
       outcome::raise(ERROR_TEXT("CidsIpld.put: flush error"));
     }
     car_offset += item.size();
+    if (auto _bloom{std::atomic_load(&bloom)}) {
+      _bloom->add(key);
+    }
     written.insert(row);
     if (flush_on && written.size() >= flush_on) {
       written_lock.unlock();
@@ -206,6 +378,91 @@ namespace fc::storage::ipld {
     }
   }
 
+  void CidsIpld::prefetch(gsl::span<const CID> keys) const {
+    if (!prefetch_pool || keys.empty()) {
+      return;
+    }
+    if (prefetch_pending.fetch_add(1) >= kPrefetchMaxPending) {
+      --prefetch_pending;
+      return;
+    }
+    boost::asio::post(*prefetch_pool,
+                      [self{shared_from_this()},
+                       keys{std::vector<CID>{keys.begin(), keys.end()}}] {
+                        std::vector<CID> missing;
+                        for (const auto &cid : keys) {
+                          auto key{asBlake(cid)};
+                          if (!key || !self->readahead(*key)) {
+                            missing.push_back(cid);
+                          }
+                        }
+                        if (self->ipld && !missing.empty()) {
+                          self->ipld->prefetch(missing);
+                        }
+                        --self->prefetch_pending;
+                      });
+  }
+
+  void CidsIpld::prefetch(gsl::span<const Hash256> keys) const {
+    if (!prefetch_pool || keys.empty()) {
+      return;
+    }
+    if (prefetch_pending.fetch_add(1) >= kPrefetchMaxPending) {
+      --prefetch_pending;
+      return;
+    }
+    boost::asio::post(*prefetch_pool,
+                      [self{shared_from_this()},
+                       keys{std::vector<Hash256>{keys.begin(), keys.end()}}] {
+                        for (const auto &key : keys) {
+                          self->readahead(key);
+                        }
+                        --self->prefetch_pending;
+                      });
+  }
+
+  bool CidsIpld::readahead(const Hash256 &key) const {
+    auto _bloom{std::atomic_load(&bloom)};
+    if (_bloom && !_bloom->maybe(key)) {
+      return false;
+    }
+    auto _row{std::atomic_load(&index)->find(key)};
+    if (!_row) {
+      return false;
+    }
+    auto row{_row.value()};
+    if (!row && writable.is_open()) {
+      std::shared_lock written_lock{written_mutex};
+      row = findWritten(key);
+    }
+    if (!row) {
+      return false;
+    }
+    if (mmap) {
+      // index lookup above already warmed index pages
+      auto car{mapCar(*row)};
+      static const uint64_t page{static_cast<uint64_t>(sysconf(_SC_PAGESIZE))};
+      auto begin{row->offset.value() / page * page};
+      auto end{std::min<uint64_t>(
+          row->offset.value() + maxSize(row->max_size64.value()), car->size)};
+      if (begin < end) {
+        madvise(const_cast<uint8_t *>(car->data) + begin,
+                end - begin,
+                MADV_WILLNEED);
+      }
+    } else {
+      std::call_once(car_fd_once,
+                     [&] { car_fd = open(car_path.c_str(), O_RDONLY); });
+      if (car_fd != -1) {
+        posix_fadvise(car_fd,
+                      row->offset.value(),
+                      maxSize(row->max_size64.value()),
+                      POSIX_FADV_WILLNEED);
+      }
+    }
+    return true;
+  }
+
   outcome::result<bool> Ipld2Ipld::contains(const CID &cid) const {
     return ipld->has(*asBlake(cid));
   }
@@ -222,4 +479,15 @@ namespace fc::storage::ipld {
     }
     return std::move(value);
   }
+
+  void Ipld2Ipld::prefetch(gsl::span<const CID> keys) const {
+    std::vector<Hash256> blake;
+    blake.reserve(keys.size());
+    for (const auto &cid : keys) {
+      if (auto key{asBlake(cid)}) {
+        blake.push_back(*key);
+      }
+    }
+    ipld->prefetch(blake);
+  }
 }  // namespace fc::storage::ipld
@@ -8,17 +8,42 @@
 #include <fstream>
 #include <mutex>
 #include <shared_mutex>
+#include <boost/asio/thread_pool.hpp>
 
 #include "common/outcome2.hpp"
 #include "primitives/cid/cid.hpp"
-#include "storage/car/cids_index/cids_index.hpp"
+#include "storage/car/cids_index/bloom.hpp"
 #include "storage/ipfs/datastore.hpp"
 #include "storage/ipld/light_ipld.hpp"
 
 namespace fc::storage::ipld {
+  /// Prefetch hints are dropped while this many batches are queued
+  constexpr size_t kPrefetchMaxPending{64};
+
+  using cids_index::BloomFilter;
   using cids_index::Index;
   using cids_index::Key;
   using cids_index::Row;
+  using cids_index::RowsInfo;
+  using cids_index::SegmentsIndex;
+
+  /**
+   * Read-only shared mapping of car file.
+   * Mapping may be longer than file, car is append-only, so bytes below
+   * written offset are always readable.
+   */
+  struct CarMmap {
+    const uint8_t *data{};
+    size_t size{};
+
+    CarMmap() = default;
+    CarMmap(const CarMmap &) = delete;
+    CarMmap &operator=(const CarMmap &) = delete;
+    ~CarMmap();
+
+    static outcome::result<std::shared_ptr<const CarMmap>> map(
+        const std::string &path, size_t size);
+  };
 
   class CidsIpld : LightIpld,
                    public Ipld,
@@ -26,6 +51,8 @@ namespace fc::storage::ipld {
    public:
     using LightIpld::get;
 
+    ~CidsIpld() override;
+
     outcome::result<bool> contains(const CID &cid) const override;
     outcome::result<void> set(const CID &cid, Buffer value) override;
     outcome::result<Buffer> get(const CID &cid) const override;
@@ -38,26 +65,64 @@ namespace fc::storage::ipld {
 
     bool get(const Hash256 &key, Buffer *value) const override;
     void put(const Hash256 &key, BytesIn value) override;
+    /** looks up keys and asks kernel to read their car pages on pool */
+    void prefetch(gsl::span<const CID> keys) const override;
+    void prefetch(gsl::span<const Hash256> keys) const override;
+    /** returns true if key was found and its page read was requested */
+    bool readahead(const Hash256 &key) const;
 
     void asyncFlush();
 
     inline boost::optional<Row> findWritten(const Key &key) const;
+    /** writes written rows as delta segment and compacts segments */
     Outcome<void> doFlush();
+    /** merges segments of same tier */
+    Outcome<void> compact();
+    /** saves filter for index with info, so it is loaded on restart */
+    void saveBloom(const RowsInfo &info) const;
+
+    /** returns mapped car, remaps if row is past mapped length */
+    std::shared_ptr<const CarMmap> mapCar(const Row &row) const;
 
     mutable std::mutex car_mutex;
     mutable std::ifstream car_file;
+    /** opened on first readahead without mmap, for posix_fadvise */
+    mutable int car_fd{-1};
+    mutable std::once_flag car_fd_once;
+    /** use mmap instead of car_file and index file reads */
+    bool mmap{false};
+    std::string car_path;
+    /** accessed with std::atomic_load/std::atomic_store */
+    mutable std::shared_ptr<const CarMmap> car_mmap;
+    /** address space mapped past end of writable car, estimated */
+    uint64_t mmap_reserve{64 << 20};
+    /** guards index file replacement, readers use std::atomic_load */
     mutable std::shared_mutex index_mutex;
-    std::shared_ptr<Index> index;
+    std::shared_ptr<SegmentsIndex> index;
     IpldPtr ipld;
     std::ofstream writable;
     mutable std::shared_mutex written_mutex;
     std::set<Row> written;
-    uint64_t car_offset{};
+    std::atomic<uint64_t> car_offset{};
     std::atomic_flag flushing;
     size_t flush_on{};
     std::shared_ptr<boost::asio::io_context> io;
     std::string index_path;
     boost::optional<size_t> max_memory;
+    /** filter is not used if path is empty */
+    std::string bloom_path;
+    /** accessed with std::atomic_load/std::atomic_store */
+    std::shared_ptr<BloomFilter> bloom;
+    /** keys rejected by filter */
+    mutable std::atomic_size_t bloom_absent{};
+    /** keys passed by filter and found */
+    mutable std::atomic_size_t bloom_present{};
+    /** keys passed by filter but not found */
+    mutable std::atomic_size_t bloom_false_positive{};
+    /** prefetch is disabled if not set */
+    std::shared_ptr<boost::asio::thread_pool> prefetch_pool;
+    /** batches queued on prefetch pool */
+    mutable std::atomic_size_t prefetch_pending{};
   };
 
   struct Ipld2Ipld : public Ipld,
@@ -73,5 +138,6 @@ namespace fc::storage::ipld {
     IpldPtr shared() override {
       return shared_from_this();
     }
+    void prefetch(gsl::span<const CID> keys) const override;
   };
 }  // namespace fc::storage::ipld
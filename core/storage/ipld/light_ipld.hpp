@@ -19,6 +19,8 @@ namespace fc::storage::ipld {
     virtual ~LightIpld() = default;
     virtual bool get(const Hash256 &key, Buffer *value) const = 0;
     virtual void put(const Hash256 &key, BytesIn value) = 0;
+    /// Hint that keys will be read soon
+    virtual void prefetch(gsl::span<const Hash256> keys) const {}
 
     inline bool has(const Hash256 &key) const {
       return get(key, nullptr);
@@ -90,6 +90,14 @@ namespace fc::storage::ipld::traverser {
     return to_visit_.empty();
   }
 
+  const CID &Traverser::next() const {
+    return to_visit_.front();
+  }
+
+  const std::vector<CID> &Traverser::visitOrder() const {
+    return visit_order_;
+  }
+
   outcome::result<void> Traverser::parseCbor(CborDecodeStream &s) {
     if (s.isCid()) {
       CID cid;
@@ -54,6 +54,15 @@ namespace fc::storage::ipld::traverser {
      */
     bool isCompleted() const;
 
+    /**
+     * Cid to be visited by next `advance` call, traversal must not be
+     * completed
+     */
+    const CID &next() const;
+
+    /** Visited cids in visit order, without duplicates */
+    const std::vector<CID> &visitOrder() const;
+
    private:
     outcome::result<void> parseCbor(CborDecodeStream &s);
 
@@ -14,6 +14,7 @@
 #include "common/ptr.hpp"
 #include "const.hpp"
 #include "primitives/tipset/chain.hpp"
+#include "vm/actor/builtin/types/miner/policy.hpp"
 #include "vm/actor/builtin/v0/payment_channel/payment_channel_actor.hpp"
 #include "vm/interpreter/interpreter.hpp"
 #include "vm/runtime/env.hpp"
@@ -24,6 +25,7 @@ namespace fc::storage::mpool {
   using primitives::GasAmount;
   using primitives::block::MsgMeta;
   using primitives::tipset::HeadChangeType;
+  using vm::actor::builtin::types::miner::kChainFinality;
   using vm::message::UnsignedMessage;
 
   constexpr GasAmount kMinGas{1298450};
@@ -450,9 +452,14 @@ namespace fc::storage::mpool {
   std::shared_ptr<MessagePool> MessagePool::create(
       const EnvironmentContext &env_context,
       TsBranchPtr ts_main,
-      std::shared_ptr<ChainStore> chain_store) {
+      std::shared_ptr<ChainStore> chain_store,
+      std::shared_ptr<SignatureVerifier> verifier) {
     auto mpool{std::make_shared<MessagePool>()};
     mpool->env_context = env_context;
+    mpool->verify_signatures = verifier != nullptr;
+    mpool->verifier = verifier ? std::move(verifier)
+                               : std::make_shared<SignatureVerifier>(
+                                   1, kSignatureCacheSize);
     mpool->ts_main = std::move(ts_main);
     mpool->ipld = env_context.ipld;
     mpool->head_sub = chain_store->subscribeHeadChanges([=](auto &change) {
@@ -512,9 +519,8 @@ namespace fc::storage::mpool {
           [&](auto, auto bls, auto &cid, auto *smsg, auto *msg)
               -> outcome::result<void> {
             if (bls) {
-              auto sig{bls_cache.find(cid)};
-              if (sig != bls_cache.end()) {
-                mpool::add(pending, {*msg, sig->second});
+              if (auto sig{blsSignature(ts->epoch(), cid)}) {
+                mpool::add(pending, {*msg, *sig});
               }
             } else {
               mpool::add(pending, *smsg);
@@ -706,8 +712,20 @@ namespace fc::storage::mpool {
   }
 
   outcome::result<void> MessagePool::add(const SignedMessage &message) {
-    if (message.signature.isBls()) {
-      bls_cache.emplace(message.getCid(), message.signature);
+    auto cid{message.message.getCid()};
+    if (verify_signatures) {
+      auto key{message.message.from};
+      if (!key.isKeyType()) {
+        OUTCOME_TRY(cached, env_context.interpreter_cache->get(head->key));
+        vm::state::StateTreeImpl state_tree{ipld, cached.state_root};
+        OUTCOME_TRYA(key,
+                     vm::runtime::resolveKey(state_tree, ipld, key, false));
+      }
+      if (!verifier->verify({cid, message.signature, key})) {
+        return vm::message::MessageError::kVerificationFailure;
+      }
+    } else {
+      verifier->remember(cid, message.signature);
     }
     OUTCOME_TRY(ipld->setCbor(message));
     OUTCOME_TRY(ipld->setCbor(message.message));
@@ -722,22 +740,39 @@ namespace fc::storage::mpool {
     }
   }
 
+  boost::optional<Signature> MessagePool::blsSignature(
+      ChainEpoch epoch, const CID &cid) const {
+    auto epoch_it{applied_bls.find(epoch)};
+    if (epoch_it != applied_bls.end()) {
+      auto it{epoch_it->second.find(cid)};
+      if (it != epoch_it->second.end()) {
+        return it->second;
+      }
+    }
+    return verifier->get(cid);
+  }
+
   outcome::result<void> MessagePool::onHeadChange(const HeadChange &change) {
     if (change.type == HeadChangeType::CURRENT) {
       head = change.value;
     } else {
       auto apply{change.type == HeadChangeType::APPLY};
+      auto epoch{change.value->epoch()};
       OUTCOME_TRY(change.value->visitMessages(
           {ipld, false, true},
           [&](auto, auto bls, auto &cid, auto *smsg, auto *msg)
               -> outcome::result<void> {
             if (apply) {
-              remove(msg->from, msg->nonce);
+              if (auto removed{mpool::remove(by_from, msg->from, msg->nonce)}) {
+                if (bls) {
+                  applied_bls[epoch].emplace(cid, removed->signature);
+                }
+                signal({MpoolUpdate::Type::REMOVE, *removed});
+              }
             } else {
               if (bls) {
-                auto sig{bls_cache.find(cid)};
-                if (sig != bls_cache.end()) {
-                  OUTCOME_TRY(add({*msg, sig->second}));
+                if (auto sig{blsSignature(epoch, cid)}) {
+                  OUTCOME_TRY(add({*msg, *sig}));
                 }
               } else {
                 OUTCOME_TRY(add(*smsg));
@@ -746,8 +781,11 @@ namespace fc::storage::mpool {
             return outcome::success();
           }));
       if (apply) {
+        applied_bls.erase(applied_bls.begin(),
+                          applied_bls.lower_bound(epoch - kChainFinality));
         head = change.value;
       } else {
+        applied_bls.erase(epoch);
         OUTCOME_TRYA(head,
                      env_context.ts_load->load(change.value->getParents()));
       }
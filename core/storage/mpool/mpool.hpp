@@ -11,10 +11,12 @@
 #include "primitives/tipset/chain.hpp"
 #include "storage/chain/chain_store.hpp"
 #include "vm/message/message.hpp"
+#include "vm/message/signature_verifier.hpp"
 #include "vm/runtime/env_context.hpp"
 
 namespace fc::storage::mpool {
   using crypto::signature::Signature;
+  using primitives::ChainEpoch;
   using primitives::Nonce;
   using primitives::TokenAmount;
   using primitives::address::Address;
@@ -22,6 +24,7 @@ namespace fc::storage::mpool {
   using primitives::tipset::Tipset;
   using primitives::tipset::chain::Path;
   using storage::blockchain::ChainStore;
+  using vm::message::SignatureVerifier;
   using vm::message::SignedMessage;
   using vm::message::UnsignedMessage;
   using connection_t = boost::signals2::connection;
@@ -38,10 +41,14 @@ namespace fc::storage::mpool {
   struct MessagePool : public std::enable_shared_from_this<MessagePool> {
     using Subscriber = void(const MpoolUpdate &);
 
+    /**
+     * @param verifier - verifies signatures of added messages if set
+     */
     static std::shared_ptr<MessagePool> create(
         const EnvironmentContext &env_context,
         TsBranchPtr ts_main,
-        std::shared_ptr<ChainStore> chain_store);
+        std::shared_ptr<ChainStore> chain_store,
+        std::shared_ptr<SignatureVerifier> verifier = nullptr);
     std::vector<SignedMessage> pending() const;
     // https://github.com/filecoin-project/lotus/blob/8f78066d4f3c4981da73e3328716631202c6e614/chain/messagepool/selection.go#L41
     outcome::result<std::vector<SignedMessage>> select(
@@ -60,17 +67,30 @@ namespace fc::storage::mpool {
     }
 
    private:
+    /// Signature of BLS message from applied tipset at `epoch`
+    boost::optional<Signature> blsSignature(ChainEpoch epoch,
+                                            const CID &cid) const;
+
     EnvironmentContext env_context;
     TsBranchPtr ts_main;
     IpldPtr ipld;
     ChainStore::connection_t head_sub;
     TipsetCPtr head;
     std::map<Address, std::map<Nonce, SignedMessage>> by_from;
-    std::map<CID, Signature> bls_cache;
+    /**
+     * BLS signatures of pending messages removed by applied tipsets, by
+     * epoch, needed to return them to pool when tipset is reverted
+     */
+    std::map<ChainEpoch, std::map<CID, Signature>> applied_bls;
+    /// Verifies signatures, caches signatures of messages from blocks
+    std::shared_ptr<SignatureVerifier> verifier;
+    bool verify_signatures{};
     boost::signals2::signal<Subscriber> signal;
     mutable std::default_random_engine generator;
     mutable std::normal_distribution<> distribution;
   };
 
   extern TokenAmount kDefaultMaxFee;
+  /// Like lotus `build.BlsSignatureCacheSize`
+  constexpr size_t kSignatureCacheSize{40000};
 }  // namespace fc::storage::mpool
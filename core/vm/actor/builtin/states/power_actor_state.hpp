@@ -110,8 +110,9 @@ namespace fc::vm::actor::builtin::states {
 
     virtual outcome::result<Claim> getClaim(const Address &address) const = 0;
 
-    virtual outcome::result<std::vector<adt::AddressKeyer::Key>> getClaimsKeys()
-        const = 0;
+    /// Claim keys, using cached subtree keys if index is given
+    virtual outcome::result<std::vector<adt::AddressKeyer::Key>> getClaimsKeys(
+        const std::shared_ptr<adt::HamtIndex> &index = nullptr) const = 0;
 
     virtual outcome::result<void> loadClaimsRoot() = 0;
 
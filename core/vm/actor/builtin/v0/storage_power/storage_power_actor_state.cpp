@@ -65,8 +65,9 @@ namespace fc::vm::actor::builtin::v0::storage_power {
   }
 
   outcome::result<std::vector<adt::AddressKeyer::Key>>
-  PowerActorState::getClaimsKeys() const {
-    return claims0.keys();
+  PowerActorState::getClaimsKeys(
+      const std::shared_ptr<adt::HamtIndex> &index) const {
+    return claims0.keys(index);
   }
 
   outcome::result<void> PowerActorState::loadClaimsRoot() {
@@ -35,8 +35,8 @@ namespace fc::vm::actor::builtin::v0::storage_power {
 
     outcome::result<Claim> getClaim(const Address &address) const override;
 
-    outcome::result<std::vector<adt::AddressKeyer::Key>> getClaimsKeys()
-        const override;
+    outcome::result<std::vector<adt::AddressKeyer::Key>> getClaimsKeys(
+        const std::shared_ptr<adt::HamtIndex> &index) const override;
 
     outcome::result<void> loadClaimsRoot() override;
 
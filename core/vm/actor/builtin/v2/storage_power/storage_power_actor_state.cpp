@@ -77,8 +77,9 @@ namespace fc::vm::actor::builtin::v2::storage_power {
   }
 
   outcome::result<std::vector<adt::AddressKeyer::Key>>
-  PowerActorState::getClaimsKeys() const {
-    return claims2.keys();
+  PowerActorState::getClaimsKeys(
+      const std::shared_ptr<adt::HamtIndex> &index) const {
+    return claims2.keys(index);
   }
 
   outcome::result<void> PowerActorState::loadClaimsRoot() {
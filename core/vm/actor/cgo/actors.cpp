@@ -5,6 +5,8 @@
 
 #include "vm/actor/cgo/actors.hpp"
 
+#include <mutex>
+
 #include "proofs/impl/proof_engine_impl.hpp"
 #include "vm/actor/builtin/types/storage_power/policy.hpp"
 #include "vm/actor/cgo/c_actors.h"
@@ -18,7 +20,7 @@
                  CborDecodeStream &,                     \
                  CborEncodeStream &);                    \
   CBOR_METHOD(name) {                                    \
-    rt_##name(runtimes.at(arg.get<size_t>()), arg, ret); \
+    rt_##name(getRuntime(arg.get<size_t>()), arg, ret);  \
   }                                                      \
   void rt_##name(const std::shared_ptr<Runtime> &rt,     \
                  CborDecodeStream &arg,                  \
@@ -47,24 +49,38 @@ namespace fc::vm::actor::cgo {
   constexpr auto kFatal{VMExitCode::kFatal};
   constexpr auto kOk{VMExitCode::kOk};
 
+  // messages may be executed concurrently by speculative `Env`
+  static std::mutex runtimes_mutex;
   static std::map<size_t, std::shared_ptr<Runtime>> runtimes;
   static size_t next_runtime{0};
 
+  std::shared_ptr<Runtime> getRuntime(size_t id) {
+    std::lock_guard lock{runtimes_mutex};
+    return runtimes.at(id);
+  }
+
   static std::shared_ptr<proofs::ProofEngine> proofs =
       std::make_shared<proofs::ProofEngineImpl>();
 
   outcome::result<Buffer> invoke(const CID &code,
                                  const std::shared_ptr<Runtime> &runtime) {
     CborEncodeStream arg;
-    auto id{next_runtime++};  // TODO: mod
+    size_t id{};
+    {
+      std::lock_guard lock{runtimes_mutex};
+      id = next_runtime++;  // TODO: mod
+      runtimes.emplace(id, runtime);
+    }
     auto message{runtime->getMessage().get()};
     auto version{runtime->getNetworkVersion()};
     arg << id << version << message.from << message.to
         << runtime->getCurrentEpoch() << message.value << code << message.method
         << message.params;
-    runtimes.emplace(id, runtime);
     auto ret{cgoCall<cgoActorsInvoke>(arg)};
-    runtimes.erase(id);
+    {
+      std::lock_guard lock{runtimes_mutex};
+      runtimes.erase(id);
+    }
     auto exit{ret.get<VMExitCode>()};
     if (exit != kOk) {
       return exit;
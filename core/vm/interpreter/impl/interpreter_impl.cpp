@@ -45,7 +45,6 @@ namespace fc::vm::interpreter {
   using message::UnsignedMessage;
   using primitives::TokenAmount;
   using primitives::block::MsgMeta;
-  using primitives::tipset::MessageVisitor;
   using runtime::Env;
   using runtime::MessageReceipt;
 
@@ -98,7 +97,7 @@ namespace fc::vm::interpreter {
   outcome::result<Result> InterpreterImpl::interpret(
       TsBranchPtr ts_branch, const TipsetCPtr &tipset) const {
     if (tipset->height() == 0) {
-      OUTCOME_TRY(weight, getWeight(tipset));
+      OUTCOME_TRY(weight, getWeight(env_context_.ipld, tipset));
       return Result{
           tipset->getParentStateRoot(),
           tipset->getParentMessageReceipts(),
@@ -108,12 +107,68 @@ namespace fc::vm::interpreter {
     return applyBlocks(ts_branch, tipset, {});
   }
 
+  outcome::result<TipsetMessages> loadTipsetMessages(
+      IpldPtr ipld, const TipsetCPtr &tipset) {
+    TipsetMessages messages;
+    std::set<CID> visited;
+    std::map<Address, uint64_t> nonces;
+    for (auto &block : tipset->blks) {
+      auto &block_messages{messages.blocks.emplace_back()};
+      auto on_message{[&](bool bls, const CID &cid) -> outcome::result<void> {
+        if (!visited.insert(cid).second) {
+          return outcome::success();
+        }
+        OUTCOME_TRY(raw, ipld->get(cid));
+        UnsignedMessage msg;
+        if (bls) {
+          OUTCOME_TRYA(msg, codec::cbor::decode<UnsignedMessage>(raw));
+        } else {
+          OUTCOME_TRY(smsg, codec::cbor::decode<SignedMessage>(raw));
+          msg = std::move(smsg.message);
+        }
+        auto it{nonces.find(msg.from)};
+        if (it == nonces.end()) {
+          it = nonces.emplace(msg.from, msg.nonce).first;
+        }
+        if (msg.nonce != it->second) {
+          return outcome::success();
+        }
+        ++it->second;
+        block_messages.push_back({std::move(msg), raw.size()});
+        return outcome::success();
+      }};
+      OUTCOME_TRY(meta, ipld->getCbor<MsgMeta>(block.messages));
+      OUTCOME_TRY(meta.bls_messages.visit(
+          [&](auto, auto &cid) { return on_message(true, cid); }));
+      OUTCOME_TRY(meta.secp_messages.visit(
+          [&](auto, auto &cid) { return on_message(false, cid); }));
+    }
+    return messages;
+  }
+
   outcome::result<Result> InterpreterImpl::applyBlocks(
       TsBranchPtr ts_branch,
       const TipsetCPtr &tipset,
       std::vector<MessageReceipt> *all_receipts) const {
-    auto &ipld{env_context_.ipld};
+    std::shared_ptr<IpldBuffered> buffer;
+    OUTCOME_TRY(result,
+                execute(ts_branch,
+                        tipset,
+                        all_receipts,
+                        nullptr,
+                        env_context_.ipld,
+                        buffer));
+    OUTCOME_TRY(buffer->flush(result.state_root));
+    return result;
+  }
 
+  outcome::result<Result> InterpreterImpl::execute(
+      TsBranchPtr ts_branch,
+      const TipsetCPtr &tipset,
+      std::vector<MessageReceipt> *all_receipts,
+      const TipsetMessages *messages,
+      IpldPtr ipld,
+      std::shared_ptr<IpldBuffered> &buffer) const {
     auto on_receipt{[&](auto &receipt) {
       if (all_receipts) {
         all_receipts->push_back(receipt);
@@ -124,7 +179,18 @@ namespace fc::vm::interpreter {
       return InterpreterError::kDuplicateMiner;
     }
 
-    auto env = std::make_shared<Env>(env_context_, ts_branch, tipset);
+    TipsetMessages loaded;
+    if (!messages) {
+      OUTCOME_TRYA(loaded, loadTipsetMessages(ipld, tipset));
+      messages = &loaded;
+    }
+    if (messages->blocks.size() != tipset->blks.size()) {
+      return InterpreterError::kChainInconsistency;
+    }
+
+    auto env_context{env_context_};
+    env_context.ipld = ipld;
+    auto env = std::make_shared<Env>(env_context, ts_branch, tipset);
 
     auto cron{[&]() -> outcome::result<void> {
       OUTCOME_TRY(receipt,
@@ -155,23 +221,18 @@ namespace fc::vm::interpreter {
       env->epoch = tipset->height();
     }
 
-    adt::Array<MessageReceipt> receipts{ipld};
-    MessageVisitor message_visitor{ipld, true, true};
-    for (auto &block : tipset->blks) {
+    std::vector<MessageReceipt> receipts_values;
+    for (size_t i{}; i < tipset->blks.size(); ++i) {
+      auto &block{tipset->blks[i]};
       AwardBlockReward::Params reward{
           block.miner, 0, 0, block.election_proof.win_count};
-      OUTCOME_TRY(message_visitor.visit(
-          block,
-          [&](auto, auto bls, auto &cid, auto, auto *msg)
-              -> outcome::result<void> {
-            OUTCOME_TRY(raw, ipld->get(cid));
-            OUTCOME_TRY(apply, env->applyMessage(*msg, raw.size()));
-            reward.penalty += apply.penalty;
-            reward.gas_reward += apply.reward;
-            on_receipt(apply.receipt);
-            OUTCOME_TRY(receipts.append(std::move(apply.receipt)));
-            return outcome::success();
-          }));
+      OUTCOME_TRY(applies, env->applyMessages(messages->blocks[i]));
+      for (auto &apply : applies) {
+        reward.penalty += apply.penalty;
+        reward.gas_reward += apply.reward;
+        on_receipt(apply.receipt);
+        receipts_values.push_back(std::move(apply.receipt));
+      }
 
       OUTCOME_TRY(reward_encoded, codec::cbor::encode(reward));
       OUTCOME_TRY(receipt,
@@ -194,11 +255,13 @@ namespace fc::vm::interpreter {
     OUTCOME_TRY(cron());
 
     OUTCOME_TRY(new_state_root, env->state_tree->flush());
-    OUTCOME_TRY(env->ipld->flush(new_state_root));
+    buffer = env->ipld;
 
-    OUTCOME_TRY(Ipld::flush(receipts));
+    adt::Array<MessageReceipt> receipts{ipld};
+    OUTCOME_TRY(receipts.build(receipts_values));
 
-    OUTCOME_TRY(weight, getWeight(tipset));
+    // parent state may be not flushed yet, so it is read from `ipld`
+    OUTCOME_TRY(weight, getWeight(ipld, tipset));
 
     return Result{
         new_state_root,
@@ -219,9 +282,9 @@ namespace fc::vm::interpreter {
   }
 
   outcome::result<BigInt> InterpreterImpl::getWeight(
-      const TipsetCPtr &tipset) const {
+      const IpldPtr &ipld, const TipsetCPtr &tipset) const {
     if (weight_calculator_) {
-      return weight_calculator_->calculateWeight(*tipset);
+      return weight_calculator_->calculateWeight(ipld, *tipset);
     }
     return 0;
   }
@@ -10,19 +10,34 @@
 #include "vm/actor/invoker.hpp"
 #include "vm/interpreter/interpreter.hpp"
 #include "vm/runtime/circulating.hpp"
+#include "vm/runtime/env.hpp"
 #include "vm/runtime/env_context.hpp"
 #include "vm/runtime/runtime_randomness.hpp"
 #include "vm/runtime/runtime_types.hpp"
 
 namespace fc::vm::interpreter {
   using blockchain::weight::WeightCalculator;
+  using message::UnsignedMessage;
+  using primitives::tipset::TipsetCPtr;
   using runtime::EnvironmentContext;
+  using runtime::IpldBuffered;
   using runtime::MessageReceipt;
   using runtime::RuntimeRandomness;
   using storage::PersistentBufferMap;
   using vm::actor::Invoker;
   using vm::runtime::MessageReceipt;
 
+  /// Messages of tipset blocks, loaded and decoded ahead of execution
+  struct TipsetMessages {
+    using Message = runtime::Env::Message;
+    /// Messages to apply per block, deduplicated and filtered by nonce
+    std::vector<std::vector<Message>> blocks;
+  };
+
+  /// Loads messages like `MessageVisitor(ipld, true, true)`
+  outcome::result<TipsetMessages> loadTipsetMessages(IpldPtr ipld,
+                                                     const TipsetCPtr &tipset);
+
   class InterpreterImpl : public Interpreter {
    public:
     InterpreterImpl(const EnvironmentContext &env_context,
@@ -34,13 +49,29 @@ namespace fc::vm::interpreter {
         TsBranchPtr ts_branch,
         const TipsetCPtr &tipset,
         std::vector<MessageReceipt> *all_receipts) const;
+    /**
+     * Executes tipset, but leaves state in `buffer` without flushing it.
+     * @param messages - prefetched messages, loaded from `ipld` if null
+     * @param ipld - store to read state from and write receipts to
+     * @param buffer - state written by execution, reachable from state root
+     */
+    virtual outcome::result<Result> execute(
+        TsBranchPtr ts_branch,
+        const TipsetCPtr &tipset,
+        std::vector<MessageReceipt> *all_receipts,
+        const TipsetMessages *messages,
+        IpldPtr ipld,
+        std::shared_ptr<IpldBuffered> &buffer) const;
 
    protected:
     using BlockHeader = primitives::block::BlockHeader;
 
+    /// Calculates weight reading parent state from `ipld`
+    outcome::result<BigInt> getWeight(const IpldPtr &ipld,
+                                      const TipsetCPtr &tipset) const;
+
    private:
     bool hasDuplicateMiners(const std::vector<BlockHeader> &blocks) const;
-    outcome::result<BigInt> getWeight(const TipsetCPtr &tipset) const;
 
     EnvironmentContext env_context_;
     std::shared_ptr<WeightCalculator> weight_calculator_;
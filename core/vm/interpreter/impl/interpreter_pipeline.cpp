@@ -0,0 +1,290 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "vm/interpreter/impl/interpreter_pipeline.hpp"
+
+#include <boost/asio/post.hpp>
+
+#include "common/error_text.hpp"
+
+namespace fc::vm::interpreter {
+  namespace {
+    /// Reads state of tipsets executed, but not flushed yet
+    struct IpldPending : Ipld, std::enable_shared_from_this<IpldPending> {
+      IpldPending(IpldPtr ipld,
+                  std::vector<std::shared_ptr<IpldBuffered>> buffers)
+          : ipld{std::move(ipld)}, buffers{std::move(buffers)} {}
+
+      const Buffer *find(const CID &cid) const {
+        if (auto key{asBlake(cid)}) {
+          for (auto it{buffers.rbegin()}; it != buffers.rend(); ++it) {
+            auto &write{(*it)->write};
+            if (auto it2{write.find(*key)}; it2 != write.end()) {
+              return &it2->second;
+            }
+          }
+        }
+        return nullptr;
+      }
+
+      outcome::result<bool> contains(const CID &cid) const override {
+        if (find(cid)) {
+          return true;
+        }
+        return ipld->contains(cid);
+      }
+
+      outcome::result<void> set(const CID &cid, Value value) override {
+        return ipld->set(cid, std::move(value));
+      }
+
+      outcome::result<Value> get(const CID &cid) const override {
+        if (auto value{find(cid)}) {
+          return *value;
+        }
+        return ipld->get(cid);
+      }
+
+      outcome::result<void> remove(const CID &cid) override {
+        throw "unused";
+      }
+
+      IpldPtr shared() override {
+        return shared_from_this();
+      }
+
+      void prefetch(gsl::span<const CID> keys) const override {
+        ipld->prefetch(keys);
+      }
+
+      IpldPtr ipld;
+      // buffers are not modified after execution, so they are safe to read
+      std::vector<std::shared_ptr<IpldBuffered>> buffers;
+    };
+
+    inline uint64_t micros(std::chrono::steady_clock::duration duration) {
+      return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+          .count();
+    }
+  }  // namespace
+
+  InterpreterPipeline::InterpreterPipeline(
+      std::shared_ptr<InterpreterImpl> interpreter,
+      std::shared_ptr<InterpreterCache> cache,
+      IpldPtr ipld,
+      size_t threads,
+      size_t max_pending)
+      : interpreter_{std::move(interpreter)},
+        cache_{std::move(cache)},
+        ipld_{std::move(ipld)},
+        pool_{std::max<size_t>(1, threads)},
+        max_pending_{std::max<size_t>(1, max_pending)} {}
+
+  InterpreterPipeline::~InterpreterPipeline() {
+    pool_.stop();
+    pool_.join();
+  }
+
+  void InterpreterPipeline::prefetch(const TipsetCPtr &tipset) {
+    std::unique_lock lock{mutex_};
+    if (prefetched_.count(tipset->key)) {
+      return;
+    }
+    auto task{std::make_shared<
+        std::packaged_task<outcome::result<TipsetMessages>()>>(
+        [this, ipld{ipld_}, tipset] {
+          auto start{Clock::now()};
+          auto messages{loadTipsetMessages(ipld, tipset)};
+          metrics.prefetch_us += micros(Clock::now() - start);
+          return messages;
+        })};
+    prefetched_.emplace(
+        tipset->key, Prefetched{tipset->height(), task->get_future().share()});
+    lock.unlock();
+    boost::asio::post(pool_, [task] { (*task)(); });
+  }
+
+  void InterpreterPipeline::clearPrefetch() {
+    std::lock_guard lock{mutex_};
+    prefetched_.clear();
+  }
+
+  size_t InterpreterPipeline::prefetched() {
+    std::lock_guard lock{mutex_};
+    return prefetched_.size();
+  }
+
+  void InterpreterPipeline::dropPrefetched(uint64_t height) {
+    std::lock_guard lock{mutex_};
+    for (auto it{prefetched_.begin()}; it != prefetched_.end();) {
+      if (it->second.height <= height) {
+        it = prefetched_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  InterpreterPipeline::Messages InterpreterPipeline::takePrefetched(
+      const TipsetCPtr &tipset) {
+    std::unique_lock lock{mutex_};
+    auto it{prefetched_.find(tipset->key)};
+    if (it == prefetched_.end()) {
+      lock.unlock();
+      prefetch(tipset);
+      lock.lock();
+      it = prefetched_.find(tipset->key);
+    }
+    auto messages{std::move(it->second.messages)};
+    prefetched_.erase(it);
+    lock.unlock();
+    dropPrefetched(tipset->height());
+    return messages;
+  }
+
+  boost::optional<Result> InterpreterPipeline::pending(const TipsetKey &tsk) {
+    std::lock_guard lock{mutex_};
+    for (auto &pending : pending_) {
+      if (pending->tsk == tsk) {
+        return pending->result;
+      }
+    }
+    return boost::none;
+  }
+
+  boost::optional<outcome::result<Result>> InterpreterPipeline::tryGet(
+      const TipsetKey &tsk) {
+    if (auto result{pending(tsk)}) {
+      return outcome::result<Result>{std::move(*result)};
+    }
+    return cache_->tryGet(tsk);
+  }
+
+  outcome::result<Result> InterpreterPipeline::interpret(
+      TsBranchPtr ts_branch, const TipsetCPtr &tipset, OnFlush on_flush) {
+    if (auto cached{cache_->tryGet(tipset->key)}) {
+      dropPrefetched(tipset->height());
+      on_flush(*cached);
+      return *cached;
+    }
+    if (auto result{pending(tipset->key)}) {
+      dropPrefetched(tipset->height());
+      // flush thread is sequential, so result is cached when this runs
+      boost::asio::post(
+          *flush_thread_.io,
+          [this, tsk{tipset->key}, on_flush{std::move(on_flush)}] {
+            on_flush(cache_->get(tsk));
+          });
+      return *result;
+    }
+    if (tipset->height() == 0) {
+      dropPrefetched(tipset->height());
+      auto result{interpreter_->interpret(ts_branch, tipset)};
+      if (!result) {
+        cache_->markBad(tipset->key);
+        return result;
+      }
+      cache_->set(tipset->key, result.value());
+      on_flush(result);
+      return result;
+    }
+
+    auto messages{takePrefetched(tipset)};
+    auto start{Clock::now()};
+    messages.wait();
+    auto executing{Clock::now()};
+    metrics.prefetch_wait_us += micros(executing - start);
+
+    std::unique_lock lock{mutex_};
+    // backpressure, execution waits for flush
+    flushed_cv_.wait(lock, [&] { return pending_.size() < max_pending_; });
+    std::vector<std::shared_ptr<IpldBuffered>> buffers;
+    auto parent{false};
+    for (auto &pending : pending_) {
+      buffers.push_back(pending->buffer);
+      parent = parent || pending->tsk == tipset->getParents();
+    }
+    // parent state is lost if its flush failed, tipset is not bad
+    if (!parent) {
+      auto cached{cache_->tryGet(tipset->getParents())};
+      if (!cached || !*cached) {
+        return ERROR_TEXT("InterpreterPipeline.interpret: parent not flushed");
+      }
+    }
+    if (!wall_) {
+      wall_ = start;
+    }
+    auto failures{failures_};
+    lock.unlock();
+
+    std::shared_ptr<IpldBuffered> buffer;
+    auto result{[&]() -> outcome::result<Result> {
+      OUTCOME_TRY(loaded, messages.get());
+      for (auto &block : loaded.blocks) {
+        metrics.messages += block.size();
+      }
+      return interpreter_->execute(
+          ts_branch,
+          tipset,
+          nullptr,
+          &loaded,
+          std::make_shared<IpldPending>(ipld_, std::move(buffers)),
+          buffer);
+    }()};
+    metrics.execute_us += micros(Clock::now() - executing);
+    if (!result) {
+      cache_->markBad(tipset->key);
+      return result;
+    }
+
+    auto pending{std::make_shared<const Pending>(
+        Pending{tipset->key, result.value(), std::move(buffer), failures})};
+    lock.lock();
+    pending_.push_back(pending);
+    lock.unlock();
+    boost::asio::post(*flush_thread_.io,
+                      [this, pending, on_flush{std::move(on_flush)}] {
+                        flush(pending, on_flush);
+                      });
+    return result;
+  }
+
+  void InterpreterPipeline::flush(std::shared_ptr<const Pending> pending,
+                                  OnFlush on_flush) {
+    auto start{Clock::now()};
+    outcome::result<Result> result{pending->result};
+    // only flush thread changes `failures_`
+    if (pending->failures != failures_) {
+      result = ERROR_TEXT("InterpreterPipeline.flush: previous flush failed");
+    } else if (auto flushed{
+                   pending->buffer->flush(pending->result.state_root)};
+               !flushed) {
+      result = flushed.error();
+    } else {
+      cache_->set(pending->tsk, pending->result);
+    }
+    auto now{Clock::now()};
+    metrics.flush_us += micros(now - start);
+
+    std::unique_lock lock{mutex_};
+    assert(pending_.front() == pending);
+    pending_.pop_front();
+    if (result) {
+      ++metrics.tipsets;
+    } else {
+      // tipsets executed on top of this one fail too
+      ++failures_;
+    }
+    if (pending_.empty()) {
+      if (wall_) {
+        metrics.wall_us += micros(now - *wall_);
+        wall_.reset();
+      }
+    }
+    lock.unlock();
+    flushed_cv_.notify_all();
+    on_flush(result);
+  }
+}  // namespace fc::vm::interpreter
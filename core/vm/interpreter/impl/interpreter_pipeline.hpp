@@ -0,0 +1,125 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <boost/asio/thread_pool.hpp>
+#include <condition_variable>
+#include <deque>
+#include <future>
+
+#include "common/io_thread.hpp"
+#include "vm/interpreter/impl/interpreter_impl.hpp"
+
+namespace fc::vm::interpreter {
+  /**
+   * Interprets consecutive tipsets during catch-up sync in three stages:
+   * - messages of next tipsets are loaded and decoded on worker threads,
+   * - tipset is executed on caller thread,
+   * - state of executed tipset is flushed to store on flush thread,
+   *   while next tipset executes on top of unflushed state.
+   * Result is cached only after state was flushed.
+   * Number of executed tipsets waiting for flush is limited, so their buffers
+   * don't grow without bound when execution is faster than flush.
+   */
+  class InterpreterPipeline {
+   public:
+    using OnFlush = std::function<void(outcome::result<Result>)>;
+
+    /// Counters for metrics, durations are in microseconds
+    struct Metrics {
+      std::atomic_uint64_t tipsets{};
+      std::atomic_uint64_t messages{};
+      std::atomic_uint64_t prefetch_us{};
+      std::atomic_uint64_t prefetch_wait_us{};
+      std::atomic_uint64_t execute_us{};
+      std::atomic_uint64_t flush_us{};
+      std::atomic_uint64_t wall_us{};
+    };
+
+    /// Default limit of executed tipsets waiting for flush, estimated
+    static constexpr size_t kMaxPending{8};
+
+    InterpreterPipeline(std::shared_ptr<InterpreterImpl> interpreter,
+                        std::shared_ptr<InterpreterCache> cache,
+                        IpldPtr ipld,
+                        size_t threads,
+                        size_t max_pending = kMaxPending);
+    ~InterpreterPipeline();
+
+    /// Starts loading messages of tipset expected to be interpreted soon
+    void prefetch(const TipsetCPtr &tipset);
+
+    /// Drops prefetched messages not used by interpreted chain
+    void clearPrefetch();
+
+    /// Number of tipsets with prefetched messages not taken yet
+    size_t prefetched();
+
+    /// Returns result of tipset executed, but not flushed yet
+    boost::optional<Result> pending(const TipsetKey &tsk);
+
+    /// Returns result of pending or cached tipset
+    boost::optional<outcome::result<Result>> tryGet(const TipsetKey &tsk);
+
+    /**
+     * Executes tipset on caller thread.
+     * Blocks while `max_pending` executed tipsets wait for flush.
+     * @param on_flush - called on flush thread after state is flushed and
+     * result is cached, or immediately if result was cached before,
+     * not called on execution error
+     * @return execution result, state may be not flushed yet
+     */
+    outcome::result<Result> interpret(TsBranchPtr ts_branch,
+                                      const TipsetCPtr &tipset,
+                                      OnFlush on_flush);
+
+    Metrics metrics;
+
+   private:
+    using Clock = std::chrono::steady_clock;
+    using Messages = std::shared_future<outcome::result<TipsetMessages>>;
+
+    struct Prefetched {
+      uint64_t height{};
+      Messages messages;
+    };
+
+    struct Pending {
+      TipsetKey tsk;
+      Result result;
+      std::shared_ptr<IpldBuffered> buffer;
+      /// `failures_` when execution started
+      uint64_t failures{};
+    };
+
+    Messages takePrefetched(const TipsetCPtr &tipset);
+    /// Drops prefetched tipsets not above interpreted height, they are used
+    /// or belong to abandoned branches
+    void dropPrefetched(uint64_t height);
+    void flush(std::shared_ptr<const Pending> pending, OnFlush on_flush);
+
+    std::shared_ptr<InterpreterImpl> interpreter_;
+    std::shared_ptr<InterpreterCache> cache_;
+    IpldPtr ipld_;
+    boost::asio::thread_pool pool_;
+    std::mutex mutex_;
+    std::map<TipsetKey, Prefetched> prefetched_;
+    /// executed tipsets, oldest first
+    std::deque<std::shared_ptr<const Pending>> pending_;
+    size_t max_pending_;
+    /// notified when pending tipset is flushed
+    std::condition_variable flushed_cv_;
+    /**
+     * Number of failed flushes.
+     * Tipset executed on top of pending state is discarded when any flush
+     * fails after its execution started, later tipsets are executed again
+     * once their parent is cached.
+     */
+    uint64_t failures_{};
+    boost::optional<Clock::time_point> wall_;
+    IoThread flush_thread_;
+  };
+}  // namespace fc::vm::interpreter
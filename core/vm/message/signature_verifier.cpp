@@ -0,0 +1,127 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "vm/message/signature_verifier.hpp"
+
+#include <boost/asio/post.hpp>
+#include <future>
+
+#include "common/visitor.hpp"
+#include "crypto/blake2/blake2b160.hpp"
+
+namespace fc::vm::message {
+  using crypto::signature::BlsSignature;
+  using crypto::signature::Secp256k1Signature;
+  using primitives::address::BLSPublicKeyHash;
+
+  SignatureVerifier::SignatureVerifier(size_t threads, size_t cache_size)
+      : pool_{std::max<size_t>(1, threads)}, cache_{cache_size} {
+    assert(cache_size != 0);
+  }
+
+  SignatureVerifier::~SignatureVerifier() {
+    pool_.stop();
+    pool_.join();
+  }
+
+  std::vector<bool> SignatureVerifier::verify(gsl::span<const Item> items) {
+    std::vector<uint8_t> valid(items.size());
+    std::vector<size_t> unknown;
+    for (size_t i{}; i < items.size(); ++i) {
+      if (cached(items[i])) {
+        valid[i] = true;
+      } else {
+        unknown.push_back(i);
+      }
+    }
+    if (!unknown.empty()) {
+      constexpr size_t kChunk{64};
+      std::vector<std::future<void>> done;
+      for (size_t begin{}; begin < unknown.size(); begin += kChunk) {
+        auto end{std::min(begin + kChunk, unknown.size())};
+        auto task{std::make_shared<std::packaged_task<void()>>([&, begin, end] {
+          for (auto j{begin}; j < end; ++j) {
+            auto i{unknown[j]};
+            valid[i] = check(items[i]);
+          }
+        })};
+        done.push_back(task->get_future());
+        boost::asio::post(pool_, [task] { (*task)(); });
+      }
+      for (auto &future : done) {
+        future.wait();
+      }
+      for (auto i : unknown) {
+        if (valid[i]) {
+          remember(items[i].cid, items[i].signature);
+        } else {
+          ++invalid;
+        }
+      }
+    }
+    return {valid.begin(), valid.end()};
+  }
+
+  bool SignatureVerifier::verify(const Item &item) {
+    if (cached(item)) {
+      return true;
+    }
+    if (!check(item)) {
+      ++invalid;
+      return false;
+    }
+    remember(item.cid, item.signature);
+    return true;
+  }
+
+  boost::optional<Signature> SignatureVerifier::get(const CID &cid) {
+    std::lock_guard lock{cache_mutex_};
+    return cache_.get(cid);
+  }
+
+  void SignatureVerifier::remember(const CID &cid, const Signature &signature) {
+    std::lock_guard lock{cache_mutex_};
+    cache_.insert(cid, signature);
+  }
+
+  bool SignatureVerifier::cached(const Item &item) {
+    if (auto signature{get(item.cid)}) {
+      if (*signature == item.signature) {
+        ++hits;
+        return true;
+      }
+    }
+    ++misses;
+    return false;
+  }
+
+  bool SignatureVerifier::check(const Item &item) const {
+    auto _data{item.cid.toBytes()};
+    if (!_data) {
+      return false;
+    }
+    auto &data{_data.value()};
+    return visit_in_place(
+        item.signature,
+        [&](const BlsSignature &signature) {
+          if (!item.key.isBls()) {
+            return false;
+          }
+          crypto::bls::PublicKey key;
+          const auto &hash{boost::get<BLSPublicKeyHash>(item.key.data)};
+          std::copy_n(hash.begin(), key.size(), key.begin());
+          auto valid{bls_provider_.verifySignature(data, signature, key)};
+          return valid && valid.value();
+        },
+        [&](const Secp256k1Signature &signature) {
+          if (!item.key.isSecp256k1()) {
+            return false;
+          }
+          auto key{secp_provider_.recoverPublicKey(
+              crypto::blake2b::blake2b_256(data), signature)};
+          return key && item.key.verifySyntax(key.value());
+        });
+  }
+}  // namespace fc::vm::message
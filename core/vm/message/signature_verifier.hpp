@@ -0,0 +1,64 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/compute/detail/lru_cache.hpp>
+#include <mutex>
+
+#include "crypto/bls/impl/bls_provider_impl.hpp"
+#include "crypto/secp256k1/impl/secp256k1_provider_impl.hpp"
+#include "vm/message/message.hpp"
+
+namespace fc::vm::message {
+  /**
+   * Verifies message signatures on thread pool.
+   * Remembers signatures of recently verified messages by cid of unsigned
+   * message, so message received from gossip and then in block is verified
+   * once. Also keeps BLS signatures, which are not stored in blocks.
+   */
+  class SignatureVerifier {
+   public:
+    struct Item {
+      /// cid of unsigned message, which bytes are signed
+      CID cid;
+      Signature signature;
+      /// key address of sender
+      Address key;
+    };
+
+    SignatureVerifier(size_t threads, size_t cache_size);
+    ~SignatureVerifier();
+
+    /**
+     * Verifies signatures, splitting batch between pool threads.
+     * @return validity of corresponding items
+     */
+    std::vector<bool> verify(gsl::span<const Item> items);
+
+    /// Verifies one signature on calling thread
+    bool verify(const Item &item);
+
+    /// Signature of recently verified or remembered message
+    boost::optional<Signature> get(const CID &cid);
+
+    /// Remembers signature known to be valid
+    void remember(const CID &cid, const Signature &signature);
+
+    std::atomic_uint64_t hits{}, misses{}, invalid{};
+
+   private:
+    bool cached(const Item &item);
+    bool check(const Item &item) const;
+
+    boost::asio::thread_pool pool_;
+    std::mutex cache_mutex_;
+    boost::compute::detail::lru_cache<CID, Signature> cache_;
+    crypto::bls::BlsProviderImpl bls_provider_;
+    crypto::secp256k1::Secp256k1ProviderImpl secp_provider_;
+  };
+}  // namespace fc::vm::message
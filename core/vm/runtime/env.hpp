@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <gsl/span>
+
 #include "primitives/tipset/tipset.hpp"
 #include "primitives/types.hpp"
 #include "vm/actor/invoker.hpp"
@@ -44,9 +47,12 @@ namespace fc::vm::runtime {
     outcome::result<Value> get(const CID &key) const override;
     outcome::result<void> remove(const CID &key) override;
     IpldPtr shared() override;
+    /** forwards hint to backing store */
+    void prefetch(gsl::span<const CID> keys) const override;
 
     IpldPtr ipld;
-    bool flushing{false};
+    // set by flush thread, other threads read state of pending tipsets
+    std::atomic_bool flushing{false};
     // vm only stores "DAG_CBOR blake2b_256" cids
     std::unordered_map<Hash256, Buffer> write;
   };
@@ -62,9 +68,27 @@ namespace fc::vm::runtime {
       TokenAmount penalty, reward;
     };
 
+    struct Message {
+      UnsignedMessage msg;
+      /// encoded size, charged by `applyMessage`
+      size_t size{};
+    };
+
     outcome::result<Apply> applyMessage(const UnsignedMessage &message,
                                         size_t size);
 
+    /**
+     * Applies messages in order like `applyMessage`.
+     * If `EnvironmentContext::speculative_pool` is set, messages of different
+     * senders are executed concurrently on forks of state tree, and messages
+     * which accessed actors changed by preceding messages are applied again.
+     */
+    outcome::result<std::vector<Apply>> applyMessages(
+        gsl::span<const Message> messages);
+
+    /// Copy of env with buffered ipld and state tree on top of `state_root`
+    std::shared_ptr<Env> fork(const CID &state_root) const;
+
     outcome::result<MessageReceipt> applyImplicitMessage(
         UnsignedMessage message);
 
@@ -75,6 +99,11 @@ namespace fc::vm::runtime {
     TsBranchPtr ts_branch;
     TipsetCPtr tipset;
     Pricelist pricelist;
+    /**
+     * Gas fee and reward transfers to burnt funds and reward actors, which are
+     * done by every message, are collected here instead of state tree if set
+     */
+    boost::optional<std::map<Address, TokenAmount>> deferred_credits;
   };
 
   struct Execution : std::enable_shared_from_this<Execution> {
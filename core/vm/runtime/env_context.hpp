@@ -19,5 +19,7 @@ namespace fc::vm::runtime {
     std::shared_ptr<InterpreterCache> interpreter_cache{};
     std::shared_ptr<Circulating> circulating{};
     SharedMutexPtr ts_branches_mutex{};
+    /// Enables speculative execution of messages by `Env::applyMessages`
+    std::shared_ptr<boost::asio::thread_pool> speculative_pool{};
   };
 }  // namespace fc::vm::runtime
@@ -5,6 +5,10 @@
 
 #include "vm/runtime/env.hpp"
 
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <future>
+
 #include "storage/ipld/traverser.hpp"
 #include "vm/actor/builtin/states/state_provider.hpp"
 #include "vm/actor/builtin/v0/miner/miner_actor.hpp"
@@ -18,6 +22,7 @@
 
 namespace fc::vm::runtime {
   using actor::ActorVersion;
+  using actor::kBurntFundsActorAddress;
   using actor::kConstructorMethodNumber;
   using actor::kEmptyObjectCid;
   using actor::kRewardAddress;
@@ -94,6 +99,10 @@ namespace fc::vm::runtime {
     return shared_from_this();
   }
 
+  void IpldBuffered::prefetch(gsl::span<const CID> keys) const {
+    ipld->prefetch(keys);
+  }
+
   Env::Env(const EnvironmentContext &env_context,
            TsBranchPtr ts_branch,
            TipsetCPtr tipset)
@@ -112,6 +121,13 @@ namespace fc::vm::runtime {
     auto add_locked{
         [&](auto &address, const TokenAmount &add) -> outcome::result<void> {
           if (add != 0) {
+            if (deferred_credits
+                && (address == kBurntFundsActorAddress
+                    || address == kRewardAddress)) {
+              (*deferred_credits)[address] += add;
+              locked -= add;
+              return outcome::success();
+            }
             OUTCOME_TRY(actor, state_tree->get(address));
             actor.balance += add;
             locked -= add;
@@ -200,8 +216,7 @@ namespace fc::vm::runtime {
     apply.penalty = base_fee > fee_cap ? TokenAmount{base_fee - fee_cap} * used
                                        : TokenAmount{0};
     if (!no_fee) {
-      OUTCOME_TRY(
-          add_locked(actor::kBurntFundsActorAddress, base_fee_pay * used));
+      OUTCOME_TRY(add_locked(kBurntFundsActorAddress, base_fee_pay * used));
     }
     apply.reward =
         std::min(message.gas_premium, TokenAmount{fee_cap - base_fee_pay})
@@ -214,8 +229,8 @@ namespace fc::vm::runtime {
                    : static_cast<GasAmount>(bigdiv(
                        BigInt{limit - used} * std::min(used, over), used))};
     if (gas_burned != 0) {
-      OUTCOME_TRY(add_locked(actor::kBurntFundsActorAddress,
-                             base_fee_pay * gas_burned));
+      OUTCOME_TRY(
+          add_locked(kBurntFundsActorAddress, base_fee_pay * gas_burned));
       apply.penalty += (base_fee - base_fee_pay) * gas_burned;
     }
     BOOST_ASSERT_MSG(locked >= 0, "gas math wrong");
@@ -228,6 +243,132 @@ namespace fc::vm::runtime {
     return apply;
   }
 
+  outcome::result<std::vector<Env::Apply>> Env::applyMessages(
+      gsl::span<const Message> messages) {
+    std::vector<Apply> applies;
+    applies.reserve(messages.size());
+    if (!env_context.speculative_pool || messages.size() < 2) {
+      for (auto &message : messages) {
+        OUTCOME_TRY(apply, applyMessage(message.msg, message.size));
+        applies.push_back(std::move(apply));
+      }
+      return applies;
+    }
+
+    // messages of same sender depend on each other by nonce
+    std::vector<std::vector<size_t>> chains;
+    std::vector<size_t> chain_of(messages.size());
+    std::map<Address, size_t> chain_by_sender;
+    for (size_t i{}; i < messages.size(); ++i) {
+      auto it{chain_by_sender.emplace(messages[i].msg.from, chains.size())};
+      if (it.second) {
+        chains.emplace_back();
+      }
+      chain_of[i] = it.first->second;
+      chains[chain_of[i]].push_back(i);
+    }
+
+    struct Speculation {
+      boost::optional<outcome::result<Apply>> apply;
+      StateTreeImpl::Tx changes;
+      std::map<Address, TokenAmount> credits;
+    };
+    std::vector<Speculation> speculations(messages.size());
+    OUTCOME_TRY(snapshot, state_tree->flush());
+    std::vector<std::shared_ptr<Env>> forks;
+    std::vector<std::future<void>> done;
+    for (auto &chain : chains) {
+      auto &env{forks.emplace_back(fork(snapshot))};
+      env->state_tree->trackAccess(true);
+      env->deferred_credits.emplace();
+      auto task{std::make_shared<std::packaged_task<void()>>([&, env] {
+        for (auto i : chain) {
+          auto &speculation{speculations[i]};
+          env->state_tree->txBegin();
+          speculation.apply.emplace(
+              env->applyMessage(messages[i].msg, messages[i].size));
+          speculation.changes = env->state_tree->txCurrent();
+          speculation.credits = std::move(*env->deferred_credits);
+          env->deferred_credits->clear();
+          env->state_tree->txEnd();
+          if (!speculation.apply->has_value()) {
+            break;
+          }
+        }
+      })};
+      done.push_back(task->get_future());
+      boost::asio::post(*env_context.speculative_pool, [task] { (*task)(); });
+    }
+    // messages not executed due to exception are applied again
+    for (auto &future : done) {
+      future.wait();
+    }
+    for (auto &env : forks) {
+      ipld->write.merge(env->ipld->write);
+    }
+
+    // actors written since snapshot, by chain or by several chains if none
+    std::map<ActorId, boost::optional<size_t>> written;
+    auto on_write{[&](ActorId id, boost::optional<size_t> chain) {
+      auto it{written.emplace(id, chain).first};
+      if (it->second != chain) {
+        it->second = boost::none;
+      }
+    }};
+    std::vector<bool> broken(chains.size());
+    for (size_t i{}; i < messages.size(); ++i) {
+      auto chain{chain_of[i]};
+      auto &speculation{speculations[i]};
+      auto valid{!broken[chain] && speculation.apply
+                 && speculation.apply->has_value()};
+      if (valid) {
+        auto &changes{speculation.changes};
+        for (auto ids : {&changes.reads, &changes.writes}) {
+          for (auto id : *ids) {
+            auto it{written.find(id)};
+            if (it != written.end() && it->second != chain) {
+              valid = false;
+            }
+          }
+        }
+      }
+      if (valid) {
+        for (auto id : speculation.changes.writes) {
+          on_write(id, chain);
+        }
+        state_tree->txMerge(std::move(speculation.changes));
+        for (auto &[address, credit] : speculation.credits) {
+          OUTCOME_TRY(actor, state_tree->get(address));
+          actor.balance += credit;
+          OUTCOME_TRY(state_tree->set(address, actor));
+          on_write(address.getId(), boost::none);
+        }
+        applies.push_back(std::move(speculation.apply->value()));
+      } else {
+        // following messages of sender saw state of this one
+        broken[chain] = true;
+        state_tree->trackAccess(true);
+        state_tree->txBegin();
+        auto apply{applyMessage(messages[i].msg, messages[i].size)};
+        for (auto id : state_tree->txCurrent().writes) {
+          on_write(id, boost::none);
+        }
+        state_tree->trackAccess(false);
+        state_tree->txEnd();
+        OUTCOME_TRY(apply);
+        applies.push_back(std::move(apply.value()));
+      }
+    }
+    return applies;
+  }
+
+  std::shared_ptr<Env> Env::fork(const CID &state_root) const {
+    auto env{std::make_shared<Env>(*this)};
+    env->ipld = std::make_shared<IpldBuffered>(ipld);
+    env->state_tree = std::make_shared<StateTreeImpl>(env->ipld, state_root);
+    return env;
+  }
+
   outcome::result<MessageReceipt> Env::applyImplicitMessage(
       UnsignedMessage message) {
     auto execution = Execution::make(shared_from_this(), message);
@@ -28,6 +28,9 @@ namespace fc::vm::state {
                                            const Actor &actor) {
     OUTCOME_TRY(address_id, lookupId(address));
     dvm::onActor(*this, address, actor);
+    if (track_) {
+      tx().writes.insert(address_id.getId());
+    }
     _set(address_id.getId(), actor);
     return outcome::success();
   }
@@ -38,6 +41,9 @@ namespace fc::vm::state {
     if (!id) {
       return boost::none;
     }
+    if (track_) {
+      tx().reads.insert(id->getId());
+    }
     for (auto it{tx_.rbegin()}; it != tx_.rend(); ++it) {
       if (it->removed.count(id->getId())) {
         return boost::none;
@@ -110,6 +116,9 @@ namespace fc::vm::state {
 
   outcome::result<void> StateTreeImpl::remove(const Address &address) {
     OUTCOME_TRY(address_id, lookupId(address));
+    if (track_) {
+      tx().writes.insert(address_id.getId());
+    }
     tx().removed.insert(address_id.getId());
     return outcome::success();
   }
@@ -119,23 +128,48 @@ namespace fc::vm::state {
   }
 
   void StateTreeImpl::txRevert() {
+    // reverted accesses still affected execution
+    auto reads{std::move(tx().reads)}, writes{std::move(tx().writes)};
     tx_.back() = {};
+    tx().reads = std::move(reads);
+    tx().writes = std::move(writes);
   }
 
   void StateTreeImpl::txEnd() {
     assert(tx_.size() > 1);
     auto top{std::move(tx())};
     tx_.pop_back();
-    for (auto &[id, actor] : top.actors) {
+    txMerge(std::move(top));
+  }
+
+  void StateTreeImpl::trackAccess(bool track) {
+    track_ = track;
+  }
+
+  const StateTreeImpl::Tx &StateTreeImpl::txCurrent() const {
+    return tx();
+  }
+
+  void StateTreeImpl::txMerge(Tx changes) {
+    for (auto &[id, actor] : changes.actors) {
       tx().actors[id] = std::move(actor);
       tx().removed.erase(id);
     }
-    for (auto &[address, id] : top.lookup) {
+    for (auto &[address, id] : changes.lookup) {
       tx().lookup[address] = id;
     }
-    for (auto id : top.removed) {
+    for (auto id : changes.removed) {
       tx().removed.insert(id);
     }
+    if (track_) {
+      tx().reads.insert(changes.reads.begin(), changes.reads.end());
+      tx().writes.insert(changes.writes.begin(), changes.writes.end());
+    }
+  }
+
+  const adt::Map<actor::Actor, adt::AddressKeyer> &StateTreeImpl::actors()
+      const {
+    return by_id;
   }
 
   StateTreeImpl::Tx &StateTreeImpl::tx() const {
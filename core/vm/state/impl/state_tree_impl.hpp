@@ -18,6 +18,8 @@ namespace fc::vm::state {
       std::map<ActorId, Actor> actors;
       std::map<Address, ActorId> lookup;
       std::set<ActorId> removed;
+      /// Actors read and written, recorded only if `trackAccess` is enabled
+      std::set<ActorId> reads, writes;
     };
 
     explicit StateTreeImpl(const std::shared_ptr<IpfsDatastore> &store);
@@ -43,6 +45,15 @@ namespace fc::vm::state {
     void txRevert() override;
     void txEnd() override;
 
+    /// Record actors accessed by transactions in `Tx::reads`, `Tx::writes`
+    void trackAccess(bool track);
+    /// Current transaction
+    const Tx &txCurrent() const;
+    /// Apply changes of transaction from fork of this tree to current one
+    void txMerge(Tx changes);
+    /// Actors by id as of last flush, without pending changes
+    const adt::Map<actor::Actor, adt::AddressKeyer> &actors() const;
+
    private:
     Tx &tx() const;
     void _set(ActorId id, const Actor &actor) const;
@@ -57,5 +68,6 @@ namespace fc::vm::state {
     std::shared_ptr<IpfsDatastore> store_;
     adt::Map<actor::Actor, adt::AddressKeyer> by_id;
     mutable std::vector<Tx> tx_;
+    bool track_{false};
   };
 }  // namespace fc::vm::state
@@ -0,0 +1,71 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/rpc/dispatcher.hpp"
+
+#include <gtest/gtest.h>
+#include <condition_variable>
+#include <future>
+
+namespace fc::api::rpc {
+  /**
+   * @given dispatcher limiting heavy method to one concurrent call
+   * @when heavy method is called twice and cheap method once
+   * @then second heavy call waits in queue, cheap call runs inline
+   */
+  TEST(Dispatcher, Limit) {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool release{false};
+    Rpc rpc;
+    rpc.setup("Heavy", [&](auto &, auto respond, auto, auto) {
+      std::unique_lock lock{mutex};
+      cv.wait(lock, [&] { return release; });
+      lock.unlock();
+      respond(Document{});
+    });
+    rpc.setup("Cheap",
+              [&](auto &, auto respond, auto, auto) { respond(Document{}); });
+
+    Dispatcher dispatcher{2};
+    dispatcher.limit("Heavy", 1);
+    dispatcher.wrap(rpc);
+    const Dispatcher::Stats *stats{};
+    dispatcher.stats([&](auto &name, auto &_stats) {
+      EXPECT_EQ(name, "Heavy");
+      stats = &_stats;
+    });
+    ASSERT_TRUE(stats);
+
+    std::atomic_size_t responses{};
+    std::promise<void> all_responded;
+    auto all_responded_future{all_responded.get_future()};
+    Respond respond{[&](auto) {
+      if (++responses == 3) {
+        all_responded.set_value();
+      }
+    }};
+    Document params;
+    params.SetArray();
+    rpc.ms["Heavy"](params, respond, {}, {});
+    rpc.ms["Heavy"](params, respond, {}, {});
+    EXPECT_EQ(stats->calls, 2);
+    EXPECT_EQ(stats->running, 1);
+    EXPECT_EQ(stats->queued, 1);
+
+    rpc.ms["Cheap"](params, respond, {}, {});
+    EXPECT_EQ(responses, 1);
+
+    {
+      std::lock_guard lock{mutex};
+      release = true;
+    }
+    cv.notify_all();
+    EXPECT_EQ(all_responded_future.wait_for(std::chrono::seconds(10)),
+              std::future_status::ready);
+    EXPECT_EQ(responses, 3);
+    EXPECT_EQ(stats->queued, 0);
+  }
+}  // namespace fc::api::rpc
@@ -144,3 +144,28 @@ TEST(ApiJsonTest, MinerInfoPendingWorkerKeyPresent) {
              "\"Multiaddrs\":[],\"WindowPoStProofType\":0,\"SectorSize\":1,"
              "\"WindowPoStPartitionSectors\":1,\"ConsensusFaultElapsed\":0}");
 }
+
+/**
+ * @given JSON document with nested containers
+ * @when formatted chunk by chunk with different limits
+ * @then chunks are bounded and joined equal to formatted at once
+ */
+TEST(ApiJsonTest, ChunkFormatter) {
+  std::string input{
+      "{\"a\":[1,\"x\\\"y\",{},[],null,true],\"bc\":{\"d\":[[2],{\"e\":3}]},"
+      "\"f\":" J96 "}"};
+  auto doc{jsonDecode(fc::common::span::cbytes(input))};
+  auto expected{jsonEncode(doc)};
+  for (size_t limit : {1, 2, 7, 1000}) {
+    fc::codec::json::ChunkFormatter formatter{&doc};
+    Buffer chunk, joined;
+    bool done{false};
+    while (!done) {
+      EXPECT_OUTCOME_TRUE(_done, formatter.next(chunk, limit));
+      done = _done;
+      EXPECT_TRUE(done || chunk.size() >= limit);
+      joined.put(chunk);
+    }
+    EXPECT_EQ(joined, expected);
+  }
+}
@@ -0,0 +1,75 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/full_node/state_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include "storage/ipfs/impl/in_memory_datastore.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+namespace fc::api {
+  using primitives::BigInt;
+  using vm::actor::CodeId;
+
+  struct StateCacheTest : testing::Test {
+    void SetUp() override {
+      StateTreeImpl tree{ipld};
+      EXPECT_OUTCOME_TRUE_1(tree.set(address, actor));
+      EXPECT_OUTCOME_TRUE(cid, tree.flush());
+      root = cid;
+    }
+
+    std::shared_ptr<storage::ipfs::IpfsDatastore> ipld{
+        std::make_shared<storage::ipfs::InMemoryDatastore>()};
+    Address address{Address::makeFromId(13)};
+    Actor actor{CodeId{"010001020001"_cid}, "010001020002"_cid, 3, BigInt(5)};
+    CID root;
+    StateCache cache{kStateCacheBytes, 4};
+  };
+
+  /**
+   * @given state root with actor
+   * @when get actor twice
+   * @then second call is served from cache
+   */
+  TEST_F(StateCacheTest, Actor) {
+    StateTreeImpl tree{ipld, root};
+    EXPECT_OUTCOME_EQ(cache.actor(root, tree, address), actor);
+    EXPECT_EQ(cache.actor_misses, 1);
+    EXPECT_OUTCOME_EQ(cache.actor(root, tree, address), actor);
+    EXPECT_EQ(cache.actor_hits, 1);
+  }
+
+  /**
+   * @given cache limited to few actors
+   * @when get actors of many state roots
+   * @then bytes stay within limit, least recently used actor is evicted
+   */
+  TEST_F(StateCacheTest, Evict) {
+    StateCache small{4096, 1};
+    std::vector<CID> roots;
+    for (auto nonce{0}; nonce < 32; ++nonce) {
+      StateTreeImpl tree{ipld};
+      auto changed{actor};
+      changed.nonce = nonce;
+      EXPECT_OUTCOME_TRUE_1(tree.set(address, changed));
+      EXPECT_OUTCOME_TRUE(cid, tree.flush());
+      roots.push_back(cid);
+      EXPECT_OUTCOME_EQ(small.actor(cid, tree, address), changed);
+      EXPECT_LE(small.bytes(), 4096);
+    }
+    EXPECT_GT(small.bytes(), 0);
+    EXPECT_EQ(small.actor_misses, roots.size());
+
+    StateTreeImpl last{ipld, roots.back()};
+    EXPECT_OUTCOME_TRUE_1(small.actor(roots.back(), last, address));
+    EXPECT_EQ(small.actor_hits, 1);
+    StateTreeImpl first{ipld, roots.front()};
+    EXPECT_OUTCOME_TRUE_1(small.actor(roots.front(), first, address));
+    EXPECT_EQ(small.actor_misses, roots.size() + 1);
+  }
+}  // namespace fc::api
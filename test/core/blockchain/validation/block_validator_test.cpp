@@ -105,3 +105,19 @@ TEST_F(BlockValidatorTest, ValidateCorrectBlock) {
       getCorrectBlockHeader(),
       {fc::blockchain::block_validator::scenarios::Stage::SYNTAX_BV0}));
 }
+
+/**
+ * @given Block with BLS messages, but without aggregated signature
+ * @when Validating BLS aggregates
+ * @then Validation fails without loading messages
+ */
+TEST_F(BlockValidatorTest, MissingBlsAggregate) {
+  fc::primitives::block::BlockWithCids block{getCorrectBlockHeader(), {}, {}};
+  EXPECT_OUTCOME_TRUE_1(
+      validator_->validateBlsAggregates(gsl::make_span(&block, 1)));
+  block.header.bls_aggregate = boost::none;
+  block.bls_messages.push_back("010001020001"_cid);
+  EXPECT_OUTCOME_ERROR(
+      fc::blockchain::block_validator::ValidatorError::kInvalidBlsAggregate,
+      validator_->validateBlsAggregates(gsl::make_span(&block, 1)));
+}
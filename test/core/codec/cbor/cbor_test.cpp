@@ -11,7 +11,9 @@
 #include "testutil/literals.hpp"
 #include "testutil/outcome.hpp"
 
+using fc::Buffer;
 using fc::CID;
+using fc::codec::cbor::BytesView;
 using fc::codec::cbor::CborDecodeError;
 using fc::codec::cbor::CborDecodeStream;
 using fc::codec::cbor::CborEncodeError;
@@ -25,6 +27,27 @@ auto kCidRaw =
 auto kCidCbor =
     "D82A582300122031C3D57080D8463A3C63B2923DF5A1D40AD7A73EAE5A14AF584213E5F504AC33"_unhex;
 
+struct Pair {
+  int64_t a{};
+  std::string b;
+
+  bool operator==(const Pair &other) const {
+    return a == other.a && b == other.b;
+  }
+};
+CBOR_TUPLE(Pair, a, b)
+
+struct Outer {
+  Pair pair;
+  std::vector<Pair> pairs;
+  uint64_t c{};
+
+  bool operator==(const Outer &other) const {
+    return pair == other.pair && pairs == other.pairs && c == other.c;
+  }
+};
+CBOR_TUPLE(Outer, pair, pairs, c)
+
 template <typename T>
 void expectDecodeOne(const std::vector<uint8_t> &encoded, const T &expected) {
   EXPECT_OUTCOME_EQ(decode<T>(encoded), expected);
@@ -52,6 +75,22 @@ TEST(Cbor, DecodeBlob) {
                     Blob3::fromHex("CAFEDE").value());
 }
 
+/** Bytes decoded from shared input point into it, otherwise are copied */
+TEST(Cbor, BytesView) {
+  auto input{std::make_shared<const Buffer>("8242CAFE4101"_unhex)};
+  EXPECT_OUTCOME_TRUE(shared, decode<std::vector<BytesView>>(input));
+  ASSERT_EQ(shared.size(), 2);
+  EXPECT_EQ(shared[0].copy(), "CAFE"_unhex);
+  EXPECT_EQ(shared[0].data(), input->data() + 2);
+  EXPECT_EQ(shared[1].copy(), "01"_unhex);
+  EXPECT_EQ(shared[1].source, input);
+
+  EXPECT_OUTCOME_TRUE(borrowed, decode<std::vector<BytesView>>(*input));
+  EXPECT_EQ(borrowed, shared);
+  EXPECT_NE(borrowed[0].source, input);
+  EXPECT_OUTCOME_EQ(encode(borrowed), *input);
+}
+
 /** BigInt CBOR encoding and decoding */
 TEST(Cbor, BigInt) {
   using fc::primitives::BigInt;
@@ -98,6 +137,20 @@ TEST(Cbor, Map) {
                     m);
 }
 
+/// Tuple CBOR encoding and decoding, extra list elements are ignored
+TEST(Cbor, Tuple) {
+  Pair pair{1, "x"};
+  Outer outer{pair, {pair}, 2};
+  auto outer_cbor{"8382016178818201617802"_unhex};
+  EXPECT_OUTCOME_EQ(encode(pair), "82016178"_unhex);
+  EXPECT_OUTCOME_EQ(encode(outer), outer_cbor);
+  EXPECT_OUTCOME_EQ(decode<Outer>(outer_cbor), outer);
+  // indefinite length
+  EXPECT_OUTCOME_EQ(decode<Pair>("9F016178FF"_unhex), pair);
+  EXPECT_OUTCOME_EQ(decode<Pair>("8301617802"_unhex), pair);
+  EXPECT_OUTCOME_ERROR(CborDecodeError::kWrongType, decode<Pair>("01"_unhex));
+}
+
 /**
  * @given Integers and bool
  * @when Encode
@@ -114,6 +167,26 @@ TEST(CborEncoder, Integral) {
   EXPECT_OUTCOME_EQ(encode(true), "F5"_unhex);
 }
 
+/** Shortest head is used for each argument size */
+TEST(CborEncoder, IntegralHeadSize) {
+  EXPECT_OUTCOME_EQ(encode(255), "18FF"_unhex);
+  EXPECT_OUTCOME_EQ(encode(256), "190100"_unhex);
+  EXPECT_OUTCOME_EQ(encode(65535), "19FFFF"_unhex);
+  EXPECT_OUTCOME_EQ(encode(65536), "1A00010000"_unhex);
+  EXPECT_OUTCOME_EQ(encode(UINT32_MAX), "1AFFFFFFFF"_unhex);
+  EXPECT_OUTCOME_EQ(encode(uint64_t{UINT32_MAX} + 1),
+                    "1B0000000100000000"_unhex);
+  EXPECT_OUTCOME_EQ(encode(UINT64_MAX), "1BFFFFFFFFFFFFFFFF"_unhex);
+  EXPECT_OUTCOME_EQ(encode(-24), "37"_unhex);
+  EXPECT_OUTCOME_EQ(encode(-25), "3818"_unhex);
+  EXPECT_OUTCOME_EQ(encode(-257), "390100"_unhex);
+  EXPECT_OUTCOME_EQ(encode(INT64_MIN), "3B7FFFFFFFFFFFFFFF"_unhex);
+  std::vector<uint8_t> bytes(24, 0);
+  auto expected{"5818"_unhex};
+  expected.insert(expected.end(), bytes.begin(), bytes.end());
+  EXPECT_OUTCOME_EQ(encode(bytes), expected);
+}
+
 /**
  * @given Sequence
  * @when Encode
@@ -154,6 +227,31 @@ TEST(CborEncoder, ListNest) {
   EXPECT_EQ(s.data(), "84820102030405"_unhex);
 }
 
+/**
+ * @given List encoded in place
+ * @when Elements count differs from expected
+ * @then List head is rewritten
+ */
+TEST(CborEncoder, Tuple) {
+  CborEncodeStream s;
+  s << 1;
+  auto tuple{s.beginTuple(2)};
+  s << 2;
+  s.endTuple(tuple);
+  EXPECT_EQ(s.data(), "018102"_unhex);
+  tuple = s.beginTuple(0);
+  for (auto i{0}; i < 24; ++i) {
+    s << 0;
+  }
+  s.endTuple(tuple);
+  auto data{s.data()};
+  EXPECT_EQ(data.size(), 3 + 2 + 24);
+  EXPECT_EQ(data[3], 0x98);
+  EXPECT_OUTCOME_EQ(
+      decode<std::vector<int>>(gsl::make_span(data).subspan(3)),
+      std::vector<int>(24, 0));
+}
+
 /**
  * @given Nested sequence containers
  * @when Encode
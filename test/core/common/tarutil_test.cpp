@@ -5,7 +5,9 @@
 
 #include "common/tarutil.hpp"
 
+#include <fcntl.h>
 #include <gtest/gtest.h>
+#include <unistd.h>
 #include <boost/filesystem.hpp>
 #include "common/file.hpp"
 #include "common/span.hpp"
@@ -94,3 +96,18 @@ TEST_F(TarUtilTest, zipTar) {
   EXPECT_OUTCOME_EQ(fc::common::readFile(file_path),
                     fc::common::span::cbytes(result_string));
 }
+
+/**
+ * @given tar file opened as descriptor
+ * @when try to extract it from descriptor
+ * @then all files are extracted
+ */
+TEST_F(TarUtilTest, extractTarFd) {
+  auto fd{open(resourcePath("sector.tar").c_str(), O_RDONLY)};
+  ASSERT_NE(fd, -1);
+  EXPECT_OUTCOME_TRUE_1(fc::common::extractTar(fd, base_path));
+  close(fd);
+  ASSERT_TRUE(fs::exists((base_path / "Cache").string()));
+  ASSERT_TRUE(fs::exists((base_path / "Seal").string()));
+  ASSERT_TRUE(fs::exists((base_path / "Unseal" / "test.txt").string()));
+}
@@ -82,3 +82,39 @@ TEST_F(BlsProviderTest, DifferentMessageVerificationFailure) {
                           different_message, signature, key_pair.public_key));
   ASSERT_FALSE(signature_status);
 }
+
+/**
+ * @given Messages signed with different keys
+ * @when Verifying aggregated signature of messages
+ * @then Aggregate is valid only for original messages and keys
+ */
+TEST_F(BlsProviderTest, VerifyAggregateSignature) {
+  BlsProviderImpl provider{4};
+  std::vector<std::vector<uint8_t>> messages{{1}, {2, 2}, {3, 3, 3}};
+  fc::crypto::bls::Aggregate aggregate;
+  std::vector<Signature> signatures;
+  for (auto &message : messages) {
+    EXPECT_OUTCOME_TRUE(key_pair, provider.generateKeyPair());
+    EXPECT_OUTCOME_TRUE(signature,
+                        provider.sign(message, key_pair.private_key));
+    aggregate.messages.emplace_back(message);
+    aggregate.keys.push_back(key_pair.public_key);
+    signatures.push_back(signature);
+  }
+  EXPECT_OUTCOME_TRUE(signature, provider.aggregateSignatures(signatures));
+  aggregate.signature = signature;
+  EXPECT_OUTCOME_EQ(provider.verifyAggregateSignature(aggregate), true);
+
+  auto other{aggregate};
+  std::swap(other.keys[0], other.keys[1]);
+  EXPECT_OUTCOME_EQ(provider.verifyAggregateSignature(other), false);
+  std::vector<fc::crypto::bls::Aggregate> batch{aggregate, other};
+  EXPECT_OUTCOME_EQ(provider.verifyAggregateSignatures(batch), false);
+
+  auto single{aggregate};
+  single.messages.resize(1);
+  single.keys.resize(1);
+  single.signature = signatures[0];
+  batch = {aggregate, single};
+  EXPECT_OUTCOME_EQ(provider.verifyAggregateSignatures(batch), true);
+}
@@ -147,7 +147,6 @@ namespace fc::markets::retrieval::test {
                                                             datatransfer,
                                                             api,
                                                             piece_storage,
-                                                            provider_ipfs,
                                                             config_key,
                                                             sealer,
                                                             miner);
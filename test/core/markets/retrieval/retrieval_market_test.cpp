@@ -4,11 +4,15 @@
  */
 
 #include "core/markets/retrieval/fixture.hpp"
+#include "markets/storage/types.hpp"
 #include "proofs/proofs_error.hpp"
 #include "testutil/outcome.hpp"
 
 namespace fc::markets::retrieval::test {
   using fc::storage::ipld::kAllSelector;
+  using fc::storage::piece::PieceInfo;
+  using markets::storage::kStorageMarketImportDir;
+  using primitives::SectorNumber;
   using primitives::piece::UnpaddedByteIndex;
   using proofs::ProofsError;
   using testing::_;
@@ -105,4 +109,66 @@ namespace fc::markets::retrieval::test {
 
     EXPECT_OUTCOME_EQ(client_ipfs->contains(payload_cid), true);
   }
+
+  /**
+   * @given more pieces than unsealed cache keeps
+   * @when get unsealed pieces repeatedly
+   * @then cached piece is not unsealed again, least recently used piece car is
+   * evicted and unsealed again on next request
+   */
+  TEST_F(RetrievalMarketFixture, UnsealedPieceCache) {
+    EXPECT_OUTCOME_TRUE(
+        car, fc::storage::car::makeCar(*provider_ipfs, {payload_cid}));
+    std::vector<PieceInfo> pieces;
+    for (uint8_t i{0}; i <= provider::kUnsealedCacheSize; ++i) {
+      EXPECT_OUTCOME_TRUE(piece_cid, common::getCidOf(Buffer(1, i)));
+      pieces.push_back(
+          {piece_cid,
+           {DealInfo{.deal_id = i,
+                     .sector_id = i,
+                     .offset = PaddedPieceSize(0),
+                     .length = UnpaddedPieceSize(car.size()).padded()}}});
+    }
+    auto car_path{[&](const PieceInfo &piece) {
+      return kStorageMarketImportDir / "unsealed"
+             / (piece.piece_cid.toString().value() + ".car");
+    }};
+
+    auto sector_info = std::make_shared<mining::types::SectorInfo>();
+    EXPECT_CALL(*miner, getSectorInfo(_))
+        .WillRepeatedly(testing::Return(outcome::success(sector_info)));
+    EXPECT_CALL(*miner, getAddress())
+        .WillRepeatedly(testing::Return(Address::makeFromId(1000)));
+    std::map<SectorNumber, size_t> unsealed;
+    EXPECT_CALL(*sealer, doReadPiece(_, _, _, _, _, _))
+        .WillRepeatedly(testing::Invoke(
+            [&](auto output_fd, auto &sector, auto, auto, auto, auto)
+                -> outcome::result<void> {
+              ++unsealed[sector.sector];
+              auto bytes = write(output_fd, car.data(), car.size());
+              if ((bytes < 0) || (static_cast<size_t>(bytes) != car.size())) {
+                return ProofsError::kNotWriteEnough;
+              }
+              return outcome::success();
+            }));
+
+    EXPECT_OUTCOME_TRUE(ipld0, provider->unsealedPiece(pieces[0]));
+    EXPECT_OUTCOME_EQ(ipld0->contains(payload_cid), true);
+    EXPECT_OUTCOME_EQ(provider->unsealedPiece(pieces[0]), ipld0);
+    EXPECT_EQ(unsealed[0], 1);
+
+    for (size_t i{1}; i < pieces.size(); ++i) {
+      EXPECT_OUTCOME_TRUE_1(provider->unsealedPiece(pieces[i]));
+      EXPECT_EQ(unsealed[i], 1);
+    }
+    EXPECT_FALSE(boost::filesystem::exists(car_path(pieces[0])));
+    EXPECT_TRUE(boost::filesystem::exists(car_path(pieces[1])));
+    // evicted piece stays readable by deals still holding it
+    EXPECT_OUTCOME_EQ(ipld0->contains(payload_cid), true);
+
+    EXPECT_OUTCOME_TRUE(reopened, provider->unsealedPiece(pieces[0]));
+    EXPECT_NE(reopened, ipld0);
+    EXPECT_EQ(unsealed[0], 2);
+    EXPECT_FALSE(boost::filesystem::exists(car_path(pieces[1])));
+  }
 }  // namespace fc::markets::retrieval::test
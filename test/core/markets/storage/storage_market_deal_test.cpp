@@ -4,6 +4,7 @@
  */
 
 #include "storage_market_fixture.hpp"
+#include "storage/car/car.hpp"
 #include "testutil/outcome.hpp"
 #include "testutil/read_file.hpp"
 #include "testutil/resources/resources.hpp"
@@ -213,4 +214,64 @@ namespace fc::markets::storage::test {
         proposal_cid, StorageDealStatus::STORAGE_DEAL_ACTIVE));
   }
 
+  /**
+   * @given provider has some later blocks of deal data before transfer, so
+   * blocks arrive out of traversal order
+   * @when client sends data in graphsync mode
+   * @then piece commitment hashed while receiving matches one of car file,
+   * file is not hashed again, deal activated
+   */
+  TEST_F(StorageMarketTest, GraphsyncDatatransferStreamingCommP) {
+    EXPECT_CALL(*chain_events_, onDealSectorCommitted(_, _, _))
+        // one for client and one for provider
+        .Times(2)
+        .WillRepeatedly(
+            testing::Invoke([](auto arg1, auto arg2, auto cb) { cb(); }));
+
+    auto car{readFile(CAR_FROM_PAYLOAD_FILE)};
+    EXPECT_OUTCOME_TRUE(reader, fc::storage::car::CarReader::make(car));
+    std::vector<fc::storage::car::CarReader::Item> items;
+    while (!reader.end()) {
+      EXPECT_OUTCOME_TRUE(item, reader.next());
+      items.push_back(item);
+    }
+    ASSERT_GT(items.size(), 2);
+    for (auto i{items.size() - 1}; i != 0; --i) {
+      if (i % 2 == 0) {
+        EXPECT_OUTCOME_TRUE_1(
+            ipld_provider->set(items[i].first, Buffer{items[i].second}));
+      }
+    }
+
+    // file is hashed only when piece commitment was not computed on receive
+    size_t file_hashed{0};
+    node_api->GetProofType = {
+        [&](auto &, auto &) -> outcome::result<RegisteredSealProof> {
+          ++file_hashed;
+          return registered_proof;
+        }};
+
+    EXPECT_OUTCOME_TRUE(data_ref, makeDataRef(CAR_FROM_PAYLOAD_FILE));
+    data_ref.transfer_type = kTransferTypeGraphsync;
+    ChainEpoch start_epoch{210};
+    ChainEpoch end_epoch{300};
+    TokenAmount client_price{20000};
+    TokenAmount collateral{10};
+    EXPECT_OUTCOME_TRUE(proposal_cid,
+                        client->proposeStorageDeal(client_id_address,
+                                                   *storage_provider_info,
+                                                   data_ref,
+                                                   start_epoch,
+                                                   end_epoch,
+                                                   client_price,
+                                                   collateral,
+                                                   registered_proof,
+                                                   false));
+    EXPECT_TRUE(waitForProviderDealStatus(
+        proposal_cid, StorageDealStatus::STORAGE_DEAL_ACTIVE));
+    EXPECT_TRUE(waitForClientDealStatus(
+        proposal_cid, StorageDealStatus::STORAGE_DEAL_ACTIVE));
+    EXPECT_EQ(file_hashed, 0);
+  }
+
 }  // namespace fc::markets::storage::test
@@ -0,0 +1,100 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "proofs/commp.hpp"
+
+#include <gtest/gtest.h>
+
+#include "primitives/cid/comm_cid.hpp"
+#include "proofs/proofs_error.hpp"
+#include "sector_storage/zerocomm/zerocomm.hpp"
+#include "testutil/outcome.hpp"
+
+namespace fc::proofs {
+  using common::Blob;
+  using primitives::cid::dataCommitmentV1ToCID;
+  using sector_storage::zerocomm::getZeroPieceCommitment;
+
+  CID commCid(std::string_view hex) {
+    return dataCommitmentV1ToCID(Blob<32>::fromHex(hex).value()).value();
+  }
+
+  std::vector<uint8_t> bytes(size_t size) {
+    std::vector<uint8_t> bytes(size);
+    for (size_t i{0}; i < size; ++i) {
+      bytes[i] = (i * 31 + 7) % 256;
+    }
+    return bytes;
+  }
+
+  /**
+   * @given zero bytes and empty input
+   * @when compute commitment of pieces up to several batches
+   * @then commitment equals zero piece commitment
+   */
+  TEST(CommP, Zero) {
+    CommP commp{4};
+    for (auto size : {127, 254, 1016, 127 << 13, 127 << 16}) {
+      UnpaddedPieceSize unpadded(size);
+      EXPECT_OUTCOME_TRUE(expected, getZeroPieceCommitment(unpadded));
+      EXPECT_OUTCOME_EQ(commp.finish(unpadded), expected);
+      commp.update(std::vector<uint8_t>(size));
+      EXPECT_OUTCOME_EQ(commp.finish(unpadded), expected);
+    }
+  }
+
+  /**
+   * @given data shorter or equal to piece size
+   * @when compute commitment
+   * @then commitment equals one of fr32 padded sha256-trunc254 tree computed
+   * independently bit by bit
+   */
+  TEST(CommP, Data) {
+    CommP commp;
+    commp.update(bytes(1000));
+    EXPECT_OUTCOME_EQ(commp.finish(UnpaddedPieceSize{1016}),
+                      commCid("18ecdbcfba4113d256f3d0c569457203"
+                              "deeed3aac882587191b560fb4338012c"));
+    commp.update(bytes(1016));
+    EXPECT_OUTCOME_EQ(commp.finish(UnpaddedPieceSize{1016}),
+                      commCid("87e9804640472bbfd15771ebea3a5a85"
+                              "e81f4a8910ee38a0a4a99602b051c209"));
+  }
+
+  /**
+   * @given data of several batches
+   * @when appended in uneven parts, with and without thread pool
+   * @then commitments are equal
+   */
+  TEST(CommP, Stream) {
+    auto data{bytes(CommP::kBatchUnpadded * 5 + 1234)};
+    UnpaddedPieceSize size{127 << 16};
+    auto expected{commCid(
+        "d13fee791f3c95d923bece1244086c68859972b2a65e1a69e24b5c950585a235")};
+    for (size_t parallel : {1, 4}) {
+      CommP commp{parallel};
+      commp.update(data);
+      EXPECT_OUTCOME_EQ(commp.finish(size), expected);
+      for (size_t i{0}; i < data.size(); i += 333333) {
+        commp.update(gsl::make_span(data).subspan(
+            i, std::min<size_t>(333333, data.size() - i)));
+      }
+      EXPECT_EQ(commp.count(), data.size());
+      EXPECT_OUTCOME_EQ(commp.finish(size), expected);
+    }
+  }
+
+  /**
+   * @given data longer than piece size
+   * @when compute commitment
+   * @then error
+   */
+  TEST(CommP, TooLong) {
+    CommP commp;
+    commp.update(bytes(1017));
+    EXPECT_OUTCOME_ERROR(ProofsError::kOutOfBound,
+                         commp.finish(UnpaddedPieceSize{1016}));
+  }
+}  // namespace fc::proofs
@@ -0,0 +1,107 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sector_storage/fetch_handler.hpp"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+#include "testutil/mocks/sector_storage/stores/local_store_mock.hpp"
+#include "testutil/outcome.hpp"
+#include "testutil/storage/base_fs_test.hpp"
+
+namespace fc::sector_storage {
+  namespace fs = boost::filesystem;
+  namespace http = api::http;
+
+  using api::FileRangeBody;
+  using primitives::sector_file::sectorName;
+  using stores::AcquireSectorResponse;
+  using stores::LocalStoreMock;
+  using ::testing::_;
+  using Range = boost::optional<std::pair<uint64_t, uint64_t>>;
+
+  Range range(uint64_t begin, uint64_t end) {
+    return std::make_pair(begin, end);
+  }
+
+  /**
+   * @given range header values
+   * @when parse them for file of 10 bytes
+   * @then bounded, open-ended and suffix ranges are clamped to file,
+   * ranges past end of file and malformed values are rejected
+   */
+  TEST(ParseRange, Ranges) {
+    EXPECT_EQ(parseRange("bytes=2-5", 10), range(2, 6));
+    EXPECT_EQ(parseRange("bytes=2-100", 10), range(2, 10));
+    EXPECT_EQ(parseRange("bytes=4-", 10), range(4, 10));
+    EXPECT_EQ(parseRange("bytes=-3", 10), range(7, 10));
+    EXPECT_EQ(parseRange("bytes=-30", 10), range(0, 10));
+
+    EXPECT_EQ(parseRange("bytes=10-", 10), boost::none);
+    EXPECT_EQ(parseRange("bytes=12-15", 10), boost::none);
+    EXPECT_EQ(parseRange("bytes=5-2", 10), boost::none);
+    EXPECT_EQ(parseRange("bytes=-0", 10), boost::none);
+
+    EXPECT_EQ(parseRange("bytes=-", 10), boost::none);
+    EXPECT_EQ(parseRange("bytes=a-3", 10), boost::none);
+    EXPECT_EQ(parseRange("items=2-5", 10), boost::none);
+    EXPECT_EQ(parseRange("bytes=1-2,4-5", 10), boost::none);
+    EXPECT_EQ(parseRange("", 10), boost::none);
+  }
+
+  class FetchHandlerTest : public test::BaseFS_Test {
+   public:
+    FetchHandlerTest() : test::BaseFS_Test("fc_fetch_handler_test") {
+      sealed_ = (base_path / sectorName(sector_)).string();
+      std::ofstream{sealed_} << "0123456789";
+      AcquireSectorResponse response;
+      response.paths.id = sector_;
+      response.paths.sealed = sealed_;
+      EXPECT_CALL(*local_store_, acquireSector(_, _, _, _, _, _))
+          .WillRepeatedly(testing::Return(response));
+    }
+
+    /** Requests sealed file with range header */
+    api::WrapperResponse get(const std::string &range) {
+      http::request<http::dynamic_body> request{
+          http::verb::get, "/remote/sealed/" + sectorName(sector_), 11};
+      request.set(http::field::range, range);
+      return serveHttp(local_store_)(request);
+    }
+
+   protected:
+    SectorId sector_{.miner = 42, .sector = 1};
+    std::string sealed_;
+    std::shared_ptr<LocalStoreMock> local_store_{
+        std::make_shared<LocalStoreMock>()};
+  };
+
+  /**
+   * @given sealed file of 10 bytes
+   * @when request range of it
+   * @then partial content of range is served
+   */
+  TEST_F(FetchHandlerTest, PartialContent) {
+    auto wrapper{get("bytes=2-5")};
+    auto &response{std::get<http::response<FileRangeBody>>(wrapper.response)};
+    EXPECT_EQ(response.result(), http::status::partial_content);
+    EXPECT_EQ(response[http::field::content_range], "bytes 2-5/10");
+    EXPECT_EQ(response.body().offset, 2);
+    EXPECT_EQ(response.body().length, 4);
+  }
+
+  /**
+   * @given sealed file of 10 bytes
+   * @when request range past its end
+   * @then range is not satisfiable
+   */
+  TEST_F(FetchHandlerTest, RangeNotSatisfiable) {
+    auto wrapper{get("bytes=10-")};
+    auto &response{
+        std::get<http::response<http::empty_body>>(wrapper.response)};
+    EXPECT_EQ(response.result(), http::status::range_not_satisfiable);
+  }
+}  // namespace fc::sector_storage
@@ -9,6 +9,7 @@
 #include <gsl/span>
 #include <sector_storage/stores/store_error.hpp>
 
+#include "sector_storage/impl/provable_checker.hpp"
 #include "testutil/literals.hpp"
 #include "testutil/mocks/proofs/proof_engine_mock.hpp"
 #include "testutil/mocks/sector_storage/scheduler_mock.hpp"
@@ -83,6 +84,8 @@ namespace fc::sector_storage {
                                       .allow_commit = true,
                                       .allow_unseal = true,
                                   },
+                                  std::make_shared<ProvableChecker>(
+                                      sector_index_, local_store_),
                                   proof_engine_);
       if (maybe_manager.has_value()) {
         manager_ = std::move(maybe_manager.value());
@@ -879,6 +882,8 @@ namespace fc::sector_storage {
     EXPECT_CALL(*scheduler_, getSealProofType())
         .WillOnce(testing::Return(proof));
 
+    auto checker{
+        std::make_shared<ProvableChecker>(sector_index_, local_store_)};
     EXPECT_OUTCOME_TRUE(manager,
                         ManagerImpl::newManager(remote_store_,
                                                 scheduler_,
@@ -887,7 +892,8 @@ namespace fc::sector_storage {
                                                     .allow_precommit_2 = true,
                                                     .allow_commit = true,
                                                     .allow_unseal = true,
-                                                }));
+                                                },
+                                                checker));
 
     ASSERT_EQ(manager->getSectorSize(), 0);
   }
@@ -0,0 +1,156 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sector_storage/impl/provable_checker.hpp"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <future>
+
+#include "testutil/mocks/sector_storage/stores/local_store_mock.hpp"
+#include "testutil/mocks/sector_storage/stores/sector_index_mock.hpp"
+#include "testutil/outcome.hpp"
+#include "testutil/storage/base_fs_test.hpp"
+
+namespace fc::sector_storage {
+  namespace fs = boost::filesystem;
+
+  using primitives::SectorNumber;
+  using primitives::sector_file::sectorName;
+  using stores::AcquireSectorResponse;
+  using stores::LocalStoreMock;
+  using stores::SectorIndexMock;
+  using ::testing::_;
+
+  class ProvableCheckerTest : public test::BaseFS_Test {
+   public:
+    ProvableCheckerTest() : test::BaseFS_Test("fc_provable_checker_test") {
+      EXPECT_CALL(*sector_index_, storageTryLock(_, _, _))
+          .WillRepeatedly(testing::Invoke([](auto &&...) {
+            return std::make_unique<stores::WLock>();
+          }));
+      EXPECT_CALL(*local_store_, acquireSector(_, _, _, _, _, _))
+          .WillRepeatedly(testing::Invoke(
+              [this](auto sector, auto &&...)
+                  -> outcome::result<AcquireSectorResponse> {
+                return responses_.at(sector.sector);
+              }));
+    }
+
+    /** Creates files of 2KiB sector on storage */
+    SectorId addSector(SectorNumber number, const StorageID &storage) {
+      SectorId sector{.miner = 42, .sector = number};
+      auto dir{base_path / storage};
+      AcquireSectorResponse response;
+      response.paths.id = sector;
+      response.paths.sealed =
+          (dir / "sealed" / sectorName(sector)).string();
+      response.paths.cache = (dir / "cache" / sectorName(sector)).string();
+      response.storages.sealed = storage;
+      response.storages.cache = storage;
+      fs::create_directories(dir / "sealed");
+      fs::create_directories(response.paths.cache);
+      std::ofstream{response.paths.sealed};
+      fs::resize_file(response.paths.sealed, 2 << 10);
+      for (auto name : {"t_aux", "p_aux", "sc-02-data-tree-r-last.dat"}) {
+        std::ofstream{(fs::path{response.paths.cache} / name).string()};
+      }
+      responses_.emplace(number, response);
+      return sector;
+    }
+
+   protected:
+    std::shared_ptr<SectorIndexMock> sector_index_{
+        std::make_shared<SectorIndexMock>()};
+    std::shared_ptr<LocalStoreMock> local_store_{
+        std::make_shared<LocalStoreMock>()};
+    std::map<SectorNumber, AcquireSectorResponse> responses_;
+  };
+
+  /**
+   * @given sectors on two storage paths, one sector misses cache file
+   * @when check them with challenge reads
+   * @then only broken sector is bad, latency is accounted per storage path
+   */
+  TEST_F(ProvableCheckerTest, PerPath) {
+    std::vector<SectorId> sectors{
+        addSector(1, "a"), addSector(2, "a"), addSector(3, "b")};
+    fs::remove(fs::path{responses_.at(2).paths.cache} / "p_aux");
+
+    ProvableChecker checker{sector_index_,
+                            local_store_,
+                            {.per_path = 2, .read_challenge = true}};
+    EXPECT_OUTCOME_EQ(
+        checker.checkProvable(RegisteredSealProof::kStackedDrg2KiBV1, sectors),
+        std::vector<SectorId>{sectors[1]});
+
+    std::map<StorageID, std::pair<uint64_t, uint64_t>> stats;
+    checker.stats([&](auto &storage, auto &path) {
+      EXPECT_EQ(path.timeouts.load(), 0);
+      uint64_t buckets{0};
+      for (auto &bucket : path.buckets) {
+        buckets += bucket.load();
+      }
+      EXPECT_EQ(buckets, path.count.load());
+      stats[storage] = {path.count.load(), path.faulty.load()};
+    });
+    EXPECT_EQ(stats,
+              (std::map<StorageID, std::pair<uint64_t, uint64_t>>{
+                  {"a", {2, 1}}, {"b", {1, 0}}}));
+  }
+
+  /**
+   * @given two threads per path, checks of two sectors on path "a" hang
+   * @when check sectors of "a" and "b", then check another sector of "a"
+   * @then hung checks fail by timeout, remaining sectors of "a" fail when all
+   * its threads hang, "b" is checked, next check of "a" fails without checking
+   */
+  TEST_F(ProvableCheckerTest, Timeout) {
+    std::vector<SectorId> sectors{addSector(1, "a"),
+                                  addSector(2, "a"),
+                                  addSector(3, "a"),
+                                  addSector(4, "a"),
+                                  addSector(5, "b")};
+    auto next{addSector(6, "a")};
+    std::promise<void> release;
+    auto released{release.get_future().share()};
+    auto checked{std::make_shared<std::atomic_size_t>()};
+    ProvableChecker checker{
+        sector_index_,
+        local_store_,
+        {.per_path = 2, .timeout = std::chrono::milliseconds{50}},
+        [released, checked](auto &paths, auto) {
+          ++*checked;
+          if (paths.id.sector <= 2) {
+            released.wait();
+          }
+          return true;
+        }};
+
+    EXPECT_OUTCOME_TRUE(
+        bad,
+        checker.checkProvable(RegisteredSealProof::kStackedDrg2KiBV1, sectors));
+    EXPECT_THAT(bad,
+                testing::UnorderedElementsAre(
+                    sectors[0], sectors[1], sectors[2], sectors[3]));
+    EXPECT_EQ(checked->load(), 3);
+
+    std::vector<SectorId> next_sectors{next};
+    EXPECT_OUTCOME_EQ(checker.checkProvable(
+                          RegisteredSealProof::kStackedDrg2KiBV1, next_sectors),
+                      next_sectors);
+    EXPECT_EQ(checked->load(), 3);
+
+    std::map<StorageID, std::tuple<uint64_t, uint64_t, uint64_t>> stats;
+    checker.stats([&](auto &storage, auto &path) {
+      stats[storage] = {
+          path.count.load(), path.faulty.load(), path.timeouts.load()};
+    });
+    EXPECT_EQ(stats,
+              (std::map<StorageID, std::tuple<uint64_t, uint64_t, uint64_t>>{
+                  {"a", {0, 0, 5}}, {"b", {1, 0, 0}}}));
+    release.set_value();
+  }
+}  // namespace fc::sector_storage
@@ -0,0 +1,158 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sector_storage/stores/impl/remote_store.hpp"
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+#include <thread>
+
+#include "common/file.hpp"
+#include "common/span.hpp"
+#include "testutil/mocks/sector_storage/stores/local_store_mock.hpp"
+#include "testutil/mocks/sector_storage/stores/sector_index_mock.hpp"
+#include "testutil/outcome.hpp"
+#include "testutil/storage/base_fs_test.hpp"
+
+namespace fc::sector_storage::stores {
+  using boost::asio::ip::tcp;
+  using primitives::sector_file::SectorFileType;
+  using primitives::sector_file::sectorName;
+  using testing::_;
+
+  /**
+   * Serves file to two requests, first response is cut after `cut` bytes,
+   * second is served from requested range.
+   */
+  struct CutServer {
+    CutServer(std::string body, size_t cut) : body{std::move(body)}, cut{cut} {
+      thread = std::thread{[this] { serve(); }};
+    }
+
+    ~CutServer() {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+
+    void serve() {
+      for (auto i{0}; i < 2; ++i) {
+        tcp::socket socket{io};
+        acceptor.accept(socket);
+        boost::asio::streambuf buffer;
+        boost::asio::read_until(socket, buffer, "\r\n\r\n");
+        std::string request{boost::asio::buffers_begin(buffer.data()),
+                            boost::asio::buffers_end(buffer.data())};
+        std::string range;
+        size_t begin{0};
+        auto pos{request.find("Range: bytes=")};
+        if (pos != std::string::npos) {
+          range = request.substr(pos + 7, request.find("\r\n", pos) - pos - 7);
+          begin = std::stoull(range.substr(6));
+        }
+        ranges.push_back(range);
+        std::string response;
+        if (range.empty()) {
+          response = "HTTP/1.1 200 OK\r\nContent-Length: "
+                     + std::to_string(body.size()) + "\r\n";
+        } else {
+          response = "HTTP/1.1 206 Partial Content\r\nContent-Length: "
+                     + std::to_string(body.size() - begin)
+                     + "\r\nContent-Range: bytes " + std::to_string(begin)
+                     + "-" + std::to_string(body.size() - 1) + "/"
+                     + std::to_string(body.size()) + "\r\n";
+        }
+        response += "Content-Type: application/octet-stream\r\n"
+                    "Accept-Ranges: bytes\r\nConnection: close\r\n\r\n";
+        response += i == 0 ? body.substr(0, cut) : body.substr(begin);
+        boost::asio::write(socket, boost::asio::buffer(response));
+        boost::system::error_code ec;
+        socket.shutdown(tcp::socket::shutdown_both, ec);
+      }
+    }
+
+    std::string url() const {
+      return "http://127.0.0.1:"
+             + std::to_string(acceptor.local_endpoint().port())
+             + "/remote/sealed/s-t042-1";
+    }
+
+    std::string body;
+    size_t cut;
+    boost::asio::io_context io;
+    tcp::acceptor acceptor{io, {boost::asio::ip::address_v4::loopback(), 0}};
+    std::vector<std::string> ranges;
+    std::thread thread;
+  };
+
+  class RemoteStoreTest : public test::BaseFS_Test {
+   public:
+    RemoteStoreTest() : test::BaseFS_Test("fc_remote_store_test") {
+      EXPECT_CALL(*local_store_, getSectorIndex())
+          .WillRepeatedly(testing::Return(sector_index_));
+      remote_store_ = std::make_shared<RemoteStoreImpl>(
+          local_store_, std::unordered_map<HeaderName, HeaderValue>{});
+    }
+
+   protected:
+    std::shared_ptr<SectorIndexMock> sector_index_{
+        std::make_shared<SectorIndexMock>()};
+    std::shared_ptr<LocalStoreMock> local_store_{
+        std::make_shared<LocalStoreMock>()};
+    std::shared_ptr<RemoteStoreImpl> remote_store_;
+  };
+
+  /**
+   * @given remote storage closes connection after part of sealed file
+   * @when acquire sector
+   * @then fetch is resumed from received bytes by range request
+   */
+  TEST_F(RemoteStoreTest, ResumeAfterShortRead) {
+    std::string body(64 << 10, 0);
+    for (size_t i{0}; i < body.size(); ++i) {
+      body[i] = static_cast<char>(i % 251);
+    }
+    CutServer server{body, 1000};
+
+    SectorId sector{.miner = 42, .sector = 1};
+    auto dest{(base_path / "sealed" / sectorName(sector)).string()};
+    boost::filesystem::create_directories(base_path / "sealed");
+    AcquireSectorResponse allocated;
+    allocated.paths.sealed = dest;
+    allocated.storages.sealed = "local";
+    EXPECT_CALL(*local_store_,
+                acquireSector(_, _, SectorFileType::FTSealed, _, _, _))
+        .WillOnce(testing::Return(AcquireSectorResponse{}));
+    EXPECT_CALL(*local_store_,
+                acquireSector(_, _, SectorFileType::FTNone, _, _, _))
+        .WillOnce(testing::Return(allocated));
+    EXPECT_CALL(*local_store_, reserve(_, _, _, _))
+        .WillOnce(testing::Return(std::function<void()>{[] {}}));
+    StorageInfo info;
+    info.id = "remote";
+    info.urls = {server.url()};
+    info.weight = 1;
+    EXPECT_CALL(*sector_index_, storageFindSector(_, _, _))
+        .WillOnce(testing::Return(std::vector<StorageInfo>{info}));
+    EXPECT_CALL(*sector_index_, storageDeclareSector(_, _, _, _))
+        .WillOnce(testing::Return(outcome::success()));
+
+    EXPECT_OUTCOME_TRUE(response,
+                        remote_store_->acquireSector(
+                            sector,
+                            RegisteredSealProof::kStackedDrg2KiBV1,
+                            SectorFileType::FTSealed,
+                            SectorFileType::FTNone,
+                            PathType::kStorage,
+                            AcquireMode::kCopy));
+    EXPECT_EQ(response.paths.sealed, dest);
+    EXPECT_OUTCOME_TRUE(fetched, common::readFile(dest));
+    EXPECT_EQ(common::span::bytestr(fetched), body);
+    server.thread.join();
+    EXPECT_EQ(server.ranges, (std::vector<std::string>{"", "bytes=1000-"}));
+  }
+}  // namespace fc::sector_storage::stores
@@ -106,6 +106,62 @@ TEST_F(AmtTest, Flush) {
   EXPECT_OUTCOME_EQ(amt.get(key), value);
 }
 
+/** Build gives same cid as set and flush */
+TEST_F(AmtTest, Build) {
+  for (auto step : {1, 7, 100}) {
+    for (auto n : {0, 1, 8, 9, 100, 1000}) {
+      Amt amt{store};
+      std::vector<std::pair<uint64_t, Value>> items;
+      for (auto i = 0; i < n; ++i) {
+        items.emplace_back(i * step, Value{encode(i).value()});
+        EXPECT_OUTCOME_TRUE_1(amt.set(items.back().first, items.back().second));
+      }
+      EXPECT_OUTCOME_TRUE(cid, amt.flush());
+      EXPECT_OUTCOME_EQ(Amt::build(store, items), cid);
+    }
+  }
+
+  std::vector<std::pair<uint64_t, Value>> unsorted{{2, Value{"01"_unhex}},
+                                                   {1, Value{"02"_unhex}}};
+  EXPECT_OUTCOME_ERROR(AmtError::kNotSorted, Amt::build(store, unsorted));
+}
+
+/** Diff reports added, removed and changed keys, trees of different height */
+TEST_F(AmtTest, Diff) {
+  using Change =
+      std::tuple<uint64_t, boost::optional<Value>, boost::optional<Value>>;
+  auto value{[](int i) { return Value{encode(i).value()}; }};
+  for (auto i = 0; i < 100; ++i) {
+    EXPECT_OUTCOME_TRUE_1(amt.set(i, value(i)));
+  }
+  EXPECT_OUTCOME_TRUE(cid1, amt.flush());
+  EXPECT_OUTCOME_TRUE_1(amt.set(5, value(-1)));
+  EXPECT_OUTCOME_TRUE_1(amt.remove(50));
+  EXPECT_OUTCOME_TRUE_1(amt.set(10000, value(0)));
+  EXPECT_OUTCOME_TRUE(cid2, amt.flush());
+
+  auto diff{[&](const fc::CID &before, const fc::CID &after) {
+    std::vector<Change> changes;
+    EXPECT_OUTCOME_TRUE_1(
+        Amt::diff({store, before},
+                  {store, after},
+                  [&](auto key, auto &value_before, auto &value_after) {
+                    changes.emplace_back(key, value_before, value_after);
+                    return fc::outcome::success();
+                  }));
+    return changes;
+  }};
+  EXPECT_EQ(diff(cid1, cid2),
+            (std::vector<Change>{{5, value(5), value(-1)},
+                                 {50, value(50), boost::none},
+                                 {10000, boost::none, value(0)}}));
+  EXPECT_EQ(diff(cid2, cid1),
+            (std::vector<Change>{{5, value(-1), value(5)},
+                                 {50, boost::none, value(50)},
+                                 {10000, value(0), boost::none}}));
+  EXPECT_EQ(diff(cid1, cid1), std::vector<Change>{});
+}
+
 class AmtVisitTest : public AmtTest {
  public:
   AmtVisitTest() : AmtTest{} {
@@ -9,6 +9,8 @@
 #include <gtest/gtest.h>
 #include <boost/filesystem/operations.hpp>
 
+#include "common/file.hpp"
+#include "storage/car/car_ipld.hpp"
 #include "storage/ipfs/impl/in_memory_datastore.hpp"
 #include "storage/unixfs/unixfs.hpp"
 #include "testutil/literals.hpp"
@@ -17,10 +19,14 @@
 #include "testutil/resources/resources.hpp"
 
 using fc::CID;
+using fc::common::Buffer;
 using fc::storage::car::CarError;
+using fc::storage::car::CarIpld;
+using fc::storage::car::CarReader;
 using fc::storage::car::loadCar;
 using fc::storage::car::makeCar;
 using fc::storage::car::makeSelectiveCar;
+using fc::storage::car::SelectiveCarWriter;
 using fc::storage::ipfs::InMemoryDatastore;
 namespace fs = boost::filesystem;
 
@@ -148,3 +154,60 @@ TEST(SelectiveCar, MakeSelectiveCarToFile) {
                                          << "expected" << std::endl
                                          << expected_car << std::endl;
 }
+
+/**
+ * @given blocks of PAYLOAD_FILE dag arriving in reverse order
+ * @when write selective car after each block
+ * @then car is completed with last block and equals CAR_FROM_PAYLOAD_FILE
+ */
+TEST(SelectiveCar, Writer) {
+  InMemoryDatastore source;
+  EXPECT_OUTCOME_TRUE(root_cid,
+                      fc::storage::unixfs::wrapFile(source,
+                                                    readFile(PAYLOAD_FILE)));
+  auto expected_car = readFile(CAR_FROM_PAYLOAD_FILE);
+  EXPECT_OUTCOME_TRUE(reader, CarReader::make(expected_car));
+  std::vector<CarReader::Item> items;
+  while (!reader.end()) {
+    EXPECT_OUTCOME_TRUE(item, reader.next());
+    items.push_back(item);
+  }
+
+  InMemoryDatastore received;
+  Buffer car;
+  SelectiveCarWriter writer{
+      received, root_cid, [&](auto bytes) { car.put(bytes); }};
+  for (auto it{items.rbegin()}; it != items.rend(); ++it) {
+    EXPECT_OUTCOME_EQ(writer.write(), false);
+    EXPECT_OUTCOME_TRUE_1(received.set(it->first, Buffer{it->second}));
+  }
+  EXPECT_OUTCOME_EQ(writer.write(), true);
+  EXPECT_EQ(car, expected_car);
+}
+
+/**
+ * @given CAR_FROM_PAYLOAD_FILE padded with zeros like unsealed piece
+ * @when open it as ipld
+ * @then all blocks are read from file, ipld is read-only
+ */
+TEST(CarIpld, Open) {
+  auto car = readFile(CAR_FROM_PAYLOAD_FILE);
+  auto car_path = fs::temp_directory_path() / fs::unique_path();
+  Buffer padded{car};
+  padded.resize(car.size() + 1000);
+  EXPECT_OUTCOME_TRUE_1(fc::common::writeFile(car_path, padded));
+  EXPECT_OUTCOME_TRUE(ipld, CarIpld::open(car_path.string()));
+  fs::remove(car_path);
+
+  EXPECT_OUTCOME_TRUE(reader, CarReader::make(car));
+  EXPECT_EQ(ipld->roots(), reader.roots);
+  while (!reader.end()) {
+    EXPECT_OUTCOME_TRUE(item, reader.next());
+    EXPECT_OUTCOME_EQ(ipld->contains(item.first), true);
+    EXPECT_OUTCOME_EQ(ipld->get(item.first), Buffer{item.second});
+  }
+  auto missing{fc::common::getCidOf(padded).value()};
+  EXPECT_OUTCOME_EQ(ipld->contains(missing), false);
+  EXPECT_OUTCOME_FALSE_1(ipld->get(missing));
+  EXPECT_OUTCOME_FALSE_1(ipld->set(missing, padded));
+}
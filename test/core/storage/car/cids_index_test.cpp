@@ -6,8 +6,10 @@
 #include "storage/car/cids_index/util.hpp"
 
 #include <future>
+#include <thread>
 
 #include "common/io_thread.hpp"
+#include "crypto/blake2/blake2b160.hpp"
 #include "primitives/cid/cid_of_cbor.hpp"
 #include "storage/ipld/cids_ipld.hpp"
 #include "testutil/outcome.hpp"
@@ -35,9 +37,9 @@ namespace fc::storage::cids_index {
       cids_path = car_path + ".cids";
     }
 
-    auto load(bool writable) {
+    auto load(bool writable, bool mmap = false) {
       return loadOrCreateWithProgress(
-          car_path, writable, boost::none, nullptr, nullptr);
+          car_path, writable, boost::none, nullptr, nullptr, mmap);
     }
 
     void testFlush(std::shared_ptr<boost::asio::io_context> io);
@@ -97,6 +99,41 @@ namespace fc::storage::cids_index {
     ipld = *load(true);
   }
 
+  /**
+   * @given indexed car with item which has no index row appended
+   * @when car is reopened
+   * @then existing index is kept and every cid is found
+   */
+  TEST_F(CidsIndexTest, ReopenIndexed) {
+    ipld = *load(true);
+    std::vector<CID> cids;
+    for (auto i{0}; i < 10; ++i) {
+      cids.push_back(ipld->setCbor(i).value());
+    }
+    EXPECT_OUTCOME_TRUE_1(ipld->doFlush());
+    ipld = *load(false);
+    EXPECT_EQ(ipld->index->size(), cids.size());
+
+    // sha256 cid is not indexed
+    CID sha256{CID::Version::V1,
+               CID::Multicodec::RAW,
+               libp2p::multi::Multihash::create(
+                   libp2p::multi::HashType::sha256, Buffer(32, 1))
+                   .value()};
+    Buffer item;
+    car::writeItem(item, sha256, Buffer{1, 2, 3});
+    std::ofstream{car_path, std::ios::app | std::ios::binary}.write(
+        (const char *)item.data(), item.size());
+
+    for (auto writable : {false, true}) {
+      ipld = *load(writable);
+      EXPECT_EQ(ipld->index->size(), cids.size());
+      for (auto i{0}; i < (int)cids.size(); ++i) {
+        EXPECT_OUTCOME_EQ(ipld->getCbor<int>(cids[i]), i);
+      }
+    }
+  }
+
   TEST_F(CidsIndexTest, FlushOn) {
     ipld = *load(true);
     ipld->flush_on = 3;
@@ -126,6 +163,266 @@ namespace fc::storage::cids_index {
     }
   }
 
+  /**
+   * @given car flushed after each value
+   * @when many values are written
+   * @then delta segments are compacted and values persist
+   */
+  TEST_F(CidsIndexTest, Segments) {
+    ipld = *load(true);
+    ipld->flush_on = 1;
+    std::vector<CID> cids;
+    for (auto i{0}; i < 40; ++i) {
+      cids.push_back(ipld->setCbor(i).value());
+    }
+    EXPECT_EQ(ipld->index->size(), cids.size());
+    EXPECT_LT(ipld->index->segments.size(), 8);
+    EXPECT_EQ(fs::exists(SegmentsIndex::manifestPath(cids_path)),
+              ipld->index->segments.size() > 1);
+    ipld = *load(false);
+    EXPECT_EQ(ipld->index->size(), cids.size());
+    for (auto i{0}; i < (int)cids.size(); ++i) {
+      EXPECT_OUTCOME_EQ(ipld->getCbor<int>(cids[i]), i);
+    }
+  }
+
+  /**
+   * @given mmap car and index
+   * @when put values, flush and read from several threads
+   * @then values are read from mapping grown past written offset
+   */
+  TEST_F(CidsIndexTest, Mmap) {
+    ipld = *load(true, true);
+    ipld->flush_on = 7;
+    std::vector<CID> cids;
+    for (auto i{0}; i < 40; ++i) {
+      cids.push_back(ipld->setCbor(i).value());
+      EXPECT_OUTCOME_EQ(ipld->getCbor<int>(cids.back()), i);
+    }
+    ipld = *load(false, true);
+    std::vector<std::thread> threads;
+    std::atomic_size_t errors{};
+    for (auto t{0}; t < 4; ++t) {
+      threads.emplace_back([&] {
+        for (auto i{0}; i < (int)cids.size(); ++i) {
+          auto _value{ipld->getCbor<int>(cids[i])};
+          if (!_value || _value.value() != i) {
+            ++errors;
+          }
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    EXPECT_EQ(errors, 0);
+  }
+
+  /**
+   * @given mmap car with small reservation past its end
+   * @when values are put past mapped length
+   * @then car is remapped, values are read before and after remap,
+   * readers keep previous mapping
+   */
+  TEST_F(CidsIndexTest, MmapRemap) {
+    ipld = *load(true, true);
+    ipld->mmap_reserve = 64;
+    std::vector<CID> cids;
+    cids.push_back(ipld->setCbor(0).value());
+    EXPECT_OUTCOME_EQ(ipld->getCbor<int>(cids[0]), 0);
+    auto mapped{std::atomic_load(&ipld->car_mmap)};
+    ASSERT_TRUE(mapped);
+    auto mapped_size{mapped->size};
+
+    // values written inside mapped length are read from same mapping
+    auto i{1};
+    for (; ipld->car_offset < mapped_size; ++i) {
+      cids.push_back(ipld->setCbor(i).value());
+    }
+    EXPECT_OUTCOME_EQ(ipld->getCbor<int>(cids[0]), 0);
+    EXPECT_EQ(std::atomic_load(&ipld->car_mmap), mapped);
+
+    // value past mapped length remaps car
+    for (auto end{i + 10}; i < end; ++i) {
+      cids.push_back(ipld->setCbor(i).value());
+    }
+    EXPECT_OUTCOME_EQ(ipld->getCbor<int>(cids.back()), i - 1);
+    auto remapped{std::atomic_load(&ipld->car_mmap)};
+    EXPECT_NE(remapped, mapped);
+    EXPECT_GT(remapped->size, mapped_size);
+    for (auto j{0}; j < (int)cids.size(); ++j) {
+      EXPECT_OUTCOME_EQ(ipld->getCbor<int>(cids[j]), j);
+    }
+    // previous mapping stays valid while it is referenced
+    EXPECT_EQ(mapped->size, mapped_size);
+
+    EXPECT_OUTCOME_TRUE_1(ipld->doFlush());
+    ipld = *load(false, true);
+    for (auto j{0}; j < (int)cids.size(); ++j) {
+      EXPECT_OUTCOME_EQ(ipld->getCbor<int>(cids[j]), j);
+    }
+  }
+
+  /**
+   * @given sorted rows with uniformly distributed keys
+   * @when radix table is built
+   * @then each row is found and absent keys are not found
+   */
+  TEST(CidsIndexRadix, Find) {
+    std::vector<Row> rows(10000);
+    for (size_t i{0}; i < rows.size(); ++i) {
+      rows[i].key = crypto::blake2b::blake2b_256(common::span::cbytes(
+          std::string_view{(const char *)&i, sizeof(i)}));
+      rows[i].max_size64 = 1;
+    }
+    std::sort(rows.begin(), rows.end());
+    RadixTable radix;
+    radix.build(rows, boost::none);
+    EXPECT_GT(radix.bits, 0);
+    for (auto &row : rows) {
+      EXPECT_EQ(radix.find(rows, row.key), row);
+      auto key{row.key};
+      ++key[0];
+      EXPECT_NE(radix.find(rows, key), row);
+    }
+  }
+
+  /**
+   * @given car with bloom filter
+   * @when values are put, flushed and car is reloaded
+   * @then filter is persisted and rejects absent keys
+   */
+  TEST_F(CidsIndexTest, Bloom) {
+    auto bloom_path{car_path + ".bloom"};
+    ipld = *load(true);
+    EXPECT_TRUE(fs::exists(bloom_path));
+    EXPECT_OUTCOME_TRUE_1(ipld->setCbor(value1));
+    size_t absent{ipld->bloom_absent + ipld->bloom_false_positive};
+    EXPECT_OUTCOME_EQ(ipld->contains(cid1), true);
+    EXPECT_OUTCOME_EQ(ipld->contains(cid2), false);
+    EXPECT_EQ(ipld->bloom_absent + ipld->bloom_false_positive, absent + 1);
+    EXPECT_OUTCOME_TRUE_1(ipld->doFlush());
+    // filter saved by flush matches index, so it is not rebuilt on load
+    EXPECT_OUTCOME_TRUE_1(BloomFilter::load(bloom_path, ipld->index->info));
+
+    ipld = *load(false);
+    EXPECT_OUTCOME_EQ(ipld->contains(cid1), true);
+    EXPECT_EQ(ipld->bloom_present, 1);
+    EXPECT_OUTCOME_EQ(ipld->contains(cid2), false);
+    EXPECT_EQ(ipld->bloom_absent + ipld->bloom_false_positive, 1);
+
+    // filter is rebuilt by index merge
+    fs::remove(cids_path);
+    EXPECT_OUTCOME_TRUE_1(load(true).value()->setCbor(value2));
+    ipld = *load(false);
+    EXPECT_OUTCOME_EQ(ipld->contains(cid1), true);
+    EXPECT_OUTCOME_EQ(ipld->contains(cid2), true);
+  }
+
+  /**
+   * @given saved bloom filter
+   * @when file is truncated or its header claims more words
+   * @then filter is not loaded
+   */
+  TEST_F(CidsIndexTest, BloomFileSize) {
+    auto bloom_path{car_path + ".bloom"};
+    RowsInfo info;
+    BloomFilter bloom{100};
+    bloom.add(Key{});
+    EXPECT_OUTCOME_TRUE_1(bloom.save(bloom_path, info));
+    EXPECT_OUTCOME_TRUE(loaded, BloomFilter::load(bloom_path, info));
+    EXPECT_EQ(loaded->words.size(), bloom.words.size());
+    EXPECT_TRUE(loaded->maybe(Key{}));
+
+    BloomHeader header;
+    {
+      std::fstream file{bloom_path,
+                        std::ios::binary | std::ios::in | std::ios::out};
+      EXPECT_TRUE(common::read(file, gsl::make_span(&header, 1)));
+      header.words = uint64_t{1} << 61;
+      file.seekp(0);
+      EXPECT_TRUE(common::write(file, gsl::make_span(&header, 1)));
+    }
+    EXPECT_OUTCOME_FALSE_1(BloomFilter::load(bloom_path, info));
+
+    EXPECT_OUTCOME_TRUE_1(bloom.save(bloom_path, info));
+    fs::resize_file(bloom_path, fs::file_size(bloom_path) - 1);
+    EXPECT_OUTCOME_FALSE_1(BloomFilter::load(bloom_path, info));
+  }
+
+  /**
+   * @given car file
+   * @when indexed by parallel readCar and merge, in one segment and in small
+   * segments with items straddling segment boundaries
+   * @then index is same as serial one
+   */
+  TEST_F(CidsIndexTest, ReadCarParallel) {
+    constexpr uint64_t kSegment{256};
+    auto car_path{genesis_path.string()};
+    auto car_size{fs::file_size(car_path)};
+    std::ifstream car_file{car_path, std::ios::binary};
+    codec::uvarint::VarintDecoder header;
+    ASSERT_TRUE(read(car_file, header));
+    auto car_min{header.length + header.value};
+
+    // items crossing boundaries of small segments
+    size_t straddling{};
+    for (auto offset{car_min}; offset < car_size;) {
+      codec::uvarint::VarintDecoder item;
+      ASSERT_TRUE(read(car_file, item));
+      auto end{offset + item.length + item.value};
+      if ((offset - car_min) / kSegment != (end - 1 - car_min) / kSegment) {
+        ++straddling;
+      }
+      car_file.seekg(end);
+      offset = end;
+    }
+    EXPECT_GT(car_size - car_min, 4 * kSegment);
+    EXPECT_GT(straddling, 0);
+
+    auto index = [&](bool parallel, boost::optional<uint64_t> segment) {
+      auto path{(getPathString()
+                 / (parallel ? "parallel" + std::to_string(segment.value_or(0))
+                             : "serial"))
+                    .string()};
+      auto rows_path{path + ".rows"};
+      std::fstream rows_file{
+          rows_path,
+          std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc};
+      std::vector<MergeRange> ranges;
+      if (parallel) {
+        EXPECT_OUTCOME_TRUE_1(readCarParallel(car_path,
+                                              car_min,
+                                              car_size,
+                                              boost::none,
+                                              nullptr,
+                                              nullptr,
+                                              rows_path,
+                                              rows_file,
+                                              ranges,
+                                              4,
+                                              segment));
+        EXPECT_OUTCOME_TRUE_1(mergeParallel(path, std::move(ranges), 4));
+      } else {
+        EXPECT_OUTCOME_TRUE_1(readCar(car_file,
+                                      car_min,
+                                      car_size,
+                                      boost::none,
+                                      nullptr,
+                                      nullptr,
+                                      rows_file,
+                                      ranges));
+        std::ofstream out{path, std::ios::binary};
+        EXPECT_OUTCOME_TRUE_1(merge(out, std::move(ranges)));
+      }
+      return common::readFile(path).value();
+    };
+    auto serial{index(false, boost::none)};
+    EXPECT_GT(serial.size(), 2 * sizeof(Row));
+    EXPECT_EQ(index(true, boost::none), serial);
+    EXPECT_EQ(index(true, kSegment), serial);
+  }
+
   TEST_F(CidsIndexTest, FlushSync) {
     testFlush(nullptr);
   }
@@ -0,0 +1,62 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/hamt/hamt_index.hpp"
+
+#include <gtest/gtest.h>
+
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/ipfs/impl/in_memory_datastore.hpp"
+#include "testutil/outcome.hpp"
+
+namespace fc::storage::hamt {
+  struct HamtIndexTest : testing::Test {
+    auto sorted(std::vector<std::string> keys) {
+      std::sort(keys.begin(), keys.end());
+      return keys;
+    }
+
+    std::shared_ptr<ipfs::IpfsDatastore> ipld{
+        std::make_shared<ipfs::InMemoryDatastore>()};
+    std::shared_ptr<InMemoryStorage> kv{std::make_shared<InMemoryStorage>()};
+    HamtIndex index{kv};
+    Hamt hamt{ipld, kDefaultBitWidth, true};
+  };
+
+  /**
+   * @given hamt with many entries
+   * @when count and list keys with index, before and after flush
+   * @then results are same as hamt visit, counts are cached by node cid
+   */
+  TEST_F(HamtIndexTest, CountKeys) {
+    std::vector<std::string> keys;
+    for (auto i{0}; i < 5000; ++i) {
+      keys.push_back(std::to_string(i));
+      EXPECT_OUTCOME_TRUE_1(hamt.set(keys.back(), Buffer{1}));
+    }
+    std::vector<std::string> visited;
+    EXPECT_OUTCOME_TRUE_1(hamt.visit([&](auto &key, auto &) {
+      visited.push_back(key);
+      return outcome::success();
+    }));
+    EXPECT_EQ(sorted(visited), sorted(keys));
+
+    EXPECT_OUTCOME_EQ(index.count(hamt), keys.size());
+    EXPECT_OUTCOME_EQ(index.keys(hamt), visited);
+
+    EXPECT_OUTCOME_TRUE(root, hamt.flush());
+    EXPECT_OUTCOME_EQ(index.count(Hamt{ipld, root, kDefaultBitWidth, true}),
+                      keys.size());
+    EXPECT_TRUE(kv->contains(root.toBytes().value()));
+    EXPECT_OUTCOME_EQ(index.keys(Hamt{ipld, root, kDefaultBitWidth, true}),
+                      visited);
+
+    // shared subtrees of new root are reused
+    EXPECT_OUTCOME_TRUE_1(hamt.remove(keys[0]));
+    EXPECT_OUTCOME_TRUE(root2, hamt.flush());
+    EXPECT_OUTCOME_EQ(index.count(Hamt{ipld, root2, kDefaultBitWidth, true}),
+                      keys.size() - 1);
+  }
+}  // namespace fc::storage::hamt
@@ -11,6 +11,8 @@
 #include "storage/ipfs/impl/in_memory_datastore.hpp"
 #include "testutil/cbor.hpp"
 
+using fc::codec::cbor::CborDecodeError;
+using fc::codec::cbor::decode;
 using fc::codec::cbor::encode;
 using fc::common::which;
 using fc::storage::hamt::Hamt;
@@ -45,6 +47,28 @@ TEST_F(HamtTest, NodeCbor) {
   EXPECT_OUTCOME_ERROR(HamtError::kExpectedCID, encode(n));
 }
 
+/** Node with bit width 8 bitmap, items are ordered by index */
+TEST_F(HamtTest, NodeCborWideBits) {
+  Node n{{}, true};
+  n.items[255] = "010000020000"_cid;
+  n.items[0] = "010000020000"_cid;
+  expectEncodeAndReencode(
+      n,
+      "825820800000000000000000000000000000000000000000000000000000000000000182d82a4700010000020000d82a4700010000020000"_unhex);
+
+  n.items.erase(255);
+  EXPECT_EQ(n.items.size(), 1);
+  EXPECT_FALSE(n.items.find(255));
+}
+
+/** Bitmap longer than 256 bits is rejected */
+TEST_F(HamtTest, NodeCborOversizedBits) {
+  EXPECT_OUTCOME_ERROR(
+      CborDecodeError::kWrongSize,
+      decode<Node>(
+          "825821010000000000000000000000000000000000000000000000000000000000000080"_unhex));
+}
+
 /** Set-remove single element */
 TEST_F(HamtTest, SetRemoveOne) {
   EXPECT_OUTCOME_ERROR(HamtError::kNotFound, hamt_.get("aai"));
@@ -132,6 +156,103 @@ TEST_F(HamtTest, VisitorError) {
   EXPECT_EQ(n, 1);
 }
 
+/** Visit requests all children of node before loading them */
+TEST_F(HamtTest, VisitPrefetch) {
+  using fc::storage::hamt::kDefaultBitWidth;
+  using fc::storage::hamt::Value;
+  struct Store : fc::storage::ipfs::InMemoryDatastore {
+    fc::outcome::result<Value> get(const fc::CID &key) const override {
+      gets.push_back(key);
+      return InMemoryDatastore::get(key);
+    }
+    void prefetch(gsl::span<const fc::CID> keys) const override {
+      prefetched.insert(prefetched.end(), keys.begin(), keys.end());
+    }
+    mutable std::vector<fc::CID> gets, prefetched;
+  };
+  auto store{std::make_shared<Store>()};
+  Hamt hamt{store, kDefaultBitWidth, false};
+  for (auto i = 0; i < 1000; ++i) {
+    EXPECT_OUTCOME_TRUE_1(
+        hamt.set(std::to_string(i), Value{encode(i).value()}));
+  }
+  EXPECT_OUTCOME_TRUE(root, hamt.flush());
+  EXPECT_OUTCOME_TRUE_1(Hamt(store, root, kDefaultBitWidth, false)
+                            .visit([](auto &, auto &) {
+                              return fc::outcome::success();
+                            }));
+  ASSERT_FALSE(store->gets.empty());
+  EXPECT_EQ(store->gets.front(), root);
+  store->gets.erase(store->gets.begin());
+  EXPECT_FALSE(store->prefetched.empty());
+  std::sort(store->gets.begin(), store->gets.end());
+  std::sort(store->prefetched.begin(), store->prefetched.end());
+  EXPECT_EQ(store->gets, store->prefetched);
+}
+
+/** Build gives same cid as set and flush, last value of same key is used */
+TEST_F(HamtTest, Build) {
+  using fc::storage::hamt::kDefaultBitWidth;
+  using fc::storage::hamt::Value;
+  for (auto n : {0, 1, 4, 1000}) {
+    Hamt hamt{store_, kDefaultBitWidth, true};
+    std::vector<std::pair<std::string, Value>> items;
+    items.emplace_back("0", Value{encode(-1).value()});
+    for (auto i = 0; i < n; ++i) {
+      items.emplace_back(std::to_string(i), Value{encode(i).value()});
+      EXPECT_OUTCOME_TRUE_1(hamt.set(items.back().first, items.back().second));
+    }
+    if (n == 0) {
+      items.clear();
+    }
+    EXPECT_OUTCOME_TRUE(cid, hamt.flush());
+    EXPECT_OUTCOME_EQ(Hamt::build(store_, items, kDefaultBitWidth, true), cid);
+  }
+}
+
+/** Diff reports added, removed and changed keys */
+TEST_F(HamtTest, Diff) {
+  using fc::storage::hamt::kDefaultBitWidth;
+  using fc::storage::hamt::Value;
+  using Change = std::tuple<std::string,
+                            boost::optional<Value>,
+                            boost::optional<Value>>;
+  auto value{[](int i) { return Value{encode(i).value()}; }};
+  Hamt hamt{store_, kDefaultBitWidth, true};
+  for (auto i = 0; i < 1000; ++i) {
+    EXPECT_OUTCOME_TRUE_1(hamt.set(std::to_string(i), value(i)));
+  }
+  EXPECT_OUTCOME_TRUE(cid1, hamt.flush());
+  EXPECT_OUTCOME_TRUE_1(hamt.set("1", value(-1)));
+  EXPECT_OUTCOME_TRUE_1(hamt.remove("2"));
+  EXPECT_OUTCOME_TRUE_1(hamt.set("new", value(0)));
+  EXPECT_OUTCOME_TRUE(cid2, hamt.flush());
+
+  auto diff{[&](const fc::CID &before, const fc::CID &after) {
+    std::vector<Change> changes;
+    EXPECT_OUTCOME_TRUE_1(
+        Hamt::diff({store_, before, kDefaultBitWidth, true},
+                   {store_, after, kDefaultBitWidth, true},
+                   [&](auto &key, auto &value_before, auto &value_after) {
+                     changes.emplace_back(key, value_before, value_after);
+                     return fc::outcome::success();
+                   }));
+    std::sort(changes.begin(), changes.end(), [](auto &l, auto &r) {
+      return std::get<0>(l) < std::get<0>(r);
+    });
+    return changes;
+  }};
+  EXPECT_EQ(diff(cid1, cid2),
+            (std::vector<Change>{{"1", value(1), value(-1)},
+                                 {"2", value(2), boost::none},
+                                 {"new", boost::none, value(0)}}));
+  EXPECT_EQ(diff(cid2, cid1),
+            (std::vector<Change>{{"1", value(-1), value(1)},
+                                 {"2", boost::none, value(2)},
+                                 {"new", value(0), boost::none}}));
+  EXPECT_EQ(diff(cid1, cid1), std::vector<Change>{});
+}
+
 /**
  * @given an empty HAMT
  * @when place an element
@@ -120,6 +120,30 @@ namespace fc::storage::mpool {
     EXPECT_FALSE(testMpoolSelectApply(fix, 0.5).empty());
   }
 
+  /// Messages removed by applied tipset return to pool with their signatures
+  TEST(MpoolHeadChange, RevertApplied) {
+    using primitives::tipset::HeadChangeType;
+    Fixture fix;
+    fix.setHead(ts2);
+    fix.addMsgs(msgs1, false);
+    EXPECT_EQ(fix.mpool->pending().size(), msgs1.size());
+    fix.chain_store->signal({HeadChangeType::APPLY, ts1});
+    EXPECT_TRUE(fix.mpool->pending().empty());
+    fix.chain_store->signal({HeadChangeType::REVERT, ts1});
+    auto pending{fix.mpool->pending()};
+    EXPECT_EQ(pending.size(), msgs1.size());
+    for (auto &msg : msgs1) {
+      EXPECT_NE(std::find_if(pending.begin(),
+                             pending.end(),
+                             [&](auto &pending_msg) {
+                               return pending_msg.message == msg.message
+                                      && pending_msg.signature
+                                             == msg.signature;
+                             }),
+                pending.end());
+    }
+  }
+
   struct MpoolSelectQualityTest : ::testing::TestWithParam<double> {};
 
   TEST_P(MpoolSelectQualityTest, Revert) {
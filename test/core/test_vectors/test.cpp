@@ -5,6 +5,7 @@
 
 #include <gtest/gtest.h>
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/asio/thread_pool.hpp>
 #include <boost/assert.hpp>
 #include <boost/filesystem/directory.hpp>
 #include <boost/iostreams/copy.hpp>
@@ -277,7 +278,11 @@ auto search() {
 
 struct TestVectors : testing::TestWithParam<MessageVector> {};
 
-void testTipsets(const MessageVector &mv, const IpldPtr &ipld) {
+using SpeculativePool = std::shared_ptr<boost::asio::thread_pool>;
+
+void testTipsets(const MessageVector &mv,
+                 const IpldPtr &ipld,
+                 const SpeculativePool &speculative_pool) {
   for (const auto &precondition : mv.precondition_variants) {
     std::shared_ptr<Invoker> invoker = std::make_shared<InvokerImpl>();
     std::shared_ptr<RuntimeRandomness> randomness =
@@ -285,6 +290,7 @@ void testTipsets(const MessageVector &mv, const IpldPtr &ipld) {
     auto ts_load{std::make_shared<fc::primitives::tipset::TsLoadIpld>(ipld)};
     fc::vm::runtime::EnvironmentContext env_context{
         ipld, invoker, randomness, ts_load};
+    env_context.speculative_pool = speculative_pool;
     fc::vm::interpreter::InterpreterImpl vmi{env_context, nullptr};
     CID state{mv.state_before};
     BlockHeader parent;
@@ -384,22 +390,81 @@ void testMessages(const MessageVector &mv, IpldPtr ipld) {
   }
 }
 
-TEST_P(TestVectors, Vector) {
-  auto &mv{GetParam()};
+/// Applies messages of same epoch together by Env::applyMessages
+void testMessagesBatched(const MessageVector &mv,
+                         IpldPtr ipld,
+                         const SpeculativePool &speculative_pool) {
+  for (const auto &precondition : mv.precondition_variants) {
+    BlockHeader b;
+    b.ticket.emplace();
+    b.messages = b.parent_message_receipts = b.parent_state_root =
+        mv.state_before;
+    b.parent_base_fee = mv.parent_base_fee;
+    OUTCOME_EXCEPT(ts, Tipset::create({b}));
+    std::shared_ptr<Invoker> invoker = std::make_shared<InvokerImpl>();
+    std::shared_ptr<RuntimeRandomness> randomness =
+        std::make_shared<ReplayingRandomness>(mv.randomness);
+    fc::vm::runtime::EnvironmentContext env_context{ipld, invoker, randomness};
+    env_context.speculative_pool = speculative_pool;
+    auto env{std::make_shared<fc::vm::runtime::Env>(env_context, nullptr, ts)};
+    auto i{0};
+    for (auto it{mv.messages.begin()}; it != mv.messages.end();) {
+      auto epoch_offset{it->first};
+      std::vector<fc::vm::runtime::Env::Message> messages;
+      for (; it != mv.messages.end() && it->first == epoch_offset; ++it) {
+        const auto &message{it->second};
+        auto size = message.from.isSecp256k1()
+                        ? fc::vm::message::SignedMessage{message,
+                                                         fc::crypto::signature::
+                                                             Secp256k1Signature{}}
+                              .chainSize()
+                        : message.chainSize();
+        messages.push_back({message, size});
+      }
+      env->epoch = precondition.epoch + epoch_offset;
+      OUTCOME_EXCEPT(applies, env->applyMessages(messages));
+      for (auto &apply : applies) {
+        const auto &receipt{mv.receipts[i]};
+        EXPECT_EQ(apply.receipt.exit_code, receipt.exit_code);
+        EXPECT_EQ(apply.receipt.return_value, receipt.return_value);
+        EXPECT_EQ(apply.receipt.gas_used, receipt.gas_used);
+        ++i;
+      }
+    }
+    OUTCOME_EXCEPT(state, env->state_tree->flush());
+    EXPECT_EQ(state, mv.state_after);
+  }
+}
+
+void testVector(const MessageVector &mv,
+                const SpeculativePool &speculative_pool) {
   fc::vm::actor::cgo::configParams();
 
   auto ipld{std::make_shared<fc::storage::ipfs::InMemoryDatastore>()};
   OUTCOME_EXCEPT(fc::storage::car::loadCar(*ipld, mv.car));
 
   if (mv.type == "tipset") {
-    testTipsets(mv, ipld);
+    testTipsets(mv, ipld, speculative_pool);
   } else if (mv.type == "message") {
-    testMessages(mv, ipld);
+    if (speculative_pool) {
+      testMessagesBatched(mv, ipld, speculative_pool);
+    } else {
+      testMessages(mv, ipld);
+    }
   } else {
     FAIL();
   }
 }
 
+TEST_P(TestVectors, Vector) {
+  testVector(GetParam(), nullptr);
+}
+
+/// Speculative execution must produce same receipts and state roots
+TEST_P(TestVectors, Speculative) {
+  testVector(GetParam(), std::make_shared<boost::asio::thread_pool>(4));
+}
+
 INSTANTIATE_TEST_CASE_P(Vectors,
                         TestVectors,
                         testing::ValuesIn(search()),
@@ -0,0 +1,297 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "vm/interpreter/impl/interpreter_pipeline.hpp"
+
+#include <gtest/gtest.h>
+#include <future>
+
+#include "common/error_text.hpp"
+#include "primitives/cid/cid_of_cbor.hpp"
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/ipfs/impl/in_memory_datastore.hpp"
+#include "testutil/mocks/blockchain/weight_calculator_mock.hpp"
+#include "testutil/outcome.hpp"
+
+namespace fc::vm::interpreter {
+  using blockchain::weight::WeightCalculatorMock;
+  using primitives::address::Address;
+  using primitives::block::MsgMeta;
+  using primitives::block::Ticket;
+  using primitives::cid::getCidOfCbor;
+  using primitives::tipset::Tipset;
+  using storage::InMemoryStorage;
+  using storage::ipfs::InMemoryDatastore;
+  using testing::_;
+
+  /** Store whose writes can be blocked or failed */
+  struct TestIpld : Ipld, std::enable_shared_from_this<TestIpld> {
+    TestIpld() {
+      std::promise<void> ready;
+      ready.set_value();
+      unblocked = ready.get_future().share();
+    }
+
+    /** Blocks writes until promise is set */
+    std::promise<void> block() {
+      std::promise<void> promise;
+      std::lock_guard lock{mutex};
+      unblocked = promise.get_future().share();
+      return promise;
+    }
+
+    outcome::result<bool> contains(const CID &cid) const override {
+      std::lock_guard lock{mutex};
+      return store.contains(cid);
+    }
+
+    outcome::result<void> set(const CID &cid, Value value) override {
+      std::unique_lock lock{mutex};
+      auto wait{unblocked};
+      lock.unlock();
+      wait.wait();
+      lock.lock();
+      if (fail) {
+        return ERROR_TEXT("TestIpld: write failed");
+      }
+      return store.set(cid, std::move(value));
+    }
+
+    outcome::result<Value> get(const CID &cid) const override {
+      std::lock_guard lock{mutex};
+      return store.get(cid);
+    }
+
+    outcome::result<void> remove(const CID &cid) override {
+      std::lock_guard lock{mutex};
+      return store.remove(cid);
+    }
+
+    IpldPtr shared() override {
+      return shared_from_this();
+    }
+
+    mutable std::mutex mutex;
+    InMemoryDatastore store;
+    std::shared_future<void> unblocked;
+    std::atomic_bool fail{false};
+  };
+
+  /** Executes tipset by writing its height as state */
+  class TestInterpreter : public InterpreterImpl {
+   public:
+    using InterpreterImpl::InterpreterImpl;
+
+    outcome::result<Result> execute(
+        TsBranchPtr ts_branch,
+        const TipsetCPtr &tipset,
+        std::vector<MessageReceipt> *all_receipts,
+        const TipsetMessages *messages,
+        IpldPtr ipld,
+        std::shared_ptr<IpldBuffered> &buffer) const override {
+      OUTCOME_TRY(weight, getWeight(ipld, tipset));
+      buffer = std::make_shared<IpldBuffered>(ipld);
+      OUTCOME_TRY(state_root, buffer->setCbor(tipset->height()));
+      return Result{state_root, state_root, weight};
+    }
+  };
+
+  class InterpreterPipelineTest : public testing::Test {
+   public:
+    void SetUp() override {
+      // weight is state of parent, so it fails if parent state is not found
+      EXPECT_CALL(*weight_, calculateWeight(_, _))
+          .WillRepeatedly(testing::Invoke(
+              [](const IpldPtr &ipld,
+                 const Tipset &tipset) -> outcome::result<BigInt> {
+                OUTCOME_TRY(parent,
+                            ipld->getCbor<uint64_t>(
+                                tipset.getParentStateRoot()));
+                return BigInt{parent};
+              }));
+
+      EXPECT_OUTCOME_TRUE_1(ipld_->setCbor(uint64_t{0}));
+      MsgMeta meta;
+      ipld_->load(meta);
+      EXPECT_OUTCOME_TRUE(messages, ipld_->setCbor(meta));
+      for (uint64_t height{0}; height < 4; ++height) {
+        primitives::block::BlockHeader block;
+        block.miner = Address::makeFromId(1);
+        block.ticket = Ticket{Buffer(32, height)};
+        if (height != 0) {
+          block.parents = tipsets_.back()->key.cids();
+        }
+        block.height = height;
+        EXPECT_OUTCOME_TRUE(
+            parent_state,
+            getCidOfCbor(uint64_t{height == 0 ? 0 : height - 1}));
+        block.parent_state_root = parent_state;
+        block.parent_message_receipts = parent_state;
+        block.messages = messages;
+        EXPECT_OUTCOME_TRUE(tipset, Tipset::create({block}));
+        tipsets_.push_back(tipset);
+      }
+
+      makePipeline(InterpreterPipeline::kMaxPending);
+      EXPECT_OUTCOME_TRUE_1(interpret(0).first);
+    }
+
+    void makePipeline(size_t max_pending) {
+      EnvironmentContext env_context;
+      env_context.ipld = ipld_;
+      pipeline_ = std::make_shared<InterpreterPipeline>(
+          std::make_shared<TestInterpreter>(env_context, weight_),
+          cache_,
+          ipld_,
+          1,
+          max_pending);
+    }
+
+    /** Interprets tipset of height, returns result and flush result */
+    std::pair<outcome::result<Result>,
+              std::future<outcome::result<Result>>>
+    interpret(uint64_t height) {
+      auto promise{std::make_shared<std::promise<outcome::result<Result>>>()};
+      auto flushed{promise->get_future()};
+      auto result{pipeline_->interpret(
+          nullptr, tipsets_[height], [promise](auto result) {
+            promise->set_value(std::move(result));
+          })};
+      return {std::move(result), std::move(flushed)};
+    }
+
+   protected:
+    std::shared_ptr<TestIpld> ipld_{std::make_shared<TestIpld>()};
+    std::shared_ptr<WeightCalculatorMock> weight_{
+        std::make_shared<WeightCalculatorMock>()};
+    std::shared_ptr<InterpreterCache> cache_{std::make_shared<InterpreterCache>(
+        std::make_shared<InMemoryStorage>())};
+    std::vector<TipsetCPtr> tipsets_;
+    std::shared_ptr<InterpreterPipeline> pipeline_;
+  };
+
+  /**
+   * @given flush of first tipset is blocked
+   * @when interpret next tipset
+   * @then it is executed on top of pending state, both are cached after flush
+   */
+  TEST_F(InterpreterPipelineTest, ExecuteWhileFlushing) {
+    auto unblock{ipld_->block()};
+    auto [result1, flushed1]{interpret(1)};
+    auto [result2, flushed2]{interpret(2)};
+    auto pending{pipeline_->pending(tipsets_[1]->key).has_value()};
+    auto cached{cache_->tryGet(tipsets_[1]->key).has_value()};
+    unblock.set_value();
+
+    EXPECT_TRUE(result1);
+    EXPECT_TRUE(result2);
+    EXPECT_TRUE(pending);
+    EXPECT_FALSE(cached);
+    EXPECT_OUTCOME_TRUE(state1, flushed1.get());
+    EXPECT_OUTCOME_TRUE(state2, flushed2.get());
+    EXPECT_EQ(state2.state_root, result2.value().state_root);
+    EXPECT_OUTCOME_TRUE(cached1, cache_->get(tipsets_[1]->key));
+    EXPECT_EQ(cached1.state_root, state1.state_root);
+    EXPECT_OUTCOME_TRUE(cached2, cache_->get(tipsets_[2]->key));
+    EXPECT_EQ(cached2.state_root, state2.state_root);
+    EXPECT_OUTCOME_EQ(ipld_->getCbor<uint64_t>(state2.state_root), 2);
+  }
+
+  /**
+   * @given parents of tipsets are not flushed yet
+   * @when interpret tipsets
+   * @then weight is calculated from pending parent state
+   */
+  TEST_F(InterpreterPipelineTest, WeightOfPendingParent) {
+    auto unblock{ipld_->block()};
+    auto [result1, flushed1]{interpret(1)};
+    auto [result2, flushed2]{interpret(2)};
+    auto [result3, flushed3]{interpret(3)};
+    unblock.set_value();
+
+    EXPECT_OUTCOME_TRUE(executed1, result1);
+    EXPECT_EQ(executed1.weight, 0);
+    EXPECT_OUTCOME_TRUE(executed2, result2);
+    EXPECT_EQ(executed2.weight, 1);
+    EXPECT_OUTCOME_TRUE(executed3, result3);
+    EXPECT_EQ(executed3.weight, 2);
+    EXPECT_OUTCOME_TRUE_1(flushed3.get());
+    EXPECT_OUTCOME_TRUE(cached3, cache_->get(tipsets_[3]->key));
+    EXPECT_EQ(cached3.weight, 2);
+  }
+
+  /**
+   * @given flush of tipset fails while next tipset is executed on top of it
+   * @when interpret tipsets again
+   * @then tipset on top of lost state fails without being marked bad,
+   * pipeline works again after failed tipsets are interpreted again
+   */
+  TEST_F(InterpreterPipelineTest, FlushFailed) {
+    auto unblock{ipld_->block()};
+    auto [result1, flushed1]{interpret(1)};
+    auto [result2, flushed2]{interpret(2)};
+    ipld_->fail = true;
+    unblock.set_value();
+    EXPECT_TRUE(result1);
+    EXPECT_TRUE(result2);
+    EXPECT_FALSE(flushed1.get());
+    EXPECT_FALSE(flushed2.get());
+    EXPECT_FALSE(cache_->tryGet(tipsets_[2]->key));
+    ipld_->fail = false;
+
+    EXPECT_FALSE(interpret(3).first);
+    EXPECT_FALSE(cache_->tryGet(tipsets_[3]->key));
+
+    for (auto height : {1, 2, 3}) {
+      auto [result, flushed]{interpret(height)};
+      EXPECT_TRUE(result);
+      EXPECT_TRUE(flushed.get());
+    }
+    EXPECT_OUTCOME_TRUE(cached3, cache_->get(tipsets_[3]->key));
+    EXPECT_EQ(cached3.weight, 2);
+  }
+
+  /**
+   * @given pipeline with one pending tipset limit and blocked flush
+   * @when interpret two tipsets
+   * @then second tipset waits until first one is flushed
+   */
+  TEST_F(InterpreterPipelineTest, MaxPending) {
+    makePipeline(1);
+    auto unblock{ipld_->block()};
+    auto [result1, flushed1]{interpret(1)};
+    EXPECT_TRUE(result1);
+    auto second{std::async(std::launch::async, [&] { return interpret(2); })};
+    EXPECT_EQ(second.wait_for(std::chrono::milliseconds(100)),
+              std::future_status::timeout);
+    unblock.set_value();
+
+    EXPECT_OUTCOME_TRUE_1(flushed1.get());
+    auto [result2, flushed2]{second.get()};
+    EXPECT_TRUE(result2);
+    EXPECT_OUTCOME_TRUE(state2, flushed2.get());
+    EXPECT_OUTCOME_EQ(ipld_->getCbor<uint64_t>(state2.state_root), 2);
+  }
+
+  /**
+   * @given prefetched tipsets
+   * @when interpret tipset
+   * @then prefetched tipsets not above it are dropped
+   */
+  TEST_F(InterpreterPipelineTest, DropPrefetched) {
+    for (auto height : {1, 2, 3}) {
+      pipeline_->prefetch(tipsets_[height]);
+    }
+    EXPECT_EQ(pipeline_->prefetched(), 3);
+    auto [result2, flushed2]{interpret(2)};
+    EXPECT_FALSE(result2);
+    EXPECT_EQ(pipeline_->prefetched(), 1);
+    EXPECT_OUTCOME_TRUE_1(interpret(1).first);
+    EXPECT_EQ(pipeline_->prefetched(), 1);
+    EXPECT_OUTCOME_TRUE_1(interpret(2).first);
+    EXPECT_OUTCOME_TRUE_1(interpret(3).first);
+    EXPECT_EQ(pipeline_->prefetched(), 0);
+  }
+}  // namespace fc::vm::interpreter
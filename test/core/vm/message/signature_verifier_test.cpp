@@ -0,0 +1,63 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "vm/message/signature_verifier.hpp"
+
+#include <gtest/gtest.h>
+
+#include "crypto/blake2/blake2b160.hpp"
+#include "testutil/literals.hpp"
+
+namespace fc::vm::message {
+  using crypto::secp256k1::Secp256k1ProviderImpl;
+
+  struct SignatureVerifierTest : testing::Test {
+    void SetUp() override {
+      auto keypair{secp.generate().value()};
+      key = Address::makeSecp256k1(keypair.public_key);
+      other = Address::makeSecp256k1(secp.generate().value().public_key);
+      auto hash{crypto::blake2b::blake2b_256(cid.toBytes().value())};
+      signature = secp.sign(hash, keypair.private_key).value();
+    }
+
+    Secp256k1ProviderImpl secp;
+    CID cid{"010001020001"_cid};
+    Address key, other;
+    Signature signature;
+    SignatureVerifier verifier{2, 16};
+  };
+
+  /**
+   * @given signed cid
+   * @when verify twice
+   * @then second verification is served from cache
+   */
+  TEST_F(SignatureVerifierTest, Cache) {
+    EXPECT_FALSE(verifier.get(cid));
+    EXPECT_TRUE(verifier.verify({cid, signature, key}));
+    EXPECT_EQ(verifier.misses, 1);
+    EXPECT_EQ(verifier.get(cid), signature);
+    EXPECT_TRUE(verifier.verify({cid, signature, key}));
+    EXPECT_EQ(verifier.hits, 1);
+  }
+
+  /**
+   * @given batch with valid and invalid signatures
+   * @when verify batch
+   * @then only items signed by sender key are valid
+   */
+  TEST_F(SignatureVerifierTest, Batch) {
+    std::vector<SignatureVerifier::Item> items;
+    for (auto i{0}; i < 100; ++i) {
+      items.push_back({cid, signature, i % 2 ? other : key});
+    }
+    auto valid{verifier.verify(items)};
+    ASSERT_EQ(valid.size(), items.size());
+    for (size_t i{}; i < valid.size(); ++i) {
+      EXPECT_EQ(valid[i], i % 2 == 0);
+    }
+    EXPECT_EQ(verifier.invalid, 50);
+  }
+}  // namespace fc::vm::message
@@ -15,5 +15,7 @@ namespace fc::blockchain::block_validator {
     MOCK_CONST_METHOD2(validateBlock,
                        outcome::result<void>(const BlockHeader &block,
                                              scenarios::Scenario scenario));
+    MOCK_CONST_METHOD1(validateBlsAggregates,
+                       outcome::result<void>(gsl::span<const BlockWithCids>));
   };
 }  // namespace fc::blockchain::block_validator
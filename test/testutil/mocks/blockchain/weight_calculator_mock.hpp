@@ -14,5 +14,8 @@ namespace fc::blockchain::weight {
    public:
     MOCK_METHOD1(calculateWeight,
                  outcome::result<BigInt>(const Tipset &tipset));
+    MOCK_METHOD2(calculateWeight,
+                 outcome::result<BigInt>(const IpldPtr &ipld,
+                                         const Tipset &tipset));
   };
 }  // namespace fc::blockchain::weight
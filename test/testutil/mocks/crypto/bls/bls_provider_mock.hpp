@@ -27,5 +27,9 @@ namespace fc::crypto::bls {
     MOCK_CONST_METHOD1(
         aggregateSignatures,
         outcome::result<Signature>(gsl::span<const Signature>));
+    MOCK_CONST_METHOD1(verifyAggregateSignature,
+                       outcome::result<bool>(const Aggregate &));
+    MOCK_CONST_METHOD1(verifyAggregateSignatures,
+                       outcome::result<bool>(gsl::span<const Aggregate>));
   };
 }  // namespace fc::crypto::bls